@@ -61,6 +61,7 @@ function(set_options)
     option(OPTION_TOOLS_ONLY "Build only tools target" OFF)
     option(OPTION_DOCS_ONLY "Build only docs target" OFF)
     option(OPTION_ALLOW_INVALID_SIGNATURE "Allow loading of content with invalid signatures" OFF)
+    option(OPTION_ALLOCATION_TRACKING "Count heap allocations per subsystem and pool; costs memory and speed" OFF)
 
     if (OPTION_DOCS_ONLY)
         set(OPTION_TOOLS_ONLY ON PARENT_SCOPE)
@@ -79,6 +80,7 @@ function(show_options)
     message(STATUS "Option Install FHS - ${OPTION_INSTALL_FHS}")
     message(STATUS "Option Use assert - ${OPTION_USE_ASSERTS}")
     message(STATUS "Option Use NSIS - ${OPTION_USE_NSIS}")
+    message(STATUS "Option Allocation Tracking - ${OPTION_ALLOCATION_TRACKING}")
 
     if(OPTION_SURVEY_KEY)
         message(STATUS "Option Survey Key - USED")
@@ -114,4 +116,8 @@ function(add_definitions_based_on_options)
     if(OPTION_ALLOW_INVALID_SIGNATURE)
         add_definitions(-DALLOW_INVALID_SIGNATURE)
     endif()
+
+    if(OPTION_ALLOCATION_TRACKING)
+        add_definitions(-DWITH_ALLOCATION_TRACKING)
+    endif()
 endfunction()
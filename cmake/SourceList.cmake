@@ -46,3 +46,15 @@ endfunction()
 function(add_test_files)
     _add_files_tgt(openttd_test ${ARGV})
 endfunction()
+
+# Add a benchmark file to be compiled.
+#
+# add_bench_files([file1 ...] CONDITION condition [condition ...])
+#
+# CONDITION is a complete statement that can be evaluated with if().
+# If it evaluates true, the source files will be added; otherwise not.
+# For example: ADD_IF SDL_FOUND AND Allegro_FOUND
+#
+function(add_bench_files)
+    _add_files_tgt(openttd_bench ${ARGV})
+endfunction()
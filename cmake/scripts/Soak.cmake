@@ -0,0 +1,159 @@
+cmake_minimum_required(VERSION 3.17)
+
+#
+# Runs the soak test: for every combination of generation seed and map size a
+# new world is generated, and the soak AIs execute random commands on it for
+# a number of ticks. Every tick all caches, including the expensive ones, are
+# validated (desync debug level 3), and the throughput of every configuration
+# is reported. Every configuration runs in a directory of its own, which is also
+# its personal directory, so the 'commands-out.log' with the cache mismatches
+# and the savegames of the desync debugging end up there.
+#
+
+if(NOT OPENTTD_EXECUTABLE)
+    message(FATAL_ERROR "Script needs OPENTTD_EXECUTABLE defined (tip: use -DOPENTTD_EXECUTABLE=..)")
+endif()
+if(NOT SOAK_SEEDS OR NOT SOAK_MAP_SIZES OR NOT SOAK_TICKS OR NOT SOAK_AIS)
+    message(FATAL_ERROR "Script needs SOAK_SEEDS, SOAK_MAP_SIZES, SOAK_TICKS and SOAK_AIS defined (tip: use -DSOAK_SEEDS=..)")
+endif()
+
+# Every configuration runs in a directory of its own, so the executable must be found from there.
+get_filename_component(OPENTTD_EXECUTABLE "${OPENTTD_EXECUTABLE}" ABSOLUTE)
+
+if(NOT EXISTS ai/soak/main.nut)
+    message(FATAL_ERROR "Soak AI does not exist (tip: run the 'soak' target instead of this script)")
+endif()
+
+# See Regression.cmake for why the executable is copied. It stays next to the
+# original, as the soak AI and the language files are found next to it.
+if(EDITBIN_EXECUTABLE)
+    get_filename_component(SOAK_EXECUTABLE_DIR "${OPENTTD_EXECUTABLE}" DIRECTORY)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${OPENTTD_EXECUTABLE} ${SOAK_EXECUTABLE_DIR}/soak.exe)
+    set(OPENTTD_EXECUTABLE "${SOAK_EXECUTABLE_DIR}/soak.exe")
+
+    execute_process(COMMAND ${EDITBIN_EXECUTABLE} /nologo /subsystem:console ${OPENTTD_EXECUTABLE})
+endif()
+
+file(MAKE_DIRECTORY soak)
+
+set(SOAK_AI_PLAYERS "none =\n")
+foreach(I RANGE 1 ${SOAK_AIS})
+    string(APPEND SOAK_AI_PLAYERS "soak =\n")
+endforeach()
+
+set(SOAK_SUMMARY "")
+set(ERROR NO)
+
+foreach(SOAK_MAP_SIZE IN LISTS SOAK_MAP_SIZES)
+    if(NOT SOAK_MAP_SIZE MATCHES "^([0-9]+)x([0-9]+)$")
+        message(FATAL_ERROR "Invalid map size '${SOAK_MAP_SIZE}' (tip: use <x>x<y>, like 256x256)")
+    endif()
+
+    # The configuration stores the map size as a power of two.
+    foreach(AXIS x y)
+        if(AXIS STREQUAL "x")
+            set(SIZE ${CMAKE_MATCH_1})
+        else()
+            set(SIZE ${CMAKE_MATCH_2})
+        endif()
+
+        unset(MAP_${AXIS})
+        foreach(BITS RANGE 6 12)
+            math(EXPR POWER "1 << ${BITS}")
+            if(POWER EQUAL SIZE)
+                set(MAP_${AXIS} ${BITS})
+            endif()
+        endforeach()
+        if(NOT DEFINED MAP_${AXIS})
+            message(FATAL_ERROR "Invalid map size '${SOAK_MAP_SIZE}' (tip: use powers of two between 64 and 4096)")
+        endif()
+    endforeach()
+
+    foreach(SOAK_SEED IN LISTS SOAK_SEEDS)
+        set(SOAK_NAME "soak_${SOAK_MAP_SIZE}_${SOAK_SEED}")
+        set(SOAK_DIR "${CMAKE_CURRENT_BINARY_DIR}/soak/${SOAK_NAME}")
+
+        # Start with a clean personal directory, so only the messages of this run are checked.
+        file(REMOVE_RECURSE ${SOAK_DIR})
+        file(MAKE_DIRECTORY ${SOAK_DIR})
+        file(WRITE ${SOAK_DIR}/openttd.cfg
+"[misc]
+language = english.lng
+
+[gui]
+autosave = off
+
+[game_creation]
+town_name = english
+map_x = ${MAP_x}
+map_y = ${MAP_y}
+
+[difficulty]
+max_no_competitors = ${SOAK_AIS}
+competitors_interval = 0
+infinite_money = true
+
+[ai_players]
+${SOAK_AI_PLAYERS}"
+        )
+
+        # With a configuration file given, the working directory is the personal directory.
+        message(STATUS "Running ${SOAK_NAME} for ${SOAK_TICKS} ticks")
+        execute_process(COMMAND ${OPENTTD_EXECUTABLE}
+                                -x
+                                -c openttd.cfg
+                                -G ${SOAK_SEED}
+                                -g
+                                -snull
+                                -mnull
+                                -vnull:ticks=${SOAK_TICKS},report=report.json
+                                -d script=2
+                                -d desync=3
+                                -Q
+                        WORKING_DIRECTORY ${SOAK_DIR}
+                        RESULT_VARIABLE SOAK_EXIT_CODE
+                        OUTPUT_VARIABLE SOAK_OUTPUT
+                        ERROR_VARIABLE SOAK_OUTPUT
+        )
+        file(WRITE ${SOAK_DIR}/output.txt "${SOAK_OUTPUT}")
+
+        # The cache checks log their mismatches to the desync log, not to the output.
+        set(SOAK_DESYNC_LOG "")
+        if(EXISTS ${SOAK_DIR}/save/autosave/commands-out.log)
+            file(READ ${SOAK_DIR}/save/autosave/commands-out.log SOAK_DESYNC_LOG)
+        endif()
+
+        set(SOAK_RESULT "ok")
+        if(NOT SOAK_EXIT_CODE EQUAL 0)
+            set(SOAK_RESULT "crashed (${SOAK_EXIT_CODE})")
+        elseif(NOT EXISTS ${SOAK_DIR}/save/autosave/commands-out.log)
+            set(SOAK_RESULT "no desync log")
+        elseif(SOAK_DESYNC_LOG MATCHES "mismatch")
+            set(SOAK_RESULT "cache mismatch")
+        elseif(SOAK_OUTPUT MATCHES "Your script made an error|The script died")
+            set(SOAK_RESULT "script error")
+        elseif(NOT EXISTS ${SOAK_DIR}/report.json)
+            set(SOAK_RESULT "no report")
+        endif()
+
+        set(TICKS_PER_SECOND "-")
+        if(EXISTS ${SOAK_DIR}/report.json)
+            file(READ ${SOAK_DIR}/report.json SOAK_REPORT)
+            if(SOAK_REPORT MATCHES "\"ticks_per_second\": ([0-9.eE+-]+)")
+                set(TICKS_PER_SECOND ${CMAKE_MATCH_1})
+            endif()
+        endif()
+
+        if(NOT SOAK_RESULT STREQUAL "ok")
+            set(ERROR YES)
+            string(APPEND SOAK_RESULT " - output and logs in ${SOAK_DIR}")
+        endif()
+        string(APPEND SOAK_SUMMARY "  map ${SOAK_MAP_SIZE}, seed ${SOAK_SEED}: ${TICKS_PER_SECOND} ticks/s, ${SOAK_RESULT}\n")
+    endforeach()
+endforeach()
+
+message("Soak test results (${SOAK_TICKS} ticks, ${SOAK_AIS} AIs):\n${SOAK_SUMMARY}")
+
+if(ERROR)
+    message(FATAL_ERROR "Soak test failed")
+endif()
@@ -0,0 +1,13 @@
+class Soak extends AIInfo {
+	function GetAuthor()      { return "OpenTTD NoAI Developers Team"; }
+	function GetName()        { return "Soak"; }
+	function GetShortName()   { return "SOAK"; }
+	function GetDescription() { return "Executes a stream of random commands for soak testing. With the same seed the commands are always the same."; }
+	function GetVersion()     { return 1; }
+	function GetAPIVersion()  { return "15"; }
+	function GetDate()        { return "2026-10-18"; }
+	function CreateInstance() { return "Soak"; }
+	function UseAsRandomAI()  { return false; }
+}
+
+RegisterAI(Soak());
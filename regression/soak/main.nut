@@ -0,0 +1,143 @@
+class Soak extends AIController {
+	function Start();
+};
+
+/**
+ * Get a random tile that is not at the edge of the map.
+ */
+function Soak::RandomTile()
+{
+	return AIMap.GetTileIndex(1 + AIBase.RandRange(AIMap.GetMapSizeX() - 2), 1 + AIBase.RandRange(AIMap.GetMapSizeY() - 2));
+}
+
+/**
+ * Get a random tile next to the given tile.
+ */
+function Soak::RandomNeighbour(tile)
+{
+	switch (AIBase.RandRange(4)) {
+		case 0: return tile + AIMap.GetTileIndex(1, 0);
+		case 1: return tile - AIMap.GetTileIndex(1, 0);
+		case 2: return tile + AIMap.GetTileIndex(0, 1);
+		default: return tile - AIMap.GetTileIndex(0, 1);
+	}
+}
+
+/**
+ * Get a random item of a list, or null when the list is empty.
+ */
+function Soak::RandomItem(list)
+{
+	if (list.IsEmpty()) return null;
+	local n = AIBase.RandRange(list.Count());
+	local item = list.Begin();
+	for (local i = 0; i < n; i++) item = list.Next();
+	return item;
+}
+
+/**
+ * Build a straight piece of road, with a station or depot at one end now and then.
+ */
+function Soak::BuildRoad()
+{
+	local from = this.RandomTile();
+	local offset = AIBase.RandRange(2) == 0 ? AIMap.GetTileIndex(AIBase.RandRange(16), 0) : AIMap.GetTileIndex(0, AIBase.RandRange(16));
+	local to = from + offset;
+	if (!AIMap.IsValidTile(to)) return;
+
+	AIRoad.BuildRoad(from, to);
+	switch (AIBase.RandRange(3)) {
+		case 0: AIRoad.BuildDriveThroughRoadStation(from, this.RandomNeighbour(from), AIRoad.ROADVEHTYPE_BUS, AIStation.STATION_NEW); break;
+		case 1: AIRoad.BuildRoadDepot(to, this.RandomNeighbour(to)); break;
+	}
+}
+
+/**
+ * Build a straight piece of rail, with a station or depot at one end now and then.
+ */
+function Soak::BuildRail()
+{
+	local tile = this.RandomTile();
+	local track = AIBase.RandRange(2) == 0 ? AIRail.RAILTRACK_NE_SW : AIRail.RAILTRACK_NW_SE;
+	local step = track == AIRail.RAILTRACK_NE_SW ? AIMap.GetTileIndex(1, 0) : AIMap.GetTileIndex(0, 1);
+	local length = 2 + AIBase.RandRange(16);
+
+	for (local i = 0; i < length && AIMap.IsValidTile(tile + i * step); i++) {
+		AIRail.BuildRailTrack(tile + i * step, track);
+	}
+	switch (AIBase.RandRange(3)) {
+		case 0: AIRail.BuildRailStation(tile, track, 1 + AIBase.RandRange(2), 2 + AIBase.RandRange(4), AIStation.STATION_NEW); break;
+		case 1: AIRail.BuildRailDepot(tile - step, tile); break;
+	}
+}
+
+/**
+ * Buy a vehicle in a random depot, give it orders and start it.
+ */
+function Soak::BuildVehicle()
+{
+	local rail = AIBase.RandRange(2) == 0;
+	local depot = this.RandomItem(AIDepotList(rail ? AITile.TRANSPORT_RAIL : AITile.TRANSPORT_ROAD));
+	if (depot == null) return;
+
+	local engines = AIEngineList(rail ? AIVehicle.VT_RAIL : AIVehicle.VT_ROAD);
+	engines.Valuate(AIEngine.IsBuildable);
+	engines.KeepValue(1);
+	local engine = this.RandomItem(engines);
+	if (engine == null) return;
+
+	local vehicle = AIVehicle.BuildVehicle(depot, engine);
+	if (!AIVehicle.IsValidVehicle(vehicle)) return;
+
+	local stations = AIStationList(rail ? AIStation.STATION_TRAIN : AIStation.STATION_BUS_STOP);
+	for (local i = 0; i < 2; i++) {
+		local station = this.RandomItem(stations);
+		if (station != null) AIOrder.AppendOrder(vehicle, AIStation.GetLocation(station), AIOrder.OF_NONE);
+	}
+	AIVehicle.StartStopVehicle(vehicle);
+}
+
+/**
+ * Send a random vehicle to its depot, or sell it when it is already stopped there.
+ */
+function Soak::RemoveVehicle()
+{
+	local vehicle = this.RandomItem(AIVehicleList());
+	if (vehicle == null) return;
+
+	if (AIVehicle.IsStoppedInDepot(vehicle)) {
+		AIVehicle.SellVehicle(vehicle);
+	} else {
+		AIVehicle.SendVehicleToDepot(vehicle);
+	}
+}
+
+/**
+ * Change the landscape at a random tile.
+ */
+function Soak::ChangeLandscape()
+{
+	local tile = this.RandomTile();
+	switch (AIBase.RandRange(3)) {
+		case 0: AITile.RaiseTile(tile, AITile.SLOPE_N); break;
+		case 1: AITile.LowerTile(tile, AITile.SLOPE_N); break;
+		default: AITile.DemolishTile(tile); break;
+	}
+}
+
+function Soak::Start()
+{
+	AIRoad.SetCurrentRoadType(AIRoad.ROADTYPE_ROAD);
+	AIRail.SetCurrentRailType(AIRailTypeList().Begin());
+
+	while (true) {
+		switch (AIBase.RandRange(10)) {
+			case 0: case 1: case 2: this.BuildRoad(); break;
+			case 3: case 4: this.BuildRail(); break;
+			case 5: case 6: this.BuildVehicle(); break;
+			case 7: this.RemoveVehicle(); break;
+			default: this.ChangeLandscape(); break;
+		}
+		this.Sleep(1 + AIBase.RandRange(5));
+	}
+}
@@ -15,6 +15,9 @@
 #include "../network/network.h"
 #include "../window_func.h"
 #include "../framerate_type.h"
+#include "../allocation_tracker.h"
+#include "../scope_profiler.h"
+#include "../tick_cost.h"
 #include "ai_scanner.hpp"
 #include "ai_instance.hpp"
 #include "ai_config.hpp"
@@ -84,7 +87,12 @@
 	Backup<CompanyID> cur_company(_current_company);
 	for (const Company *c : Company::Iterate()) {
 		if (c->is_ai) {
+			if (TickCostAccounting::ShouldThrottleScript(c->index)) continue;
+
 			PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
+			ProfileScope profile("AI", c->index.base());
+			AllocationScope allocations(AllocationTag::Scripts);
+			TickCostMeasurer tick_cost(c->index, TickCostType::Script);
 			cur_company.Change(c->index);
 			c->ai_instance->GameLoop();
 			/* Occasionally collect garbage; every 255 ticks do one company.
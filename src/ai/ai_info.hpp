@@ -50,6 +50,8 @@ public:
 	 */
 	const std::string &GetAPIVersion() const { return this->api_version; }
 
+	std::unique_ptr<ScriptInfo> Clone() const override { return std::make_unique<AIInfo>(*this); }
+
 private:
 	int min_loadable_version; ///< The AI can load savegame data if the version is equal or greater than this.
 	bool use_as_random;       ///< Should this AI be used when the user wants a "random AI"?
@@ -76,6 +78,8 @@ public:
 	 */
 	const std::string &GetCategory() const { return this->category; }
 
+	std::unique_ptr<ScriptInfo> Clone() const override { return std::make_unique<AILibrary>(*this); }
+
 private:
 	std::string category; ///< The category this library is in.
 };
@@ -32,6 +32,7 @@
 #include "company_func.h"
 #include "effectvehicle_func.h"
 #include "station_base.h"
+#include "station_kdtree.h"
 #include "engine_base.h"
 #include "core/random_func.hpp"
 #include "core/backup_type.hpp"
@@ -39,6 +40,7 @@
 #include "disaster_vehicle.h"
 #include "newgrf_airporttiles.h"
 #include "framerate_type.h"
+#include "scope_profiler.h"
 #include "aircraft_cmd.h"
 #include "vehicle_cmd.h"
 
@@ -84,8 +86,8 @@ void Aircraft::UpdateDeltaXY()
 }
 
 static bool AirportMove(Aircraft *v, const AirportFTAClass *apc);
-static bool AirportSetBlocks(Aircraft *v, const AirportFTA *current_pos, const AirportFTAClass *apc);
-static bool AirportHasBlock(Aircraft *v, const AirportFTA *current_pos, const AirportFTAClass *apc);
+static bool AirportSetBlocks(Aircraft *v, const AirportFTA *current_pos);
+static bool AirportHasBlock(Aircraft *v, const AirportFTA *current_pos);
 static bool AirportFindFreeTerminal(Aircraft *v, const AirportFTAClass *apc);
 static bool AirportFindFreeHelipad(Aircraft *v, const AirportFTAClass *apc);
 static void CrashAirplane(Aircraft *v);
@@ -123,8 +125,6 @@ enum HelicopterRotorStates : uint8_t {
  */
 static StationID FindNearestHangar(const Aircraft *v)
 {
-	uint best = 0;
-	StationID index = StationID::Invalid();
 	TileIndex vtile = TileVirtXY(v->x_pos, v->y_pos);
 	const AircraftVehicleInfo *avi = AircraftVehInfo(v->engine_type);
 	uint max_range = v->acache.cached_max_range_sqr;
@@ -143,32 +143,30 @@ static StationID FindNearestHangar(const Aircraft *v)
 		}
 	}
 
-	for (const Station *st : Station::Iterate()) {
-		if (st->owner != v->owner || !st->facilities.Test(StationFacility::Airport) || !st->airport.HasHangar()) continue;
-
+	auto filter = [&](StationID index) {
+		const Station *st = Station::Get(index);
 		const AirportFTAClass *afc = st->airport.GetFTA();
 
 		/* don't crash the plane if we know it can't land at the airport */
-		if (afc->flags.Test(AirportFTAClass::Flag::ShortStrip) && (avi->subtype & AIR_FAST) && !_cheats.no_jetcrash.value) continue;
+		if (afc->flags.Test(AirportFTAClass::Flag::ShortStrip) && (avi->subtype & AIR_FAST) && !_cheats.no_jetcrash.value) return false;
 
 		/* the plane won't land at any helicopter station */
-		if (!afc->flags.Test(AirportFTAClass::Flag::Airplanes) && (avi->subtype & AIR_CTOL)) continue;
+		if (!afc->flags.Test(AirportFTAClass::Flag::Airplanes) && (avi->subtype & AIR_CTOL)) return false;
 
 		/* Check if our last and next destinations can be reached from the depot airport. */
 		if (max_range != 0) {
 			uint last_dist = (last_dest != nullptr && last_dest->airport.tile != INVALID_TILE) ? DistanceSquare(st->airport.tile, last_dest->airport.tile) : 0;
 			uint next_dist = (next_dest != nullptr && next_dest->airport.tile != INVALID_TILE) ? DistanceSquare(st->airport.tile, next_dest->airport.tile) : 0;
-			if (last_dist > max_range || next_dist > max_range) continue;
+			if (last_dist > max_range || next_dist > max_range) return false;
 		}
 
-		/* v->tile can't be used here, when aircraft is flying v->tile is set to 0 */
-		uint distance = DistanceSquare(vtile, st->airport.tile);
-		if (distance < best || index == StationID::Invalid()) {
-			best = distance;
-			index = st->index;
-		}
-	}
-	return index;
+		return true;
+	};
+
+	/* v->tile can't be used here, when aircraft is flying v->tile is set to 0 */
+	std::optional<StationID> index = GetHangarKdtree(v->owner).FindNearestIf(TileX(vtile), TileY(vtile), std::numeric_limits<int>::max(), filter,
+			[](int dx, int dy) { return dx * dx + dy * dy; });
+	return index.value_or(StationID::Invalid());
 }
 
 void Aircraft::GetImage(Direction direction, EngineImageType image_type, VehicleSpriteSeq *result) const
@@ -1491,7 +1489,7 @@ void AircraftLeaveHangar(Aircraft *v, Direction exit_dir)
 static void AircraftEventHandler_EnterTerminal(Aircraft *v, const AirportFTAClass *apc)
 {
 	AircraftEntersTerminal(v);
-	v->state = apc->layout[v->pos].heading;
+	v->state = apc->Position(v->pos).heading;
 }
 
 /**
@@ -1502,7 +1500,7 @@ static void AircraftEventHandler_EnterTerminal(Aircraft *v, const AirportFTAClas
 static void AircraftEventHandler_EnterHangar(Aircraft *v, const AirportFTAClass *apc)
 {
 	VehicleEnterDepot(v);
-	v->state = apc->layout[v->pos].heading;
+	v->state = apc->Position(v->pos).heading;
 }
 
 /**
@@ -1538,7 +1536,7 @@ static void AircraftEventHandler_InHangar(Aircraft *v, const AirportFTAClass *ap
 	}
 
 	/* if the block of the next position is busy, stay put */
-	if (AirportHasBlock(v, &apc->layout[v->pos], apc)) return;
+	if (AirportHasBlock(v, &apc->Position(v->pos))) return;
 
 	/* We are already at the target airport, we need to find a terminal */
 	if (v->current_order.GetDestination() == v->targetairport) {
@@ -1582,7 +1580,7 @@ static void AircraftEventHandler_AtTerminal(Aircraft *v, const AirportFTAClass *
 	if (v->current_order.IsType(OT_NOTHING)) return;
 
 	/* if the block of the next position is busy, stay put */
-	if (AirportHasBlock(v, &apc->layout[v->pos], apc)) return;
+	if (AirportHasBlock(v, &apc->Position(v->pos))) return;
 
 	/* airport-road is free. We either have to go to another airport, or to the hangar
 	 * ---> start moving */
@@ -1663,32 +1661,30 @@ static void AircraftEventHandler_Flying(Aircraft *v, const AirportFTAClass *apc)
 		 * if it is an airplane, look for LANDING, for helicopter HELILANDING
 		 * it is possible to choose from multiple landing runways, so loop until a free one is found */
 		uint8_t landingtype = (v->subtype == AIR_HELICOPTER) ? HELILANDING : LANDING;
-		const AirportFTA *current = apc->layout[v->pos].next.get();
-		while (current != nullptr) {
-			if (current->heading == landingtype) {
+		for (const AirportFTA &current : apc->Transitions(v->pos).subspan(1)) {
+			if (current.heading == landingtype) {
 				/* save speed before, since if AirportHasBlock is false, it resets them to 0
 				 * we don't want that for plane in air
 				 * hack for speed thingie */
 				uint16_t tcur_speed = v->cur_speed;
 				uint16_t tsubspeed = v->subspeed;
-				if (!AirportHasBlock(v, current, apc)) {
+				if (!AirportHasBlock(v, &current)) {
 					v->state = landingtype; // LANDING / HELILANDING
 					if (v->state == HELILANDING) SetBit(v->flags, VAF_HELI_DIRECT_DESCENT);
 					/* it's a bit dirty, but I need to set position to next position, otherwise
 					 * if there are multiple runways, plane won't know which one it took (because
 					 * they all have heading LANDING). And also occupy that block! */
-					v->pos = current->next_position;
-					st->airport.blocks.Set(apc->layout[v->pos].blocks);
+					v->pos = current.next_position;
+					st->airport.blocks.Set(apc->Position(v->pos).blocks);
 					return;
 				}
 				v->cur_speed = tcur_speed;
 				v->subspeed = tsubspeed;
 			}
-			current = current->next.get();
 		}
 	}
 	v->state = FLYING;
-	v->pos = apc->layout[v->pos].next_position;
+	v->pos = apc->Position(v->pos).next_position;
 }
 
 static void AircraftEventHandler_Landing(Aircraft *v, const AirportFTAClass *)
@@ -1713,7 +1709,7 @@ static void AircraftEventHandler_HeliLanding(Aircraft *v, const AirportFTAClass
 static void AircraftEventHandler_EndLanding(Aircraft *v, const AirportFTAClass *apc)
 {
 	/* next block busy, don't do a thing, just wait */
-	if (AirportHasBlock(v, &apc->layout[v->pos], apc)) return;
+	if (AirportHasBlock(v, &apc->Position(v->pos))) return;
 
 	/* if going to terminal (OT_GOTO_STATION) choose one
 	 * 1. in case all terminals are busy AirportFindFreeTerminal() returns false or
@@ -1729,7 +1725,7 @@ static void AircraftEventHandler_EndLanding(Aircraft *v, const AirportFTAClass *
 static void AircraftEventHandler_HeliEndLanding(Aircraft *v, const AirportFTAClass *apc)
 {
 	/*  next block busy, don't do a thing, just wait */
-	if (AirportHasBlock(v, &apc->layout[v->pos], apc)) return;
+	if (AirportHasBlock(v, &apc->Position(v->pos))) return;
 
 	/* if going to helipad (OT_GOTO_STATION) choose one. If airport doesn't have helipads, choose terminal
 	 * 1. in case all terminals/helipads are busy (AirportFindFreeHelipad() returns false) or
@@ -1779,10 +1775,10 @@ static AircraftStateHandler * const _aircraft_state_handlers[] = {
 static void AirportClearBlock(const Aircraft *v, const AirportFTAClass *apc)
 {
 	/* we have left the previous block, and entered the new one. Free the previous block */
-	if (apc->layout[v->previous_pos].blocks != apc->layout[v->pos].blocks) {
+	if (apc->Position(v->previous_pos).blocks != apc->Position(v->pos).blocks) {
 		Station *st = Station::Get(v->targetairport);
 
-		st->airport.blocks.Reset(apc->layout[v->previous_pos].blocks);
+		st->airport.blocks.Reset(apc->Position(v->previous_pos).blocks);
 	}
 }
 
@@ -1806,7 +1802,7 @@ static bool AirportMove(Aircraft *v, const AirportFTAClass *apc)
 		assert(v->pos < apc->nofelements);
 	}
 
-	const AirportFTA *current = &apc->layout[v->pos];
+	const AirportFTA *current = &apc->Position(v->pos);
 	/* we have arrived in an important state (eg terminal, hangar, etc.) */
 	if (current->heading == v->state) {
 		uint8_t prev_pos = v->pos; // location could be changed in state, so save it before-hand
@@ -1819,53 +1815,28 @@ static bool AirportMove(Aircraft *v, const AirportFTAClass *apc)
 
 	v->previous_pos = v->pos; // save previous location
 
-	/* there is only one choice to move to */
-	if (current->next == nullptr) {
-		if (AirportSetBlocks(v, current, apc)) {
-			v->pos = current->next_position;
-			UpdateAircraftCache(v);
-		} // move to next position
-		return false;
+	/* take the only choice there is, or the one that matches our heading */
+	current = apc->Transition(v->pos, v->state);
+	if (current == nullptr) {
+		Debug(misc, 0, "[Ap] cannot move further on Airport! (pos {} state {}) for vehicle {}", v->pos, v->state, v->index);
+		NOT_REACHED();
 	}
 
-	/* there are more choices to choose from, choose the one that
-	 * matches our heading */
-	do {
-		if (v->state == current->heading || current->heading == TO_ALL) {
-			if (AirportSetBlocks(v, current, apc)) {
-				v->pos = current->next_position;
-				UpdateAircraftCache(v);
-			} // move to next position
-			return false;
-		}
-		current = current->next.get();
-	} while (current != nullptr);
-
-	Debug(misc, 0, "[Ap] cannot move further on Airport! (pos {} state {}) for vehicle {}", v->pos, v->state, v->index);
-	NOT_REACHED();
+	if (AirportSetBlocks(v, current)) {
+		v->pos = current->next_position;
+		UpdateAircraftCache(v);
+	} // move to next position
+	return false;
 }
 
 /** returns true if the road ahead is busy, eg. you must wait before proceeding. */
-static bool AirportHasBlock(Aircraft *v, const AirportFTA *current_pos, const AirportFTAClass *apc)
+static bool AirportHasBlock(Aircraft *v, const AirportFTA *current_pos)
 {
-	const AirportFTA *reference = &apc->layout[v->pos];
-	const AirportFTA *next = &apc->layout[current_pos->next_position];
-
-	/* same block, then of course we can move */
-	if (apc->layout[current_pos->position].blocks != next->blocks) {
-		const Station *st = Station::Get(v->targetairport);
-		AirportBlocks blocks = next->blocks;
-
-		/* check additional possible extra blocks */
-		if (current_pos != reference && current_pos->blocks != AirportBlock::Nothing) {
-			blocks.Set(current_pos->blocks);
-		}
-
-		if (st->airport.blocks.Any(blocks)) {
-			v->cur_speed = 0;
-			v->subspeed = 0;
-			return true;
-		}
+	const Station *st = Station::Get(v->targetairport);
+	if (st->airport.blocks.Any(current_pos->wait_blocks)) {
+		v->cur_speed = 0;
+		v->subspeed = 0;
+		return true;
 	}
 	return false;
 }
@@ -1873,45 +1844,22 @@ static bool AirportHasBlock(Aircraft *v, const AirportFTA *current_pos, const Ai
 /**
  * "reserve" a block for the plane
  * @param v airplane that requires the operation
- * @param current_pos of the vehicle in the list of blocks
- * @param apc airport on which block is requested to be set
+ * @param current_pos transition from the position of the vehicle it wants to take
  * @returns true on success. Eg, next block was free and we have occupied it
  */
-static bool AirportSetBlocks(Aircraft *v, const AirportFTA *current_pos, const AirportFTAClass *apc)
-{
-	const AirportFTA *next = &apc->layout[current_pos->next_position];
-	const AirportFTA *reference = &apc->layout[v->pos];
-
-	/* if the next position is in another block, check it and wait until it is free */
-	if (!apc->layout[current_pos->position].blocks.All(next->blocks)) {
-		AirportBlocks blocks = next->blocks;
-		/* search for all all elements in the list with the same state, and blocks != N
-		 * this means more blocks should be checked/set */
-		const AirportFTA *current = current_pos;
-		if (current == reference) current = current->next.get();
-		while (current != nullptr) {
-			if (current->heading == current_pos->heading && current->blocks.Any()) {
-				blocks.Set(current->blocks);
-				break;
-			}
-			current = current->next.get();
-		}
-
-		/* if the block to be checked is in the next position, then exclude that from
-		 * checking, because it has been set by the airplane before */
-		if (current_pos->blocks == next->blocks) blocks.Flip(next->blocks);
-
-		Station *st = Station::Get(v->targetairport);
-		if (st->airport.blocks.Any(blocks)) {
-			v->cur_speed = 0;
-			v->subspeed = 0;
-			return false;
-		}
+static bool AirportSetBlocks(Aircraft *v, const AirportFTA *current_pos)
+{
+	/* the blocks to check were determined when the airport was built, see AirportPrecomputeBlocks */
+	if (current_pos->reserve_blocks.None()) return true;
 
-		if (next->blocks != AirportBlock::Nothing) {
-			st->airport.blocks.Set(blocks); // occupy next block
-		}
+	Station *st = Station::Get(v->targetairport);
+	if (st->airport.blocks.Any(current_pos->reserve_blocks)) {
+		v->cur_speed = 0;
+		v->subspeed = 0;
+		return false;
 	}
+
+	st->airport.blocks.Set(current_pos->reserve_blocks); // occupy next block
 	return true;
 }
 
@@ -1995,14 +1943,12 @@ static bool AirportFindFreeTerminal(Aircraft *v, const AirportFTAClass *apc)
 	 */
 	if (apc->terminals[0] > 1) {
 		const Station *st = Station::Get(v->targetairport);
-		const AirportFTA *temp = apc->layout[v->pos].next.get();
-
-		while (temp != nullptr) {
-			if (temp->heading == TERMGROUP) {
-				if (!st->airport.blocks.Any(temp->blocks)) {
+		for (const AirportFTA &temp : apc->Transitions(v->pos).subspan(1)) {
+			if (temp.heading == TERMGROUP) {
+				if (!st->airport.blocks.Any(temp.blocks)) {
 					/* read which group do we want to go to?
 					 * (the first free group) */
-					uint target_group = temp->next_position + 1;
+					uint target_group = temp.next_position + 1;
 
 					/* at what terminal does the group start?
 					 * that means, sum up all terminals of
@@ -2020,7 +1966,6 @@ static bool AirportFindFreeTerminal(Aircraft *v, const AirportFTAClass *apc)
 				 * So we cannot move */
 				return false;
 			}
-			temp = temp->next.get();
 		}
 	}
 
@@ -2113,6 +2058,7 @@ bool Aircraft::Tick()
 	if (!this->IsNormalAircraft()) return true;
 
 	PerformanceAccumulator framerate(PFE_GL_AIRCRAFT);
+	ProfileScope profile("Aircraft", this->index.base());
 
 	this->tick_counter++;
 
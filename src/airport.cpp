@@ -67,7 +67,7 @@ AIRPORT_GENERIC(dummy, nullptr, 0, AirportFTAClass::Flags({AirportFTAClass::Flag
 
 
 static uint16_t AirportGetNofElements(const AirportFTAbuildup *apFA);
-static void AirportBuildAutomata(std::vector<AirportFTA> &layout, uint8_t nofelements, const AirportFTAbuildup *apFA);
+static void AirportBuildAutomata(AirportFTAClass &apc, const AirportFTAbuildup *apFA);
 
 
 /**
@@ -127,7 +127,7 @@ AirportFTAClass::AirportFTAClass(
 	delta_z(delta_z_)
 {
 	/* Build the state machine itself */
-	AirportBuildAutomata(this->layout, this->nofelements, apFA);
+	AirportBuildAutomata(*this, apFA);
 }
 
 /**
@@ -155,26 +155,76 @@ AirportFTA::AirportFTA(const AirportFTAbuildup &buildup) : blocks(buildup.blocks
 }
 
 /**
- * Construct the FTA given a description.
- * @param layout The vector to write the automata to.
- * @param nofelements The number of elements in the FTA.
+ * Precompute the blocks an aircraft has to check, and possibly reserve, when it takes a transition.
+ * @param apc The airport whose transitions are already in place.
+ * @param transition The transition to precompute the blocks for.
+ * @param transitions All transitions from the position of \a transition.
+ */
+static void AirportPrecomputeBlocks(const AirportFTAClass &apc, AirportFTA &transition, std::span<AirportFTA> transitions)
+{
+	const AirportFTA &reference = transitions.front();
+	const AirportFTA &next = apc.Position(transition.next_position);
+
+	/* Moving within the same block never waits. Other than that, the aircraft waits for
+	 * the next block, and the block of the transition itself if it isn't the first one. */
+	if (reference.blocks != next.blocks) {
+		transition.wait_blocks = next.blocks;
+		if (&transition != &reference && transition.blocks != AirportBlock::Nothing) transition.wait_blocks.Set(transition.blocks);
+	}
+
+	/* When the next position is in another block, check and reserve it, and the blocks
+	 * of the first later transition with the same heading that has any. */
+	if (!reference.blocks.All(next.blocks)) {
+		AirportBlocks blocks = next.blocks;
+		auto it = std::ranges::find_if(transitions, [&transition](const AirportFTA &t) { return &t == &transition; });
+		if (&transition == &reference) ++it;
+		for (; it != std::end(transitions); ++it) {
+			if (it->heading == transition.heading && it->blocks.Any()) {
+				blocks.Set(it->blocks);
+				break;
+			}
+		}
+
+		/* The aircraft has already reserved the block of the next position if it is its current block. */
+		if (transition.blocks == next.blocks) blocks.Flip(next.blocks);
+		transition.reserve_blocks = blocks;
+	}
+}
+
+/**
+ * Construct the FTA given a description, and compile it into tables
+ * so aircraft don't need to search the transitions on every move.
+ * @param apc The airport to write the automata to.
  * @param apFA The description of the FTA.
  */
-static void AirportBuildAutomata(std::vector<AirportFTA> &layout, uint8_t nofelements, const AirportFTAbuildup *apFA)
+static void AirportBuildAutomata(AirportFTAClass &apc, const AirportFTAbuildup *apFA)
 {
-	uint16_t internalcounter = 0;
+	/* Transitions from the same position are consecutive in the description. */
+	apc.first_transition.reserve(apc.nofelements + 1);
+	for (uint i = 0; apFA[i].position != MAX_ELEMENTS; i++) {
+		if (i == 0 || apFA[i].position != apFA[i - 1].position) apc.first_transition.push_back(static_cast<uint16_t>(i));
+		apc.transitions.emplace_back(apFA[i]);
+	}
+	apc.first_transition.push_back(static_cast<uint16_t>(apc.transitions.size()));
+	assert(apc.first_transition.size() == apc.nofelements + 1U);
+
+	apc.heading_transition.assign(apc.nofelements * (MAX_HEADINGS + 1), UINT8_MAX);
+	for (uint8_t pos = 0; pos < apc.nofelements; pos++) {
+		std::span<AirportFTA> transitions = std::span(apc.transitions).subspan(apc.first_transition[pos], apc.first_transition[pos + 1] - apc.first_transition[pos]);
+		assert(transitions.front().position == pos);
 
-	layout.reserve(nofelements);
-	for (uint i = 0; i < nofelements; i++) {
-		AirportFTA *current = &layout.emplace_back(apFA[internalcounter]);
+		for (AirportFTA &transition : transitions) AirportPrecomputeBlocks(apc, transition, transitions);
 
-		/* outgoing nodes from the same position, create linked list */
-		while (current->position == apFA[internalcounter + 1].position) {
-			current->next = std::make_unique<AirportFTA>(apFA[internalcounter + 1]);
-			current = current->next.get();
-			internalcounter++;
+		/* With only one choice, it is taken whatever the aircraft heads for. Otherwise it takes
+		 * the first one that matches its heading. */
+		for (uint state = 0; state <= MAX_HEADINGS; state++) {
+			for (uint8_t i = 0; i < transitions.size(); i++) {
+				if (transitions.size() == 1 || transitions[i].heading == state || transitions[i].heading == TO_ALL) {
+					apc.heading_transition[pos * (MAX_HEADINGS + 1) + state] = i;
+					break;
+				}
+			}
 		}
-		internalcounter++;
 	}
 }
 
@@ -204,8 +254,8 @@ uint8_t GetVehiclePosOnBuild(TileIndex hangar_tile)
 	 * of all depots, it is simple */
 	for (uint i = 0;; i++) {
 		if (st->airport.GetHangarTile(i) == hangar_tile) {
-			assert(apc->layout[i].heading == HANGAR);
-			return apc->layout[i].position;
+			assert(apc->Position(i).heading == HANGAR);
+			return apc->Position(i).position;
 		}
 	}
 	NOT_REACHED();
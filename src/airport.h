@@ -147,8 +147,9 @@ struct AirportFTAbuildup;
 struct AirportFTA {
 	AirportFTA(const AirportFTAbuildup&);
 
-	std::unique_ptr<AirportFTA> next; ///< possible extra movement choices from this position
 	AirportBlocks blocks; ///< bitmap of blocks that could be reserved
+	AirportBlocks wait_blocks; ///< blocks that have to be free before an aircraft at this position may take this transition, see AirportHasBlock
+	AirportBlocks reserve_blocks; ///< blocks that have to be free and get reserved when an aircraft takes this transition, see AirportSetBlocks
 	uint8_t position; ///< the position that an airplane is at
 	uint8_t next_position; ///< next position from this position
 	uint8_t heading; ///< heading (current orders), guiding an airplane to its target on an airport
@@ -186,8 +187,46 @@ public:
 		return &moving_data[position];
 	}
 
+	/**
+	 * Get the movement choices from a position.
+	 * @param position Element number to get the transitions of.
+	 * @return The transitions, in order of preference.
+	 */
+	std::span<const AirportFTA> Transitions(uint8_t position) const
+	{
+		assert(position < nofelements);
+		return std::span(this->transitions).subspan(this->first_transition[position], this->first_transition[position + 1] - this->first_transition[position]);
+	}
+
+	/**
+	 * Get the first transition from a position, which also describes the position itself.
+	 * @param position Element number to get the transition of.
+	 * @return The first transition.
+	 */
+	const AirportFTA &Position(uint8_t position) const
+	{
+		assert(position < nofelements);
+		return this->transitions[this->first_transition[position]];
+	}
+
+	/**
+	 * Get the transition an aircraft takes from a position when it is heading for a state.
+	 * @param position Element number the aircraft is at.
+	 * @param state Movement state of the aircraft.
+	 * @return The transition, or \c nullptr if the aircraft can't move on.
+	 */
+	const AirportFTA *Transition(uint8_t position, uint8_t state) const
+	{
+		assert(position < nofelements);
+		if (state > MAX_HEADINGS) return nullptr;
+		uint8_t index = this->heading_transition[position * (MAX_HEADINGS + 1) + state];
+		return index == UINT8_MAX ? nullptr : &this->transitions[this->first_transition[position] + index];
+	}
+
 	const AirportMovingData *moving_data; ///< Movement data.
-	std::vector<AirportFTA> layout; ///< state machine for airport
+	std::vector<AirportFTA> transitions; ///< state machine for airport; all movement choices, grouped by position
+	std::vector<uint16_t> first_transition; ///< index of the first transition of each position, followed by the number of transitions
+	std::vector<uint8_t> heading_transition; ///< per position and movement state the index of the transition to take within the position, or UINT8_MAX
 	const uint8_t *terminals;                ///< %Array with the number of terminal groups, followed by the number of terminals in each group.
 	const uint8_t num_helipads;              ///< Number of helipads on this airport. When 0 helicopters will go to normal terminals.
 	Flags flags;                          ///< Flags for this airport type.
@@ -0,0 +1,122 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file allocation_tracker.cpp Attribution of heap allocations to subsystems, by replacing the global operator new. */
+
+#include "stdafx.h"
+#include "allocation_tracker.h"
+#include "core/pool_type.hpp"
+
+#include <atomic>
+#include <new>
+
+/*
+ * The replacement allocation functions need the C allocator underneath, which
+ * safeguards.h forbids. So fetch it before including safeguards.h.
+ */
+static void *AllocateRaw(size_t size) { return std::malloc(size); }
+static void FreeRaw(void *p) { std::free(p); }
+
+#include "safeguards.h"
+
+thread_local AllocationTag _current_allocation_tag = AllocationTag::Other;
+
+/** Counters of a single #AllocationTag, updated by all threads. */
+struct AtomicAllocationCounters {
+	std::atomic<uint64_t> allocations; ///< Number of allocations.
+	std::atomic<uint64_t> frees; ///< Number of frees.
+	std::atomic<uint64_t> bytes_allocated; ///< Number of bytes allocated.
+	std::atomic<uint64_t> bytes_freed; ///< Number of bytes freed.
+};
+
+/** Counters per tag; zero-initialised before any dynamic initialisation, so allocations during start up are counted. */
+static std::array<AtomicAllocationCounters, to_underlying(AllocationTag::End)> _allocation_counters{};
+
+/** Header in front of every tracked allocation. */
+union AllocationHeader {
+	struct {
+		size_t size; ///< Requested size of the allocation.
+		AllocationTag tag; ///< Tag the allocation was made with.
+	} info; ///< The actual information.
+	std::max_align_t align; ///< Keep the returned memory aligned as malloc would.
+};
+
+/** Names of the tags, for the output. */
+static const std::array<std::string_view, to_underlying(AllocationTag::End)> _allocation_tag_names = {
+	"other", "vehicles", "cargo", "pathfinder", "linkgraph", "landscape",
+	"towns", "industries", "scripts", "spritecache", "windows", "saveload",
+};
+
+/**
+ * Get the name of an allocation tag.
+ * @param tag The tag.
+ * @return The name of the tag.
+ */
+std::string_view GetAllocationTagName(AllocationTag tag)
+{
+	return _allocation_tag_names[to_underlying(tag)];
+}
+
+/**
+ * Get the allocation counters of a single tag. Unlike #TakeAllocationSnapshot this does not allocate itself.
+ * @param tag The tag.
+ * @return The counters.
+ */
+AllocationCounters GetAllocationCounters(AllocationTag tag)
+{
+	const AtomicAllocationCounters &c = _allocation_counters[to_underlying(tag)];
+	return {c.allocations.load(std::memory_order_relaxed), c.frees.load(std::memory_order_relaxed),
+			c.bytes_allocated.load(std::memory_order_relaxed), c.bytes_freed.load(std::memory_order_relaxed)};
+}
+
+/**
+ * Take a snapshot of all allocation counters.
+ * @return The snapshot.
+ */
+AllocationSnapshot TakeAllocationSnapshot()
+{
+	AllocationSnapshot snapshot;
+	for (size_t i = 0; i < _allocation_counters.size(); i++) {
+		snapshot.tags[i] = GetAllocationCounters(static_cast<AllocationTag>(i));
+	}
+
+	for (const PoolBase *pool : *PoolBase::GetPools()) {
+		snapshot.pools.emplace_back(std::string{pool->GetName()}, pool->GetItemCount(), pool->GetCapacity(), pool->allocations, pool->frees, pool->bytes);
+	}
+	return snapshot;
+}
+
+void *operator new(size_t size)
+{
+	void *p = AllocateRaw(size + sizeof(AllocationHeader));
+	if (p == nullptr) throw std::bad_alloc();
+
+	AllocationHeader *header = static_cast<AllocationHeader *>(p);
+	header->info.size = size;
+	header->info.tag = _current_allocation_tag;
+
+	AtomicAllocationCounters &c = _allocation_counters[to_underlying(header->info.tag)];
+	c.allocations.fetch_add(1, std::memory_order_relaxed);
+	c.bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+	return header + 1;
+}
+
+void operator delete(void *p) noexcept
+{
+	if (p == nullptr) return;
+
+	AllocationHeader *header = static_cast<AllocationHeader *>(p) - 1;
+	AtomicAllocationCounters &c = _allocation_counters[to_underlying(header->info.tag)];
+	c.frees.fetch_add(1, std::memory_order_relaxed);
+	c.bytes_freed.fetch_add(header->info.size, std::memory_order_relaxed);
+	FreeRaw(header);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	::operator delete(p);
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file allocation_tracker.h Attribution of heap allocations to subsystems, for builds with allocation tracking.
+ *
+ * When built with OPTION_ALLOCATION_TRACKING, every allocation through the global operator new is
+ * counted for the #AllocationTag that is active on the allocating thread. Frees are counted for the
+ * tag the memory was allocated with, so the live bytes of a tag do not depend on who frees them.
+ * Without allocation tracking, #AllocationScope compiles to nothing.
+ *
+ * @see allocation_tracker.cpp for implementation
+ */
+
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include "core/enum_type.hpp"
+
+/** Subsystems allocations are attributed to. */
+enum class AllocationTag : uint8_t {
+	Other, ///< Not attributed to a specific subsystem.
+	Vehicles, ///< Vehicle ticks.
+	Cargo, ///< Cargo lists, while loading and unloading.
+	Pathfinder, ///< Pathfinder node lists and segment caches.
+	LinkGraph, ///< Link graph jobs and the flow maps they produce.
+	Landscape, ///< Tile loop.
+	Towns, ///< Town ticks.
+	Industries, ///< Industry ticks.
+	Scripts, ///< AI and game script VMs.
+	SpriteCache, ///< Sprites in the sprite cache.
+	Windows, ///< Window updates and drawing.
+	SaveLoad, ///< Saving and loading games.
+	End, ///< End marker.
+};
+
+#ifdef WITH_ALLOCATION_TRACKING
+
+/** Allocation counters of a single #AllocationTag. */
+struct AllocationCounters {
+	uint64_t allocations = 0; ///< Number of allocations.
+	uint64_t frees = 0; ///< Number of frees of memory allocated with this tag.
+	uint64_t bytes_allocated = 0; ///< Number of bytes allocated.
+	uint64_t bytes_freed = 0; ///< Number of bytes freed of memory allocated with this tag.
+
+	/**
+	 * Get the number of allocations that have not been freed.
+	 * @return The number of live allocations.
+	 */
+	inline uint64_t GetLiveAllocations() const { return this->allocations - this->frees; }
+
+	/**
+	 * Get the number of bytes that have not been freed.
+	 * @return The number of live bytes.
+	 */
+	inline uint64_t GetLiveBytes() const { return this->bytes_allocated - this->bytes_freed; }
+};
+
+/** Allocation counters of a single pool. */
+struct PoolAllocationCounters {
+	std::string name; ///< Name of the pool.
+	size_t items; ///< Number of items in the pool.
+	size_t capacity; ///< Number of items the pool has room for without growing.
+	uint64_t allocations; ///< Number of items ever allocated.
+	uint64_t frees; ///< Number of items ever freed.
+	uint64_t bytes; ///< Number of bytes used by the items in the pool.
+};
+
+/** State of all allocation counters at a moment in time. */
+struct AllocationSnapshot {
+	std::array<AllocationCounters, to_underlying(AllocationTag::End)> tags{}; ///< Counters per subsystem.
+	std::vector<PoolAllocationCounters> pools; ///< Counters per pool.
+};
+
+std::string_view GetAllocationTagName(AllocationTag tag);
+AllocationCounters GetAllocationCounters(AllocationTag tag);
+AllocationSnapshot TakeAllocationSnapshot();
+
+/** The tag allocations of the current thread are attributed to. */
+extern thread_local AllocationTag _current_allocation_tag;
+
+/**
+ * RAII class that attributes the allocations of the current thread to a subsystem.
+ * Scopes nest; the innermost scope wins.
+ */
+class AllocationScope {
+	AllocationTag previous; ///< Tag to restore when the scope ends.
+public:
+	/**
+	 * Attribute the allocations to a subsystem.
+	 * @param tag The subsystem.
+	 */
+	inline AllocationScope(AllocationTag tag) : previous(_current_allocation_tag)
+	{
+		_current_allocation_tag = tag;
+	}
+
+	inline ~AllocationScope()
+	{
+		_current_allocation_tag = this->previous;
+	}
+
+	AllocationScope(const AllocationScope &) = delete;
+	AllocationScope &operator=(const AllocationScope &) = delete;
+};
+
+#else /* WITH_ALLOCATION_TRACKING */
+
+/** Allocation tracking is disabled; scopes do nothing. */
+class AllocationScope {
+public:
+	inline AllocationScope(AllocationTag) {}
+};
+
+#endif /* WITH_ALLOCATION_TRACKING */
+
+#endif /* ALLOCATION_TRACKER_H */
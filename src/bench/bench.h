@@ -0,0 +1,156 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bench.h Minimal micro-benchmark harness of openttd_bench.
+ *
+ * @par Adding new benchmarks
+ * Write a function taking a #BenchmarkRun, do the setup in it and pass the code to measure to BenchmarkRun::Measure.
+ * Register it with a static #BenchmarkRegistration, named "<area>/<what>", so it can be selected with --filter.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <atomic>
+#include <chrono>
+
+/** Allocations done by the measured code of a benchmark. */
+struct BenchmarkAllocations {
+	uint64_t heap_allocations = 0; ///< Number of heap allocations; only counted in builds with allocation tracking.
+	uint64_t heap_bytes = 0; ///< Number of bytes allocated on the heap; only counted in builds with allocation tracking.
+	uint64_t pool_allocations = 0; ///< Number of items allocated in pools.
+	int64_t pool_bytes = 0; ///< Change of the number of bytes used by the items in pools.
+
+	static BenchmarkAllocations Now();
+
+	/**
+	 * Add the allocations done between two moments.
+	 * @param before Allocations at the start.
+	 * @param after Allocations at the end.
+	 */
+	inline void AddDifference(const BenchmarkAllocations &before, const BenchmarkAllocations &after)
+	{
+		this->heap_allocations += after.heap_allocations - before.heap_allocations;
+		this->heap_bytes += after.heap_bytes - before.heap_bytes;
+		this->pool_allocations += after.pool_allocations - before.pool_allocations;
+		this->pool_bytes += after.pool_bytes - before.pool_bytes;
+	}
+};
+
+/** A single run of a benchmark, with the number of iterations decided by the harness. */
+class BenchmarkRun {
+	uint64_t iterations; ///< Number of times to run the measured code.
+	std::chrono::nanoseconds elapsed{}; ///< Time the measured code took for all iterations.
+	BenchmarkAllocations allocations{}; ///< Allocations of the measured code in all iterations.
+	bool measured = false; ///< Whether #Measure has been called.
+	std::string skipped; ///< Reason why the benchmark could not run, if it was skipped.
+
+public:
+	/**
+	 * Create a run.
+	 * @param iterations Number of times to run the measured code.
+	 */
+	BenchmarkRun(uint64_t iterations) : iterations(iterations) {}
+
+	/**
+	 * Measure the given code, excluding the setup done by the benchmark before calling this.
+	 * @param body The code to measure; called #iterations times with the iteration number.
+	 */
+	template <typename F>
+	void Measure(F &&body)
+	{
+		BenchmarkAllocations before = BenchmarkAllocations::Now();
+		auto start = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < this->iterations; i++) body(i);
+		this->elapsed = std::chrono::steady_clock::now() - start;
+		this->allocations = {};
+		this->allocations.AddDifference(before, BenchmarkAllocations::Now());
+		this->measured = true;
+	}
+
+	/**
+	 * Measure the given code, excluding a setup that has to be done again for every iteration.
+	 * @param setup Code to prepare an iteration; called #iterations times with the iteration number, and returns the state for \a body.
+	 * @param body The code to measure; called with the state returned by \a setup.
+	 */
+	template <typename S, typename F>
+	void Measure(S &&setup, F &&body)
+	{
+		this->elapsed = {};
+		this->allocations = {};
+		for (uint64_t i = 0; i < this->iterations; i++) {
+			auto state = setup(i);
+			BenchmarkAllocations before = BenchmarkAllocations::Now();
+			auto start = std::chrono::steady_clock::now();
+			body(state);
+			this->elapsed += std::chrono::steady_clock::now() - start;
+			this->allocations.AddDifference(before, BenchmarkAllocations::Now());
+		}
+		this->measured = true;
+	}
+
+	/**
+	 * Skip the benchmark, e.g. when the hardware does not support what is benchmarked.
+	 * @param reason Why the benchmark is skipped.
+	 */
+	void Skip(std::string_view reason) { this->skipped = reason; }
+
+	/**
+	 * Get the reason the benchmark was skipped.
+	 * @return The reason, or an empty string when it was not skipped.
+	 */
+	const std::string &GetSkipReason() const { return this->skipped; }
+
+	/**
+	 * Get the time the measured code took.
+	 * @return Total time of all iterations.
+	 */
+	std::chrono::nanoseconds GetElapsed() const { return this->elapsed; }
+
+	/**
+	 * Get the allocations of the measured code.
+	 * @return Allocations of all iterations.
+	 */
+	const BenchmarkAllocations &GetAllocations() const { return this->allocations; }
+
+	/**
+	 * Test whether the benchmark measured anything.
+	 * @return True iff #Measure was called.
+	 */
+	bool IsMeasured() const { return this->measured; }
+};
+
+/** Function implementing a benchmark. */
+using BenchmarkFunction = void (*)(BenchmarkRun &run);
+
+/** Registration of a benchmark in the harness. */
+struct BenchmarkRegistration {
+	std::string_view name; ///< Name of the benchmark.
+	BenchmarkFunction function; ///< The benchmark.
+
+	BenchmarkRegistration(std::string_view name, BenchmarkFunction function);
+
+	static std::vector<const BenchmarkRegistration *> &GetAll();
+};
+
+/**
+ * Prevent the compiler from optimising away a computed value.
+ * @param value The value that must be computed.
+ */
+template <typename T>
+inline void DoNotOptimise(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void *sink;
+	sink = &value;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+#endif /* BENCH_H */
@@ -0,0 +1,131 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bench_blitter.cpp Benchmarks of encoding and drawing sprites with the blitters. */
+
+#include "../stdafx.h"
+#include "../core/random_func.hpp"
+#include "../blitter/factory.hpp"
+#include "../spritecache.h"
+#include "bench.h"
+
+#include "../safeguards.h"
+
+static constexpr uint16_t SPRITE_WIDTH = 64; ///< Width of the benchmarked sprite.
+static constexpr uint16_t SPRITE_HEIGHT = 48; ///< Height of the benchmarked sprite.
+
+/**
+ * Fill a sprite collection with a sprite resembling a building: a transparent border around
+ * opaque pixels, with some semi-transparent and remappable pixels.
+ * @param[out] sprite The sprite collection to fill.
+ */
+static void FillBenchmarkSprite(SpriteLoader::SpriteCollection &sprite)
+{
+	SpriteLoader::Sprite &root = sprite[ZoomLevel::Min];
+	root.width = SPRITE_WIDTH;
+	root.height = SPRITE_HEIGHT;
+	root.x_offs = 0;
+	root.y_offs = 0;
+	root.colours = {SpriteComponent::RGB, SpriteComponent::Alpha, SpriteComponent::Palette};
+	root.AllocateData(ZoomLevel::Min, SPRITE_WIDTH * SPRITE_HEIGHT);
+
+	Randomizer random;
+	random.SetSeed(0x424C4954);
+	for (uint y = 0; y < SPRITE_HEIGHT; y++) {
+		for (uint x = 0; x < SPRITE_WIDTH; x++) {
+			SpriteLoader::CommonPixel &px = root.data[y * SPRITE_WIDTH + x];
+			/* Diamond shaped opaque area, like a tile. */
+			int dx = std::abs(static_cast<int>(x) - SPRITE_WIDTH / 2);
+			int dy = std::abs(static_cast<int>(y) - SPRITE_HEIGHT / 2);
+			if (dx + 2 * dy > SPRITE_WIDTH / 2) continue;
+
+			px.r = random.Next(256);
+			px.g = random.Next(256);
+			px.b = random.Next(256);
+			px.a = random.Next(8) == 0 ? 128 : 255;
+			px.m = random.Next(4) == 0 ? 0x80 + random.Next(8) : 0;
+		}
+	}
+}
+
+/**
+ * Create an instance of a blitter, if it can be used on this machine.
+ * @param run The benchmark run, skipped when the blitter cannot be used.
+ * @param name Name of the blitter.
+ * @return The blitter, or \c nullptr.
+ */
+static std::unique_ptr<Blitter> CreateBenchmarkBlitter(BenchmarkRun &run, std::string_view name)
+{
+	BlitterFactory *factory = BlitterFactory::GetBlitterFactory(name);
+	if (factory == nullptr) {
+		run.Skip("blitter not available");
+		return nullptr;
+	}
+	return factory->CreateInstance();
+}
+
+/**
+ * Encode a sprite for the blitter, like the sprite cache does on a cache miss.
+ * @param run The benchmark run.
+ * @param name Name of the blitter.
+ */
+static void BenchBlitterEncode(BenchmarkRun &run, std::string_view name)
+{
+	std::unique_ptr<Blitter> blitter = CreateBenchmarkBlitter(run, name);
+	if (blitter == nullptr) return;
+
+	SpriteLoader::SpriteCollection sprite;
+	FillBenchmarkSprite(sprite);
+
+	run.Measure([&](uint64_t) {
+		UniquePtrSpriteAllocator allocator;
+		DoNotOptimise(blitter->Encode(SpriteType::Font, sprite, allocator));
+	});
+}
+
+/**
+ * Draw a sprite with the blitter, like drawing the viewports does for every sprite.
+ * @param run The benchmark run.
+ * @param name Name of the blitter.
+ */
+static void BenchBlitterDraw(BenchmarkRun &run, std::string_view name)
+{
+	std::unique_ptr<Blitter> blitter = CreateBenchmarkBlitter(run, name);
+	if (blitter == nullptr) return;
+
+	SpriteLoader::SpriteCollection sprite;
+	FillBenchmarkSprite(sprite);
+	UniquePtrSpriteAllocator allocator;
+	const Sprite *encoded = blitter->Encode(SpriteType::Font, sprite, allocator);
+
+	static constexpr int PITCH = 256;
+	std::vector<uint8_t> buffer(PITCH * SPRITE_HEIGHT * blitter->GetScreenDepth() / 8);
+
+	Blitter::BlitterParams bp{};
+	bp.sprite = encoded->data;
+	bp.sprite_width = encoded->width;
+	bp.sprite_height = encoded->height;
+	bp.width = encoded->width;
+	bp.height = encoded->height;
+	bp.dst = buffer.data();
+	bp.pitch = PITCH;
+
+	run.Measure([&](uint64_t i) {
+		bp.left = static_cast<int>(i % (PITCH - SPRITE_WIDTH));
+		blitter->Draw(&bp, BlitterMode::Normal, ZoomLevel::Min);
+	});
+	DoNotOptimise(buffer);
+}
+
+static BenchmarkRegistration _bench_8bpp_optimized_encode("blitter/8bpp-optimized/encode", [](BenchmarkRun &run) { BenchBlitterEncode(run, "8bpp-optimized"); });
+static BenchmarkRegistration _bench_8bpp_optimized_draw("blitter/8bpp-optimized/draw", [](BenchmarkRun &run) { BenchBlitterDraw(run, "8bpp-optimized"); });
+static BenchmarkRegistration _bench_32bpp_optimized_encode("blitter/32bpp-optimized/encode", [](BenchmarkRun &run) { BenchBlitterEncode(run, "32bpp-optimized"); });
+static BenchmarkRegistration _bench_32bpp_optimized_draw("blitter/32bpp-optimized/draw", [](BenchmarkRun &run) { BenchBlitterDraw(run, "32bpp-optimized"); });
+static BenchmarkRegistration _bench_32bpp_sse2_encode("blitter/32bpp-sse2/encode", [](BenchmarkRun &run) { BenchBlitterEncode(run, "32bpp-sse2"); });
+static BenchmarkRegistration _bench_32bpp_sse2_draw("blitter/32bpp-sse2/draw", [](BenchmarkRun &run) { BenchBlitterDraw(run, "32bpp-sse2"); });
+static BenchmarkRegistration _bench_32bpp_sse4_encode("blitter/32bpp-sse4/encode", [](BenchmarkRun &run) { BenchBlitterEncode(run, "32bpp-sse4"); });
+static BenchmarkRegistration _bench_32bpp_sse4_draw("blitter/32bpp-sse4/draw", [](BenchmarkRun &run) { BenchBlitterDraw(run, "32bpp-sse4"); });
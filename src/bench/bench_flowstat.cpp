@@ -0,0 +1,60 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bench_flowstat.cpp Benchmarks of the cargodist flow statistics. */
+
+#include "../stdafx.h"
+#include "../station_base.h"
+#include "bench.h"
+
+#include "../safeguards.h"
+
+/**
+ * Create a flow stat with a number of next hops, as the flow mapper does for a busy station.
+ * @param hops Number of next hops.
+ * @return The flow stat.
+ */
+static FlowStat CreateBenchmarkFlowStat(uint hops)
+{
+	FlowStat fs(StationID{1}, 10);
+	for (uint i = 2; i <= hops; i++) fs.AppendShare(StationID{static_cast<uint16_t>(i)}, 10 + i * 3, i == hops);
+	return fs;
+}
+
+/**
+ * Pick the next hop for cargo, done for every cargo packet that is loaded or transferred.
+ * @param run The benchmark run.
+ * @param hops Number of next hops.
+ */
+static void BenchFlowStatGetVia(BenchmarkRun &run, uint hops)
+{
+	FlowStat fs = CreateBenchmarkFlowStat(hops);
+	run.Measure([&](uint64_t) {
+		DoNotOptimise(fs.GetVia());
+	});
+}
+
+/**
+ * Change the flow via a next hop, as done when merging the results of a link graph job.
+ * @param run The benchmark run.
+ * @param hops Number of next hops.
+ */
+static void BenchFlowStatChangeShare(BenchmarkRun &run, uint hops)
+{
+	FlowStat fs = CreateBenchmarkFlowStat(hops);
+	run.Measure([&](uint64_t i) {
+		StationID via{static_cast<uint16_t>(1 + i % hops)};
+		/* Alternate between adding and removing flow per hop, so no share drops to zero. */
+		fs.ChangeShare(via, ((i / hops) & 1) != 0 ? -5 : 5);
+	});
+	DoNotOptimise(fs);
+}
+
+static BenchmarkRegistration _bench_flowstat_getvia_4("cargodist/flowstat-getvia-4", [](BenchmarkRun &run) { BenchFlowStatGetVia(run, 4); });
+static BenchmarkRegistration _bench_flowstat_getvia_32("cargodist/flowstat-getvia-32", [](BenchmarkRun &run) { BenchFlowStatGetVia(run, 32); });
+static BenchmarkRegistration _bench_flowstat_changeshare_4("cargodist/flowstat-changeshare-4", [](BenchmarkRun &run) { BenchFlowStatChangeShare(run, 4); });
+static BenchmarkRegistration _bench_flowstat_changeshare_32("cargodist/flowstat-changeshare-32", [](BenchmarkRun &run) { BenchFlowStatChangeShare(run, 32); });
@@ -0,0 +1,145 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bench_linkgraph.cpp Benchmarks of the cargodist link graph solvers. */
+
+#include "../stdafx.h"
+#include "../core/random_func.hpp"
+#include "../map_func.h"
+#include "../settings_type.h"
+#include "../linkgraph/linkgraphjob.h"
+#include "../linkgraph/demands.h"
+#include "../linkgraph/mcf.h"
+#include "../linkgraph/linkgraphschedule.h"
+#include "bench.h"
+
+#include "../safeguards.h"
+
+/**
+ * Create a link graph without stations, with nodes at random places on the map,
+ * each connected in both directions to its nearest neighbours.
+ * @param size Number of nodes.
+ * @return The link graph.
+ */
+static LinkGraph *CreateBenchmarkLinkGraph(uint size)
+{
+	static const uint NEIGHBOURS = 3;
+
+	Map::Allocate(256, 256);
+	_settings_game.linkgraph.recalc_interval = 4;
+	_settings_game.linkgraph.recalc_time = 16;
+	_settings_game.linkgraph.distribution_pax = DT_SYMMETRIC;
+	_settings_game.linkgraph.distribution_mail = DT_SYMMETRIC;
+	_settings_game.linkgraph.distribution_armoured = DT_SYMMETRIC;
+	_settings_game.linkgraph.distribution_default = DT_SYMMETRIC;
+	_settings_game.linkgraph.accuracy = 16;
+	_settings_game.linkgraph.demand_size = 100;
+	_settings_game.linkgraph.demand_distance = 100;
+	_settings_game.linkgraph.short_path_saturation = 80;
+
+	Randomizer random;
+	random.SetSeed(0x4C4B4752);
+
+	assert(LinkGraph::CanAllocateItem());
+	LinkGraph *lg = new LinkGraph(CargoType{0});
+	lg->Init(size);
+	for (NodeID i = 0; i < size; i++) {
+		LinkGraph::BaseNode &node = (*lg)[i];
+		/* The flows are keyed by station, so every node needs its own ID even without stations. */
+		node.station = StationID(i);
+		node.xy = TileXY(random.Next(Map::SizeX()), random.Next(Map::SizeY()));
+		node.supply = 50 + random.Next(450);
+		node.demand = 1;
+	}
+
+	for (NodeID i = 0; i < size; i++) {
+		std::vector<NodeID> nearest;
+		for (NodeID j = 0; j < size; j++) {
+			if (j != i) nearest.push_back(j);
+		}
+		TileIndex xy = (*lg)[i].xy;
+		std::partial_sort(nearest.begin(), nearest.begin() + std::min<size_t>(NEIGHBOURS, nearest.size()), nearest.end(), [lg, xy](NodeID a, NodeID b) {
+			return DistanceManhattan(xy, (*lg)[a].xy) < DistanceManhattan(xy, (*lg)[b].xy);
+		});
+		nearest.resize(std::min<size_t>(NEIGHBOURS, nearest.size()));
+
+		for (NodeID j : nearest) {
+			uint capacity = 100 + random.Next(900);
+			uint32_t travel_time = DistanceManhattan(xy, (*lg)[j].xy) * 10;
+			if (!(*lg)[i].HasEdgeTo(j)) (*lg)[i].AddEdge(j, capacity, 0, travel_time, EdgeUpdateMode::Unrestricted);
+			if (!(*lg)[j].HasEdgeTo(i)) (*lg)[j].AddEdge(i, capacity, 0, travel_time, EdgeUpdateMode::Unrestricted);
+		}
+	}
+	return lg;
+}
+
+/**
+ * Calculate the demands between all nodes, the first step of a link graph job.
+ * @param run The benchmark run.
+ * @param size Number of nodes.
+ */
+static void BenchLinkGraphDemands(BenchmarkRun &run, uint size)
+{
+	LinkGraph *lg = CreateBenchmarkLinkGraph(size);
+	run.Measure([lg](uint64_t) {
+		assert(LinkGraphJob::CanAllocateItem());
+		std::unique_ptr<LinkGraphJob> job(new LinkGraphJob(*lg));
+		job->Init();
+		return job;
+	}, [](std::unique_ptr<LinkGraphJob> &job) {
+		DemandCalculator demands(*job);
+	});
+	delete lg;
+}
+
+/**
+ * Assign the demands to paths with both passes of the multi-commodity flow solver.
+ * The demands are calculated in the setup of every iteration, so only the solver is measured.
+ * @param run The benchmark run.
+ * @param size Number of nodes.
+ */
+static void BenchLinkGraphMCF(BenchmarkRun &run, uint size)
+{
+	LinkGraph *lg = CreateBenchmarkLinkGraph(size);
+	run.Measure([lg](uint64_t) {
+		assert(LinkGraphJob::CanAllocateItem());
+		std::unique_ptr<LinkGraphJob> job(new LinkGraphJob(*lg));
+		job->Init();
+		DemandCalculator demands(*job);
+		return job;
+	}, [](std::unique_ptr<LinkGraphJob> &job) {
+		MCF1stPass first(*job);
+		MCF2ndPass second(*job);
+	});
+	delete lg;
+}
+
+/**
+ * Run a whole link graph job, i.e. all its stages in the order of the schedule: initialisation,
+ * demands, both passes of the multi-commodity flow solver and both flow mappings.
+ * Only joining the job is not measured, as that needs the stations of the nodes.
+ * @param run The benchmark run.
+ * @param size Number of nodes.
+ */
+static void BenchLinkGraphJob(BenchmarkRun &run, uint size)
+{
+	LinkGraph *lg = CreateBenchmarkLinkGraph(size);
+	run.Measure([lg](uint64_t) {
+		assert(LinkGraphJob::CanAllocateItem());
+		return std::unique_ptr<LinkGraphJob>(new LinkGraphJob(*lg));
+	}, [](std::unique_ptr<LinkGraphJob> &job) {
+		LinkGraphSchedule::Run(job.get());
+	});
+	delete lg;
+}
+
+static BenchmarkRegistration _bench_linkgraph_demands_50("cargodist/demands-50", [](BenchmarkRun &run) { BenchLinkGraphDemands(run, 50); });
+static BenchmarkRegistration _bench_linkgraph_demands_400("cargodist/demands-400", [](BenchmarkRun &run) { BenchLinkGraphDemands(run, 400); });
+static BenchmarkRegistration _bench_linkgraph_mcf_50("cargodist/mcf-50", [](BenchmarkRun &run) { BenchLinkGraphMCF(run, 50); });
+static BenchmarkRegistration _bench_linkgraph_mcf_200("cargodist/mcf-200", [](BenchmarkRun &run) { BenchLinkGraphMCF(run, 200); });
+static BenchmarkRegistration _bench_linkgraph_job_50("cargodist/job-50", [](BenchmarkRun &run) { BenchLinkGraphJob(run, 50); });
+static BenchmarkRegistration _bench_linkgraph_job_200("cargodist/job-200", [](BenchmarkRun &run) { BenchLinkGraphJob(run, 200); });
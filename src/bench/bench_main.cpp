@@ -0,0 +1,254 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bench_main.cpp Entry point of openttd_bench, running the micro-benchmarks and reporting them as JSON. */
+
+#include "../stdafx.h"
+#include "../debug.h"
+#include "../error_func.h"
+#include "../fileio_func.h"
+#include "../allocation_tracker.h"
+#include "../core/pool_type.hpp"
+#include "../core/string_consumer.hpp"
+#include "../misc/getoptdata.h"
+#include "bench.h"
+
+#include "../3rdparty/nlohmann/json.hpp"
+
+#include "../safeguards.h"
+
+/**
+ * Register a benchmark.
+ * @param name Name of the benchmark.
+ * @param function The benchmark.
+ */
+BenchmarkRegistration::BenchmarkRegistration(std::string_view name, BenchmarkFunction function) : name(name), function(function)
+{
+	BenchmarkRegistration::GetAll().push_back(this);
+}
+
+/**
+ * Get all registered benchmarks.
+ * @return The benchmarks, in registration order.
+ */
+/* static */ std::vector<const BenchmarkRegistration *> &BenchmarkRegistration::GetAll()
+{
+	static std::vector<const BenchmarkRegistration *> benchmarks;
+	return benchmarks;
+}
+
+/**
+ * Get the allocations done so far. This does not allocate itself, so it can be called around the measured code.
+ * @return The allocation counters of the heap and all pools.
+ */
+/* static */ BenchmarkAllocations BenchmarkAllocations::Now()
+{
+	BenchmarkAllocations allocations;
+#ifdef WITH_ALLOCATION_TRACKING
+	for (AllocationTag tag = AllocationTag::Other; tag != AllocationTag::End; tag = static_cast<AllocationTag>(to_underlying(tag) + 1)) {
+		AllocationCounters counters = GetAllocationCounters(tag);
+		allocations.heap_allocations += counters.allocations;
+		allocations.heap_bytes += counters.bytes_allocated;
+	}
+#endif /* WITH_ALLOCATION_TRACKING */
+	for (const PoolBase *pool : *PoolBase::GetPools()) {
+		allocations.pool_allocations += pool->allocations;
+		allocations.pool_bytes += pool->bytes;
+	}
+	return allocations;
+}
+
+/**
+ * Run a benchmark with a given number of iterations.
+ * @param benchmark The benchmark to run.
+ * @param iterations Number of iterations.
+ * @param[out] skipped Reason why the benchmark was skipped, if it was.
+ * @param[in,out] allocations Allocations of the measured part are added to this.
+ * @return Time taken by the measured part.
+ */
+static std::chrono::nanoseconds RunBenchmark(const BenchmarkRegistration &benchmark, uint64_t iterations, std::string &skipped, BenchmarkAllocations &allocations)
+{
+	BenchmarkRun run(iterations);
+	benchmark.function(run);
+	skipped = run.GetSkipReason();
+	if (!run.IsMeasured() && skipped.empty()) FatalError("Benchmark '{}' did not measure anything", benchmark.name);
+	allocations.AddDifference({}, run.GetAllocations());
+	return run.GetElapsed();
+}
+
+/**
+ * Run a benchmark; first find the number of iterations that takes at least the minimum time, then take samples with that many iterations.
+ * @param benchmark The benchmark to run.
+ * @param min_time Minimum duration of a single sample.
+ * @param samples Number of samples to take.
+ * @return JSON description of the results.
+ */
+static nlohmann::json MeasureBenchmark(const BenchmarkRegistration &benchmark, std::chrono::nanoseconds min_time, uint samples)
+{
+	nlohmann::json result;
+	result["name"] = benchmark.name;
+
+	std::string skipped;
+	uint64_t iterations = 1;
+	for (;;) {
+		BenchmarkAllocations calibration;
+		std::chrono::nanoseconds elapsed = RunBenchmark(benchmark, iterations, skipped, calibration);
+		if (!skipped.empty()) {
+			result["skipped"] = skipped;
+			return result;
+		}
+		if (elapsed >= min_time || iterations >= (1ULL << 40)) break;
+
+		/* Aim a bit over the minimum time, but never grow more than tenfold at once. */
+		uint64_t wanted = elapsed.count() == 0 ? iterations * 10 : iterations * min_time.count() * 5 / 4 / elapsed.count() + 1;
+		iterations = std::clamp<uint64_t>(wanted, iterations + 1, iterations * 10);
+	}
+
+	std::vector<double> per_iteration;
+	BenchmarkAllocations allocations;
+	for (uint i = 0; i < samples; i++) {
+		per_iteration.push_back(static_cast<double>(RunBenchmark(benchmark, iterations, skipped, allocations).count()) / iterations);
+	}
+	std::ranges::sort(per_iteration);
+
+	double mean = 0;
+	for (double v : per_iteration) mean += v;
+	mean /= per_iteration.size();
+
+	result["iterations"] = iterations;
+	result["samples"] = samples;
+	result["ns_per_iteration"] = {
+		{"min", per_iteration.front()},
+		{"median", per_iteration[per_iteration.size() / 2]},
+		{"mean", mean},
+		{"max", per_iteration.back()},
+	};
+
+	const double total_iterations = static_cast<double>(iterations) * samples;
+	nlohmann::json &allocs = result["allocations_per_iteration"];
+#ifdef WITH_ALLOCATION_TRACKING
+	allocs["heap"] = allocations.heap_allocations / total_iterations;
+	allocs["heap_bytes"] = allocations.heap_bytes / total_iterations;
+#endif /* WITH_ALLOCATION_TRACKING */
+	allocs["pool_items"] = allocations.pool_allocations / total_iterations;
+	allocs["pool_bytes_delta"] = allocations.pool_bytes / total_iterations;
+	return result;
+}
+
+static const OptionData _options[] = {
+	{ .type = ODF_NO_VALUE, .id = 'h', .shortname = 'h', .longname = "--help" },
+	{ .type = ODF_NO_VALUE, .id = 'l', .shortname = 'l', .longname = "--list" },
+	{ .type = ODF_HAS_VALUE, .id = 'f', .shortname = 'f', .longname = "--filter" },
+	{ .type = ODF_HAS_VALUE, .id = 'o', .shortname = 'o', .longname = "--output" },
+	{ .type = ODF_HAS_VALUE, .id = 't', .shortname = 't', .longname = "--min-time" },
+	{ .type = ODF_HAS_VALUE, .id = 's', .shortname = 's', .longname = "--samples" },
+};
+
+/**
+ * Entry point of openttd_bench.
+ * @param argc Number of command-line arguments including the program name itself.
+ * @param argv Vector of the command-line arguments.
+ */
+int CDECL main(int argc, char *argv[])
+{
+	std::string_view filter;
+	std::optional<std::string> output_file;
+	std::chrono::milliseconds min_time{100};
+	uint samples = 5;
+
+	std::vector<std::string_view> params;
+	for (int i = 1; i < argc; ++i) params.emplace_back(argv[i]);
+	GetOptData mgo(params, _options);
+	for (;;) {
+		int i = mgo.GetOpt();
+		if (i == -1) break;
+
+		switch (i) {
+			case 'h':
+				fmt::print("openttd_bench\n"
+						"Usage: openttd_bench [options]\n"
+						"with options:\n"
+						"   -h, --help              Print this help message and exit\n"
+						"   -l, --list              List the benchmarks and exit\n"
+						"   -f TEXT, --filter TEXT  Only run benchmarks whose name contains TEXT\n"
+						"   -o FILE, --output FILE  Write the JSON report to FILE instead of stdout\n"
+						"   -t MS, --min-time MS    Minimum duration of a sample in milliseconds (default 100)\n"
+						"   -s N, --samples N       Number of samples per benchmark (default 5)\n");
+				return 0;
+
+			case 'l':
+				for (const BenchmarkRegistration *benchmark : BenchmarkRegistration::GetAll()) fmt::print("{}\n", benchmark->name);
+				return 0;
+
+			case 'f':
+				filter = mgo.opt;
+				break;
+
+			case 'o':
+				output_file = std::string{mgo.opt};
+				break;
+
+			case 't': {
+				auto value = ParseInteger<uint32_t>(mgo.opt);
+				if (!value.has_value()) {
+					fmt::print(stderr, "Invalid minimum time '{}'\n", mgo.opt);
+					return 1;
+				}
+				min_time = std::chrono::milliseconds{*value};
+				break;
+			}
+
+			case 's': {
+				auto value = ParseInteger<uint32_t>(mgo.opt);
+				if (!value.has_value() || *value == 0) {
+					fmt::print(stderr, "Invalid number of samples '{}'\n", mgo.opt);
+					return 1;
+				}
+				samples = *value;
+				break;
+			}
+
+			case -2:
+				fmt::print(stderr, "Invalid arguments\n");
+				return 1;
+		}
+	}
+
+	nlohmann::json report;
+#ifdef WITH_ALLOCATION_TRACKING
+	report["allocation_tracking"] = true;
+#else
+	report["allocation_tracking"] = false;
+#endif /* WITH_ALLOCATION_TRACKING */
+	report["benchmarks"] = nlohmann::json::array();
+	for (const BenchmarkRegistration *benchmark : BenchmarkRegistration::GetAll()) {
+		if (!filter.empty() && benchmark->name.find(filter) == std::string_view::npos) continue;
+
+		fmt::print(stderr, "Running {}...\n", benchmark->name);
+		report["benchmarks"].push_back(MeasureBenchmark(*benchmark, min_time, samples));
+	}
+
+	ProcessMemoryUsage memory = GetProcessMemoryUsage();
+	report["memory"] = {
+		{"resident", memory.resident},
+		{"peak_resident", memory.peak_resident},
+	};
+
+	std::string json = report.dump(4);
+	if (!output_file.has_value()) {
+		fmt::print("{}\n", json);
+		return 0;
+	}
+
+	auto f = FioFOpenFile(*output_file, "wt", Subdirectory::NO_DIRECTORY);
+	if (!f.has_value()) {
+		fmt::print(stderr, "Failed to open '{}' for writing\n", *output_file);
+		return 1;
+	}
+	fmt::print(*f, "{}\n", json);
+	return 0;
+}
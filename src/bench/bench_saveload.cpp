@@ -0,0 +1,70 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bench_saveload.cpp Benchmarks of the deduplicating savegame store. */
+
+#include "../stdafx.h"
+#include "../core/random_func.hpp"
+#include "../saveload/savegame_store.h"
+#include "bench.h"
+
+#include "../safeguards.h"
+
+/**
+ * Create data that looks a bit like a savegame: random, with long runs of the same byte.
+ * @param size Number of bytes.
+ * @return The data.
+ */
+static std::vector<uint8_t> CreateBenchmarkSavegameData(size_t size)
+{
+	Randomizer random;
+	random.SetSeed(0x53415645);
+
+	std::vector<uint8_t> data;
+	data.reserve(size);
+	while (data.size() < size) {
+		uint8_t value = random.Next(256);
+		size_t run = random.Next(4) == 0 ? random.Next(256) : 1;
+		data.insert(data.end(), std::min(run, size - data.size()), value);
+	}
+	return data;
+}
+
+/**
+ * Cut a savegame into blocks, as done for every savegame that is added to the store.
+ * @param run The benchmark run.
+ */
+static void BenchStoreChunker(BenchmarkRun &run)
+{
+	std::vector<uint8_t> data = CreateBenchmarkSavegameData(1024 * 1024);
+	size_t blocks = 0;
+	run.Measure([&](uint64_t) {
+		SavegameStoreChunker chunker([&blocks](std::span<const uint8_t>) { blocks++; });
+		chunker.Write(data);
+		chunker.Finish();
+	});
+	DoNotOptimise(blocks);
+}
+
+/**
+ * Encode and decode a block of the store, as done for every new block of a savegame and when restoring it.
+ * @param run The benchmark run.
+ */
+static void BenchStoreEncodeBlock(BenchmarkRun &run)
+{
+	std::vector<uint8_t> data = CreateBenchmarkSavegameData(SavegameStoreChunker::MAX_BLOCK_SIZE);
+	std::vector<uint8_t> buffer;
+	std::vector<uint8_t> raw;
+	run.Measure([&](uint64_t) {
+		StoreBlockEncoding encoding;
+		std::span<const uint8_t> stored = EncodeStoreBlock(data, buffer, encoding);
+		DoNotOptimise(DecodeStoreBlock(encoding, stored, data.size(), raw));
+	});
+}
+
+static BenchmarkRegistration _bench_saveload_store_chunker("saveload/store-chunker-1M", BenchStoreChunker);
+static BenchmarkRegistration _bench_saveload_store_encode("saveload/store-encode-64K", BenchStoreEncodeBlock);
@@ -0,0 +1,79 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bench_yapf.cpp Benchmarks of the node lists of YAPF. */
+
+#include "../stdafx.h"
+#include "../core/random_func.hpp"
+#include "../pathfinder/yapf/nodelist.hpp"
+#include "../pathfinder/yapf/yapf_node_ship.hpp"
+#include "bench.h"
+
+#include "../safeguards.h"
+
+/**
+ * A* search over a grid with random costs, with the open and closed lists, hash tables and
+ * binary heap of YAPF, but without the map, so only the node list itself is measured.
+ * @param run The benchmark run.
+ * @param size Width and height of the grid.
+ */
+static void BenchYapfNodeList(BenchmarkRun &run, uint size)
+{
+	std::vector<uint8_t> costs(size * size);
+	Randomizer random;
+	random.SetSeed(0x59415046);
+	for (uint8_t &cost : costs) cost = 1 + random.Next(16);
+
+	const TileIndex target{size * size - 1};
+	auto estimate = [size](uint tile) {
+		return static_cast<int>(size - 1 - tile % size + size - 1 - tile / size);
+	};
+
+	run.Measure([&](uint64_t) {
+		CShipNodeListTrackDir nodes;
+
+		auto &origin = nodes.CreateNewNode();
+		origin.Set(nullptr, TileIndex{0}, TRACKDIR_X_NE, false);
+		origin.estimate = estimate(0);
+		nodes.InsertOpenNode(origin);
+
+		while (auto *node = nodes.PopBestOpenNode()) {
+			nodes.InsertClosedNode(*node);
+			if (node->GetTile() == target) break;
+
+			uint tile = node->GetTile().base();
+			uint x = tile % size;
+			uint y = tile / size;
+			for (uint next : { x > 0 ? tile - 1 : tile, x < size - 1 ? tile + 1 : tile, y > 0 ? tile - size : tile, y < size - 1 ? tile + size : tile }) {
+				if (next == tile) continue;
+
+				auto &follower = nodes.CreateNewNode();
+				follower.Set(node, TileIndex{next}, TRACKDIR_X_NE, false);
+				follower.cost = node->cost + costs[next];
+				follower.estimate = follower.cost + estimate(next);
+
+				/* Same as CYapfBaseT::AddNewNode. */
+				if (nodes.FindClosedNode(follower.GetKey()) != nullptr) continue;
+				auto *open_node = nodes.FindOpenNode(follower.GetKey());
+				if (open_node != nullptr) {
+					if (follower.GetCostEstimate() < open_node->GetCostEstimate()) {
+						nodes.PopOpenNode(follower.GetKey());
+						*open_node = follower;
+						nodes.InsertOpenNode(*open_node);
+					}
+					continue;
+				}
+				nodes.InsertOpenNode(follower);
+			}
+		}
+
+		DoNotOptimise(nodes.ClosedCount());
+	});
+}
+
+static BenchmarkRegistration _bench_yapf_nodelist_64("yapf/nodelist-64x64", [](BenchmarkRun &run) { BenchYapfNodeList(run, 64); });
+static BenchmarkRegistration _bench_yapf_nodelist_256("yapf/nodelist-256x256", [](BenchmarkRun &run) { BenchYapfNodeList(run, 256); });
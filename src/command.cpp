@@ -24,6 +24,7 @@
 #include "signal_func.h"
 #include "core/backup_type.hpp"
 #include "object_base.h"
+#include "tick_watchdog.h"
 #include "autoreplace_cmd.h"
 #include "company_cmd.h"
 #include "depot_cmd.h"
@@ -342,6 +343,7 @@ std::tuple<bool, bool, bool> CommandHelperBase::InternalExecuteValidateTestAndPr
 CommandCost CommandHelperBase::InternalExecuteProcessResult(Commands cmd, CommandFlags cmd_flags, [[maybe_unused]] const CommandCost &res_test, const CommandCost &res_exec, Money extra_cash, TileIndex tile, Backup<CompanyID> &cur_company)
 {
 	BasePersistentStorageArray::SwitchMode(PSM_LEAVE_COMMAND);
+	if (TickWatchdog::IsEnabled()) TickWatchdog::RecordCommand(cmd, _current_company, tile);
 
 	if (cmd == CMD_COMPANY_CTRL) {
 		cur_company.Trash();
@@ -11,9 +11,11 @@
 #include "core/string_consumer.hpp"
 #include "console_internal.h"
 #include "debug.h"
+#include "debug_log.h"
 #include "engine_func.h"
 #include "landscape.h"
 #include "saveload/saveload.h"
+#include "saveload/savegame_store.h"
 #include "network/core/network_game_info.h"
 #include "network/network.h"
 #include "network/network_func.h"
@@ -37,6 +39,14 @@
 #include "ai/ai_config.hpp"
 #include "newgrf.h"
 #include "newgrf_profiling.h"
+#include "scope_profiler.h"
+#include "allocation_tracker.h"
+#include "tick_cost.h"
+#include "pathfinder/yapf/yapf_stats.h"
+#include "memory_stats.h"
+#include "tick_watchdog.h"
+#include "group.h"
+#include "vehicle_base.h"
 #include "console_func.h"
 #include "engine_base.h"
 #include "road.h"
@@ -435,6 +445,71 @@ static bool ConSave(std::span<std::string_view> argv)
 	return false;
 }
 
+/**
+ * Save the map into the deduplicating savegame store.
+ * param name the name to store the map under.
+ * @return True when help was displayed or the map attempted to be stored.
+ */
+static bool ConStoreSave(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Save the current game into the savegame store, sharing unchanged parts with the other stored games. Usage: 'store_save <name>'.");
+		return true;
+	}
+
+	if (argv.size() == 2) {
+		std::string name{argv[1]};
+		IConsolePrint(CC_DEFAULT, "Storing map...");
+
+		if (SaveToStore(name, false) != SL_OK) {
+			IConsolePrint(CC_ERROR, "Storing map failed.");
+		} else {
+			SavegameStoreStats stats = GetLastSavegameStoreStats();
+			IConsolePrint(CC_INFO, "Map stored as '{}': {} KiB, of which {:.1f}% was already stored; wrote {} KiB, store is now {} KiB.",
+					name, stats.raw_bytes / 1024, stats.DedupRatio() * 100, stats.written_bytes / 1024, stats.store_bytes / 1024);
+		}
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * List the games in the savegame store, or restore one of them to a savegame file.
+ * param name the name of the stored game.
+ * param filename the savegame file to write, without extension.
+ * @return True when help was displayed or the game attempted to be restored.
+ */
+static bool ConRestoreSave(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Restore a game from the savegame store into a savegame. Usage: 'restore_save [<name> [<filename>]]'.");
+		IConsolePrint(CC_HELP, "Without a name the stored games are listed. The filename defaults to the name.");
+		return true;
+	}
+
+	if (argv.size() == 1) {
+		for (const std::string &name : GetStoredSavegames()) {
+			IConsolePrint(CC_DEFAULT, "{}", name);
+		}
+		return true;
+	}
+
+	if (argv.size() <= 3) {
+		std::string name{argv[1]};
+		std::string filename = fmt::format("{}.sav", argv.size() == 3 ? argv[2] : argv[1]);
+
+		if (!RestoreFromStore(name, filename)) {
+			IConsolePrint(CC_ERROR, "Restoring '{}' failed.", name);
+		} else {
+			IConsolePrint(CC_INFO, "Restored '{}' to '{}'.", name, filename);
+		}
+		return true;
+	}
+
+	return false;
+}
+
 /**
  * Explicitly save the configuration.
  * @return True.
@@ -1834,6 +1909,87 @@ static bool ConDebugLevel(std::span<std::string_view> argv)
 	return true;
 }
 
+static bool ConDebugLog(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Configure how debug messages are written. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'debug_log':");
+		IConsolePrint(CC_HELP, "  Show the current configuration and statistics.");
+		IConsolePrint(CC_HELP, "Usage: 'debug_log async on|off':");
+		IConsolePrint(CC_HELP, "  Write debug messages on a separate thread, so logging never waits for output.");
+		IConsolePrint(CC_HELP, "Usage: 'debug_log file <filename> [text|binary]' or 'debug_log file off':");
+		IConsolePrint(CC_HELP, "  Write debug messages with their tick and company to a file in the autosave directory instead of to the standard error; implies 'async on'.");
+		IConsolePrint(CC_HELP, "Usage: 'debug_log rate <category> <messages per second>':");
+		IConsolePrint(CC_HELP, "  Limit the number of messages of a category; 0 removes the limit. Errors are never limited.");
+		return true;
+	}
+
+	/* "async" sub-command */
+	if (argv.size() == 3 && StrStartsWithIgnoreCase(argv[1], "as")) {
+		if (StrEqualsIgnoreCase(argv[2], "on")) {
+			if (!StartDebugLog()) IConsolePrint(CC_ERROR, "Could not start the debug log thread.");
+		} else if (StrEqualsIgnoreCase(argv[2], "off")) {
+			StopDebugLog();
+		} else {
+			return false;
+		}
+		return true;
+	}
+
+	/* "file" sub-command */
+	if ((argv.size() == 3 || argv.size() == 4) && StrStartsWithIgnoreCase(argv[1], "fi")) {
+		if (argv.size() == 3 && StrEqualsIgnoreCase(argv[2], "off")) {
+			CloseDebugLogFile();
+			return true;
+		}
+
+		DebugLogFormat format = DebugLogFormat::Text;
+		if (argv.size() == 4) {
+			if (StrStartsWithIgnoreCase(argv[3], "b")) {
+				format = DebugLogFormat::Binary;
+			} else if (!StrStartsWithIgnoreCase(argv[3], "t")) {
+				return false;
+			}
+		}
+
+		if (!IsPlainFilename(argv[2])) {
+			IConsolePrint(CC_ERROR, "'{}' is not a plain file name.", argv[2]);
+			return true;
+		}
+		if (!OpenDebugLogFile(argv[2], format)) IConsolePrint(CC_ERROR, "Could not open debug log file '{}'.", argv[2]);
+		return true;
+	}
+
+	/* "rate" sub-command */
+	if (argv.size() == 4 && StrStartsWithIgnoreCase(argv[1], "ra")) {
+		auto limit = ParseType<uint32_t>(argv[3]);
+		if (!limit.has_value()) {
+			IConsolePrint(CC_ERROR, "'{}' is not a valid number of messages.", argv[3]);
+			return true;
+		}
+		if (!SetDebugRateLimit(argv[2], *limit)) IConsolePrint(CC_ERROR, "Unknown debug category '{}'.", argv[2]);
+		return true;
+	}
+
+	if (argv.size() != 1) return false;
+
+	DebugLogStats stats = GetDebugLogStats();
+	IConsolePrint(CC_INFO, "Asynchronous: {}; {} messages queued, {} dropped.", IsDebugLogRunning() ? "on" : "off", stats.queued, stats.dropped);
+
+	std::optional<std::string> filename = GetDebugLogFileName();
+	if (filename.has_value()) {
+		IConsolePrint(CC_INFO, "Log file: {}", *filename);
+	} else {
+		IConsolePrint(CC_INFO, "Log file: none");
+	}
+
+	for (const DebugRateLimitInfo &info : GetDebugRateLimits()) {
+		if (info.limit == 0 && info.suppressed == 0) continue;
+		IConsolePrint(CC_INFO, "Rate limit of {}: {} per second; {} messages suppressed.", info.category, info.limit, info.suppressed);
+	}
+	return true;
+}
+
 static bool ConExit(std::span<std::string_view> argv)
 {
 	if (argv.empty()) {
@@ -2646,6 +2802,356 @@ static bool ConNewGRFProfile(std::span<std::string_view> argv)
 	return false;
 }
 
+static bool ConProfile(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Collect nested timings of the game loop, drawing, link graph jobs and savegames. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'profile start':");
+		IConsolePrint(CC_HELP, "  Begin collecting timings. Only the most recent {} timings per thread are kept.", ScopeProfiler::EVENTS_PER_THREAD);
+		IConsolePrint(CC_HELP, "Usage: 'profile stop':");
+		IConsolePrint(CC_HELP, "  End collecting timings; the collected timings are kept.");
+		IConsolePrint(CC_HELP, "Usage: 'profile clear':");
+		IConsolePrint(CC_HELP, "  Discard all collected timings.");
+		IConsolePrint(CC_HELP, "Usage: 'profile dump [<filename>]':");
+		IConsolePrint(CC_HELP, "  Write the collected timings as Chrome trace to a file in the autosave directory, to be opened in chrome://tracing or Perfetto.");
+		return true;
+	}
+
+	if (argv.size() < 2) {
+		IConsolePrint(CC_INFO, "Profiler is {}.", ScopeProfiler::IsRunning() ? "running" : "not running");
+		return true;
+	}
+
+	/* "start" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sta")) {
+		ScopeProfiler::Start();
+		IConsolePrint(CC_DEBUG, "Started profiling.");
+		return true;
+	}
+
+	/* "stop" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "sto")) {
+		ScopeProfiler::Stop();
+		IConsolePrint(CC_DEBUG, "Stopped profiling.");
+		return true;
+	}
+
+	/* "clear" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "cle")) {
+		ScopeProfiler::Clear();
+		return true;
+	}
+
+	/* "dump" sub-command */
+	if (StrStartsWithIgnoreCase(argv[1], "dum")) {
+		std::string filename = argv.size() >= 3 ? std::string{argv[2]} : fmt::format("trace-{:%Y%m%d-%H%M%S}.json", fmt::localtime(time(nullptr)));
+		if (!IsPlainFilename(filename)) {
+			IConsolePrint(CC_ERROR, "'{}' is not a plain file name.", filename);
+			return true;
+		}
+		if (!ScopeProfiler::WriteChromeTrace(filename)) {
+			IConsolePrint(CC_ERROR, "Failed to open '{}' for writing.", filename);
+			return true;
+		}
+		IConsolePrint(CC_DEBUG, "Wrote profile to '{}' in the autosave directory.", filename);
+		return true;
+	}
+
+	return false;
+}
+
+static bool ConTickCost(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show on behalf of which companies, vehicles and groups the game loop time is spent. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'tickcost':");
+		IConsolePrint(CC_HELP, "  Show the average time per tick of the last {} ticks, measured in one of every {} ticks.", TickCostAccounting::PERIOD, TickCostAccounting::SAMPLE_INTERVAL);
+		IConsolePrint(CC_HELP, "Usage: 'tickcost throttle <microseconds>':");
+		IConsolePrint(CC_HELP, "  Only run AIs using more script time per tick every other tick; 0 disables throttling.");
+		return true;
+	}
+
+	/* "throttle" sub-command */
+	if (argv.size() >= 2) {
+		if (!StrStartsWithIgnoreCase(argv[1], "thr") || argv.size() != 3) return false;
+		auto budget = ParseType<uint32_t>(argv[2]);
+		if (!budget.has_value()) {
+			IConsolePrint(CC_ERROR, "'{}' is not a valid number of microseconds.", argv[2]);
+			return true;
+		}
+		TickCostAccounting::SetThrottleBudget(*budget * 1000ULL);
+		if (*budget == 0) {
+			IConsolePrint(CC_DEBUG, "Disabled throttling of AIs.");
+		} else {
+			IConsolePrint(CC_DEBUG, "Throttling AIs using more than {} us script time per tick.", *budget);
+		}
+		return true;
+	}
+
+	const TickCostReport &report = TickCostAccounting::GetReport();
+	if (report.sampled_ticks == 0) {
+		IConsolePrint(CC_ERROR, "No game loop costs measured yet.");
+		return true;
+	}
+
+	auto print_costs = [&report](size_t index, std::string_view name) {
+		IConsolePrint(CC_INFO, "  {:<24} trains {:>7} us, road {:>7} us, ships {:>7} us, aircraft {:>7} us, loading {:>7} us, pathfinder {:>7} us, script {:>7} us, total {:>7} us",
+				name, report.GetAverage(index, TickCostType::Trains) / 1000, report.GetAverage(index, TickCostType::RoadVehicles) / 1000,
+				report.GetAverage(index, TickCostType::Ships) / 1000, report.GetAverage(index, TickCostType::Aircraft) / 1000,
+				report.GetAverage(index, TickCostType::Loading) / 1000, report.GetAverage(index, TickCostType::Pathfinder) / 1000,
+				report.GetAverage(index, TickCostType::Script) / 1000, report.companies[index].GetTotal() / report.sampled_ticks / 1000);
+	};
+
+	IConsolePrint(CC_INFO, "Average time per tick, measured in {} of the last {} ticks:", report.sampled_ticks, TickCostAccounting::PERIOD);
+	for (const Company *c : Company::Iterate()) print_costs(c->index.base(), GetString(STR_COMPANY_NAME, c->index));
+	print_costs(TickCostReport::OTHER, "other");
+
+	IConsolePrint(CC_INFO, "Most expensive vehicles:");
+	for (const TickCostVehicle &entry : report.top_vehicles) {
+		const Vehicle *v = Vehicle::GetIfValid(entry.id);
+		if (v == nullptr || v->owner != entry.owner) continue;
+		IConsolePrint(CC_INFO, "  {:>7} us  #{} {} ({})", entry.ns / report.sampled_ticks / 1000, v->index, GetString(STR_VEHICLE_NAME, v->index), GetString(STR_COMPANY_NAME, v->owner));
+	}
+
+	IConsolePrint(CC_INFO, "Most expensive groups:");
+	for (const TickCostGroup &entry : report.top_groups) {
+		if (entry.id != DEFAULT_GROUP && !Group::IsValidID(entry.id)) continue;
+		std::string name = entry.id == DEFAULT_GROUP ? "ungrouped" : GetString(STR_GROUP_NAME, entry.id);
+		IConsolePrint(CC_INFO, "  {:>7} us  {} ({})", entry.ns / report.sampled_ticks / 1000, name, GetString(STR_COMPANY_NAME, entry.owner));
+	}
+	if (TickCostAccounting::GetThrottleBudget() != 0) {
+		IConsolePrint(CC_INFO, "Throttling AIs using more than {} us script time per tick.", TickCostAccounting::GetThrottleBudget() / 1000);
+	}
+	return true;
+}
+
+static bool ConYapfStats(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show statistics of the pathfinder searches per vehicle type. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'yapf_stats':");
+		IConsolePrint(CC_HELP, "  Show the number of searches, expanded nodes, cache hit ratio and search times.");
+		IConsolePrint(CC_HELP, "Usage: 'yapf_stats reset':");
+		IConsolePrint(CC_HELP, "  Reset the statistics and forget the slow searches.");
+		IConsolePrint(CC_HELP, "Usage: 'yapf_stats slow [<microseconds>]':");
+		IConsolePrint(CC_HELP, "  Show the last slow searches, or set the duration above which a search is logged as slow.");
+		return true;
+	}
+
+	/* "reset" sub-command */
+	if (argv.size() >= 2 && StrStartsWithIgnoreCase(argv[1], "res")) {
+		ResetYapfStats();
+		IConsolePrint(CC_DEBUG, "Reset pathfinder statistics.");
+		return true;
+	}
+
+	/* "slow" sub-command */
+	if (argv.size() >= 2 && StrStartsWithIgnoreCase(argv[1], "slo")) {
+		if (argv.size() >= 3) {
+			auto threshold = ParseType<uint32_t>(argv[2]);
+			if (!threshold.has_value()) {
+				IConsolePrint(CC_ERROR, "'{}' is not a valid number of microseconds.", argv[2]);
+				return true;
+			}
+			SetYapfSlowSearchThreshold(*threshold * 1000ULL);
+			IConsolePrint(CC_DEBUG, "Logging searches taking {} us or more.", *threshold);
+			return true;
+		}
+
+		IConsolePrint(CC_INFO, "Searches taking {} us or more:", GetYapfSlowSearchThreshold() / 1000);
+		for (const YapfSlowSearch &s : GetYapfSlowSearches()) {
+			IConsolePrint(CC_INFO, "  tick {}: vehicle {} ({}) from {}x{} to {}x{}: {} nodes{} in {} us",
+					s.tick, s.vehicle, Vehicle::IsValidID(s.vehicle) ? GetString(STR_VEHICLE_NAME, s.vehicle) : "sold",
+					TileX(s.origin), TileY(s.origin), TileX(s.destination), TileY(s.destination),
+					s.nodes, s.max_nodes_hit ? " (gave up)" : "", s.ns / 1000);
+		}
+		return true;
+	}
+
+	if (argv.size() >= 2) return false;
+
+	static const std::array<std::string_view, VEH_COMPANY_END> type_names = {"trains", "road vehicles", "ships", "aircraft"};
+	uint64_t ticks = std::max<uint64_t>(1, TimerGameTick::counter - std::min(TimerGameTick::counter, GetYapfStatsStart()));
+	for (VehicleType type : {VEH_TRAIN, VEH_ROAD, VEH_SHIP}) {
+		const YapfStats &stats = GetYapfStats(type);
+		if (stats.searches == 0) {
+			IConsolePrint(CC_INFO, "{}: no searches", type_names[type]);
+			continue;
+		}
+
+		uint64_t costs = stats.cache_hits + stats.cost_calcs;
+		IConsolePrint(CC_INFO, "{}: {} searches, {:.2f} per tick, {} nodes per search, {} gave up, cache hit ratio {:.1f}%, {} us per search",
+				type_names[type], stats.searches, static_cast<double>(stats.searches) / ticks, stats.nodes / stats.searches, stats.max_nodes_hit,
+				costs == 0 ? 0.0 : 100.0 * stats.cache_hits / costs, stats.ns / stats.searches / 1000);
+
+		std::string histogram;
+		for (size_t i = 0; i < YapfStats::LATENCY_BUCKETS; i++) {
+			if (stats.latency[i] == 0) continue;
+			if (i + 1 == YapfStats::LATENCY_BUCKETS) {
+				format_append(histogram, " >={}us:{}", 1ULL << (i - 1), stats.latency[i]);
+			} else {
+				format_append(histogram, " <{}us:{}", 1ULL << i, stats.latency[i]);
+			}
+		}
+		IConsolePrint(CC_INFO, "  search times:{}", histogram);
+	}
+	return true;
+}
+
+static bool ConWatchdog(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Capture the details of game ticks that take too long. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'watchdog':");
+		IConsolePrint(CC_HELP, "  Show the budget and how many slow ticks were captured.");
+		IConsolePrint(CC_HELP, "Usage: 'watchdog budget <microseconds>':");
+		IConsolePrint(CC_HELP, "  Capture ticks taking longer than this; 0 disables the watchdog. Enabling it starts the profiler.");
+		IConsolePrint(CC_HELP, "Usage: 'watchdog interval <seconds>':");
+		IConsolePrint(CC_HELP, "  Set the minimum time between two captures.");
+		IConsolePrint(CC_HELP, "Captures are written to the autosave directory; the last {} are kept.", TickWatchdog::MAX_CAPTURE_FILES);
+		return true;
+	}
+
+	if (argv.size() >= 2) {
+		if (argv.size() != 3) return false;
+		auto value = ParseType<uint32_t>(argv[2]);
+
+		/* "budget" sub-command */
+		if (StrStartsWithIgnoreCase(argv[1], "bud")) {
+			if (!value.has_value()) {
+				IConsolePrint(CC_ERROR, "'{}' is not a valid number of microseconds.", argv[2]);
+				return true;
+			}
+			TickWatchdog::SetBudget(*value * 1000ULL);
+			if (*value == 0) {
+				IConsolePrint(CC_DEBUG, "Disabled the tick watchdog.");
+			} else {
+				IConsolePrint(CC_DEBUG, "Capturing ticks taking more than {} us.", *value);
+			}
+			return true;
+		}
+
+		/* "interval" sub-command */
+		if (StrStartsWithIgnoreCase(argv[1], "int")) {
+			if (!value.has_value()) {
+				IConsolePrint(CC_ERROR, "'{}' is not a valid number of seconds.", argv[2]);
+				return true;
+			}
+			TickWatchdog::SetMinInterval(std::chrono::seconds(*value));
+			IConsolePrint(CC_DEBUG, "Capturing at most one tick every {} seconds.", *value);
+			return true;
+		}
+
+		return false;
+	}
+
+	if (!TickWatchdog::IsEnabled()) {
+		IConsolePrint(CC_INFO, "Tick watchdog is disabled.");
+	} else {
+		IConsolePrint(CC_INFO, "Capturing ticks taking more than {} us, at most one every {} seconds.", TickWatchdog::GetBudget() / 1000, TickWatchdog::GetMinInterval().count());
+	}
+	TickWatchdogStats stats = TickWatchdog::GetStats();
+	IConsolePrint(CC_INFO, "{} slow ticks, {} captured, {} not captured due to the interval.", stats.slow_ticks, stats.captures, stats.suppressed);
+	if (!stats.last_capture.empty()) IConsolePrint(CC_INFO, "Last capture: '{}'.", stats.last_capture);
+	return true;
+}
+
+static bool ConMemory(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show the memory used by the pools, caches and scripts. Usage: 'memory [window]'.");
+		IConsolePrint(CC_HELP, "  'window' opens the memory window instead.");
+		return true;
+	}
+
+	if (argv.size() >= 2) {
+		if (!StrStartsWithIgnoreCase(argv[1], "win")) return false;
+		if (_network_dedicated) {
+			IConsolePrint(CC_ERROR, "Can not open memory window on a dedicated server.");
+			return false;
+		}
+		ShowMemoryWindow();
+		return true;
+	}
+
+	MemoryStats stats = GetMemoryStats();
+	std::ranges::sort(stats.pools, std::greater{}, &PoolMemoryStats::bytes);
+
+	IConsolePrint(CC_INFO, "Pools (growth over {} ticks):", stats.history_ticks);
+	for (const PoolMemoryStats &pool : stats.pools) {
+		IConsolePrint(CC_INFO, "  {:<24} {:>8} items, {:>8} used range, {:>8} capacity, {:>8} KiB, {:+} items",
+				pool.name, pool.items, pool.used_range, pool.capacity, pool.bytes / 1024, pool.growth);
+	}
+	IConsolePrint(CC_INFO, "Sprite cache: {} KiB of {} KiB", stats.sprite_cache_used / 1024, stats.sprite_cache_limit / 1024);
+	IConsolePrint(CC_INFO, "Sound effects: {} KiB", stats.sound_bytes / 1024);
+	IConsolePrint(CC_INFO, "Scripts: {} KiB by AIs, {} KiB by the game script", stats.ai_bytes / 1024, stats.game_script_bytes / 1024);
+	IConsolePrint(CC_INFO, "Link graph jobs: {} running, about {} KiB", stats.link_graph_jobs, stats.link_graph_job_bytes / 1024);
+	if (stats.process.resident != 0) {
+		IConsolePrint(CC_INFO, "Process: {} KiB resident, {} KiB peak", stats.process.resident / 1024, stats.process.peak_resident / 1024);
+	}
+	return true;
+}
+
+#ifdef WITH_ALLOCATION_TRACKING
+/** Snapshot the 'allocations diff' command compares against. */
+static std::optional<AllocationSnapshot> _allocation_baseline;
+
+static bool ConAllocations(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show the heap allocations per subsystem and the items per pool. Sub-commands can be abbreviated.");
+		IConsolePrint(CC_HELP, "Usage: 'allocations':");
+		IConsolePrint(CC_HELP, "  Show the allocations since the start of the game.");
+		IConsolePrint(CC_HELP, "Usage: 'allocations snapshot':");
+		IConsolePrint(CC_HELP, "  Remember the current allocations, to compare against later.");
+		IConsolePrint(CC_HELP, "Usage: 'allocations diff':");
+		IConsolePrint(CC_HELP, "  Show the allocations since the last snapshot.");
+		return true;
+	}
+
+	AllocationSnapshot current = TakeAllocationSnapshot();
+
+	/* "snapshot" sub-command */
+	if (argv.size() >= 2 && StrStartsWithIgnoreCase(argv[1], "sna")) {
+		_allocation_baseline = std::move(current);
+		IConsolePrint(CC_DEBUG, "Took allocation snapshot.");
+		return true;
+	}
+
+	AllocationSnapshot baseline;
+	if (argv.size() >= 2) {
+		/* "diff" sub-command */
+		if (!StrStartsWithIgnoreCase(argv[1], "dif")) return false;
+		if (!_allocation_baseline.has_value()) {
+			IConsolePrint(CC_ERROR, "No allocation snapshot taken yet.");
+			return true;
+		}
+		baseline = *_allocation_baseline;
+	}
+
+	IConsolePrint(CC_INFO, "Heap allocations per subsystem:");
+	for (AllocationTag tag = AllocationTag::Other; tag != AllocationTag::End; tag = static_cast<AllocationTag>(to_underlying(tag) + 1)) {
+		const AllocationCounters &now = current.tags[to_underlying(tag)];
+		const AllocationCounters &then = baseline.tags[to_underlying(tag)];
+		IConsolePrint(CC_INFO, "  {:<12} {:>10} allocs, {:>10} frees, live {:>+9} allocs, {:>+13} bytes",
+				GetAllocationTagName(tag), now.allocations - then.allocations, now.frees - then.frees,
+				static_cast<int64_t>(now.GetLiveAllocations() - then.GetLiveAllocations()),
+				static_cast<int64_t>(now.GetLiveBytes() - then.GetLiveBytes()));
+	}
+
+	IConsolePrint(CC_INFO, "Pools:");
+	for (size_t i = 0; i < current.pools.size(); i++) {
+		const PoolAllocationCounters &now = current.pools[i];
+		PoolAllocationCounters then{};
+		if (i < baseline.pools.size()) then = baseline.pools[i];
+		IConsolePrint(CC_INFO, "  {:<28} {:>7} / {:>7} items, {:>10} allocs, {:>10} frees, {:>+13} bytes",
+				now.name, now.items, now.capacity, now.allocations - then.allocations, now.frees - then.frees,
+				static_cast<int64_t>(now.bytes - then.bytes));
+	}
+	return true;
+}
+#endif /* WITH_ALLOCATION_TRACKING */
+
 #ifdef _DEBUG
 /******************
  *  debug commands
@@ -2869,6 +3375,7 @@ static bool ConDumpInfo(std::span<std::string_view> argv)
 void IConsoleStdLibRegister()
 {
 	IConsole::CmdRegister("debug_level",             ConDebugLevel);
+	IConsole::CmdRegister("debug_log",               ConDebugLog);
 	IConsole::CmdRegister("echo",                    ConEcho);
 	IConsole::CmdRegister("echoc",                   ConEchoC);
 	IConsole::CmdRegister("exec",                    ConExec);
@@ -2900,6 +3407,8 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("load_heightmap",          ConLoadHeightmap);
 	IConsole::CmdRegister("rm",                      ConRemove);
 	IConsole::CmdRegister("save",                    ConSave);
+	IConsole::CmdRegister("store_save",              ConStoreSave);
+	IConsole::CmdRegister("restore_save",            ConRestoreSave);
 	IConsole::CmdRegister("saveconfig",              ConSaveConfig);
 	IConsole::CmdRegister("ls",                      ConListFiles);
 	IConsole::CmdRegister("list_saves",              ConListFiles);
@@ -3006,6 +3515,14 @@ void IConsoleStdLibRegister()
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
 	IConsole::CmdRegister("newgrf_profile",          ConNewGRFProfile,    ConHookNewGRFDeveloperTool);
+	IConsole::CmdRegister("profile",                 ConProfile);
+	IConsole::CmdRegister("tickcost",                ConTickCost);
+	IConsole::CmdRegister("yapf_stats",              ConYapfStats);
+	IConsole::CmdRegister("watchdog",                ConWatchdog);
+	IConsole::CmdRegister("memory",                  ConMemory);
+#ifdef WITH_ALLOCATION_TRACKING
+	IConsole::CmdRegister("allocations",             ConAllocations);
+#endif
 
 	IConsole::CmdRegister("dump_info",               ConDumpInfo);
 }
@@ -269,6 +269,48 @@ class Kdtree {
 		return best;
 	}
 
+	/**
+	 * Search a sub-tree for the element nearest to a given point that passes a filter.
+	 * @param xy Point to search around.
+	 * @param node_idx Root of the sub-tree.
+	 * @param level Level of the root of the sub-tree.
+	 * @param limit Maximum distance of elements to consider.
+	 * @param filter Predicate elements must pass.
+	 * @param metric Distance function taking the absolute differences of both coordinates.
+	 * @param[in,out] best Best element found so far.
+	 */
+	template <typename Filter, typename Metric>
+	void FindNearestIfRecursive(CoordT xy[2], size_t node_idx, int level, DistT limit, const Filter &filter, const Metric &metric, std::optional<node_distance> &best) const
+	{
+		/* Dimension index of current level */
+		int dim = level % 2;
+		/* Node reference */
+		const node &n = this->nodes[node_idx];
+
+		/* Coordinate of element splitting at this node */
+		CoordT c = TxyFunc()(n.element, dim);
+		/* This node's distance to target */
+		DistT thisdist = metric(abs((DistT)TxyFunc()(n.element, 0) - (DistT)xy[0]), abs((DistT)TxyFunc()(n.element, 1) - (DistT)xy[1]));
+		if (thisdist <= limit && (!best.has_value() || thisdist < best->second || (thisdist == best->second && n.element < best->first)) && filter(n.element)) {
+			best = std::make_pair(n.element, thisdist);
+		}
+
+		/* Visit the side of the split containing the target first. */
+		size_t next = (xy[dim] < c) ? n.left : n.right;
+		if (next != INVALID_NODE) this->FindNearestIfRecursive(xy, next, level + 1, limit, filter, metric, best);
+
+		/* Elements on the other side are at least as far away as the splitting line. Equal distances
+		 * need to be visited too, as an element comparing smaller might be found there. */
+		size_t opposite = (xy[dim] >= c) ? n.left : n.right;
+		if (opposite != INVALID_NODE) {
+			DistT split = abs((DistT)xy[dim] - (DistT)c);
+			DistT bound = (dim == 0) ? metric(split, 0) : metric(0, split);
+			if (bound <= limit && (!best.has_value() || bound <= best->second)) {
+				this->FindNearestIfRecursive(xy, opposite, level + 1, limit, filter, metric, best);
+			}
+		}
+	}
+
 	template <typename Outputter>
 	void FindContainedRecursive(CoordT p1[2], CoordT p2[2], size_t node_idx, int level, const Outputter &outputter) const
 	{
@@ -444,6 +486,31 @@ public:
 		return this->FindNearestRecursive(xy, this->root, 0).first;
 	}
 
+	/**
+	 * Find the element closest to given coordinate that passes a filter and is within a maximum distance.
+	 * The distance is calculated by a metric from the absolute coordinate differences, so this is not
+	 * limited to Manhattan distances; the metric must not decrease when either difference increases.
+	 * For multiple elements with the same distance, the one comparing smaller with
+	 * a less-than comparison is chosen.
+	 * @param x First coordinate of the point to search around.
+	 * @param y Second coordinate of the point to search around.
+	 * @param limit Maximum distance, according to the metric, of elements to consider.
+	 * @param filter Predicate taking an element, returning whether it may be chosen.
+	 * @param metric Function taking the absolute differences of both coordinates, returning the distance.
+	 * @return The nearest element passing the filter, if any.
+	 */
+	template <typename Filter, typename Metric>
+	std::optional<T> FindNearestIf(CoordT x, CoordT y, DistT limit, const Filter &filter, const Metric &metric) const
+	{
+		if (this->Count() == 0) return std::nullopt;
+
+		CoordT xy[2] = { x, y };
+		std::optional<node_distance> best;
+		this->FindNearestIfRecursive(xy, this->root, 0, limit, filter, metric, best);
+		if (!best.has_value()) return std::nullopt;
+		return best->first;
+	}
+
 	/**
 	 * Find all items contained within the given rectangle.
 	 * @note Start coordinates are inclusive, end coordinates are exclusive. x1<x2 && y1<y2 is a precondition.
@@ -0,0 +1,97 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file mpsc_ring_buffer.hpp Bounded lock-free queue for many producers and a single consumer. */
+
+#ifndef MPSC_RING_BUFFER_HPP
+#define MPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <bit>
+
+/**
+ * Bounded lock-free queue for many producers and a single consumer.
+ *
+ * Every slot has a sequence number that tells whose turn it is: a producer may fill
+ * the slot at position \c pos when the sequence is \c pos, the consumer may empty it
+ * when the sequence is \c pos + 1. Producers claim positions by advancing the head;
+ * items are consumed in the order their positions were claimed. Producers never
+ * wait: when the queue is full, pushing fails.
+ *
+ * @tparam T Type of the items; must be default constructible and movable.
+ * @tparam Tcapacity Number of items the queue can hold; must be a power of two.
+ */
+template <typename T, size_t Tcapacity>
+class MPSCRingBuffer {
+	static_assert(Tcapacity >= 2 && std::has_single_bit(Tcapacity), "capacity must be a power of two");
+
+	/** A single slot of the queue. */
+	struct Slot {
+		std::atomic<size_t> sequence; ///< Position the slot is ready for; see the class documentation.
+		T value; ///< The item in the slot.
+	};
+
+	std::unique_ptr<Slot[]> slots; ///< The slots of the queue.
+	alignas(64) std::atomic<size_t> head = 0; ///< Next position to be claimed by a producer.
+	alignas(64) size_t tail = 0; ///< Next position to be consumed; only used by the consumer.
+
+public:
+	MPSCRingBuffer() : slots(std::make_unique<Slot[]>(Tcapacity))
+	{
+		for (size_t i = 0; i < Tcapacity; i++) this->slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Add an item to the queue; safe to call from any thread.
+	 * @param value The item to add; only moved from when the item was added.
+	 * @return True iff the item was added, false when the queue is full.
+	 */
+	bool TryPush(T &&value)
+	{
+		size_t pos = this->head.load(std::memory_order_relaxed);
+		for (;;) {
+			Slot &slot = this->slots[pos & (Tcapacity - 1)];
+			size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			if (sequence == pos) {
+				if (this->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					slot.value = std::move(value);
+					slot.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+				/* Another producer claimed the position; pos has been updated by the failed exchange. */
+			} else if (static_cast<std::make_signed_t<size_t>>(sequence - pos) < 0) {
+				/* The slot still holds the item of the previous round. */
+				return false;
+			} else {
+				pos = this->head.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**
+	 * Take the oldest item from the queue; may only be called from the consumer thread.
+	 * @return The item, or std::nullopt when the queue is empty, or the oldest item is still being written.
+	 */
+	std::optional<T> TryPop()
+	{
+		Slot &slot = this->slots[this->tail & (Tcapacity - 1)];
+		if (slot.sequence.load(std::memory_order_acquire) != this->tail + 1) return std::nullopt;
+
+		std::optional<T> value{std::move(slot.value)};
+		slot.sequence.store(this->tail + Tcapacity, std::memory_order_release);
+		this->tail++;
+		return value;
+	}
+
+	/**
+	 * Get the number of items the queue can hold.
+	 * @return The capacity.
+	 */
+	static constexpr size_t Capacity() { return Tcapacity; }
+};
+
+#endif /* MPSC_RING_BUFFER_HPP */
@@ -89,6 +89,8 @@ DEFINE_POOL_METHOD(inline void *)::AllocateItem(size_t size, size_t index)
 
 	this->first_unused = std::max(this->first_unused, index + 1);
 	this->items++;
+	this->allocations++;
+	this->bytes += size;
 
 	Titem *item;
 	if (Tcache && this->alloc_cache != nullptr) {
@@ -170,6 +172,8 @@ DEFINE_POOL_METHOD(void)::FreeItem(size_t size, size_t index)
 	this->data[index] = nullptr;
 	this->first_free = std::min(this->first_free, index);
 	this->items--;
+	this->frees++;
+	this->bytes -= size;
 	if (!this->cleaning) {
 		ClrBit(this->used_bitmap[index / BITMAP_SIZE], index % BITMAP_SIZE);
 		Titem::PostDestructor(index);
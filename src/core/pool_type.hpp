@@ -111,6 +111,40 @@ struct PoolBase {
 	 */
 	virtual void CleanPool() = 0;
 
+	uint64_t allocations = 0; ///< Number of items ever allocated in this pool.
+	uint64_t frees = 0; ///< Number of items ever freed from this pool.
+	uint64_t bytes = 0; ///< Number of bytes used by the items in this pool.
+
+	/**
+	 * Get the name of this pool.
+	 * @return The name.
+	 */
+	virtual std::string_view GetName() const = 0;
+
+	/**
+	 * Get the number of items in this pool.
+	 * @return The number of items.
+	 */
+	virtual size_t GetItemCount() const = 0;
+
+	/**
+	 * Get the number of items this pool has room for without growing.
+	 * @return The capacity.
+	 */
+	virtual size_t GetCapacity() const = 0;
+
+	/**
+	 * Get the number of items up to the highest used index; the unused indices below it are holes.
+	 * @return The used range.
+	 */
+	virtual size_t GetUsedRange() const = 0;
+
+	/**
+	 * Get the number of bytes of the administration of this pool, excluding the items.
+	 * @return The number of bytes.
+	 */
+	virtual size_t GetAdministrationBytes() const = 0;
+
 private:
 	/**
 	 * Dummy private copy constructor to prevent compilers from
@@ -153,6 +187,12 @@ public:
 	Pool(std::string_view name) : PoolBase(Tpool_type), name(name) {}
 	void CleanPool() override;
 
+	std::string_view GetName() const override { return this->name; }
+	size_t GetItemCount() const override { return this->items; }
+	size_t GetCapacity() const override { return this->data.size(); }
+	size_t GetUsedRange() const override { return this->first_unused; }
+	size_t GetAdministrationBytes() const override { return this->data.capacity() * sizeof(Titem *) + this->used_bitmap.capacity() * sizeof(BitmapStorage); }
+
 	/**
 	 * Returns Titem with given index
 	 * @param index of item to get
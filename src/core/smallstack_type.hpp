@@ -225,6 +225,15 @@ public:
 		return this->value == Tinvalid && this->next == Tmax_size;
 	}
 
+	/**
+	 * Check if the stack holds at most one item, i.e. doesn't use any pool items.
+	 * @return If the stack holds at most one item.
+	 */
+	inline bool IsSingle() const
+	{
+		return this->next == Tmax_size;
+	}
+
 	/**
 	 * Check if the given item is contained in the stack.
 	 * @param item Item to look for.
@@ -9,6 +9,7 @@
 
 #include "stdafx.h"
 #include "crashlog.h"
+#include "debug_log.h"
 #include "survey.h"
 #include "gamelog.h"
 #include "map_func.h"
@@ -276,6 +277,9 @@ void CrashLog::MakeCrashLog()
 	if (crashlogged) return;
 	crashlogged = true;
 
+	/* Write the debug messages that were logged right before the crash first, so they precede the crash log. */
+	this->TryExecute("debuglog", []() { DrainDebugLogOnCrash(); return true; });
+
 	fmt::print("Crash encountered, generating crash log...\n");
 	this->FillCrashLog();
 	fmt::print("Crash log generated.\n\n");
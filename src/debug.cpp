@@ -11,9 +11,12 @@
 #include "core/string_consumer.hpp"
 #include "console_func.h"
 #include "debug.h"
+#include "debug_log.h"
 #include "string_func.h"
 #include "fileio_func.h"
 #include "settings_type.h"
+#include "company_func.h"
+#include "timer/timer_game_tick.h"
 #include <mutex>
 
 #if defined(_WIN32)
@@ -50,6 +53,7 @@ int _debug_sl_level;
 int _debug_gamelog_level;
 int _debug_desync_level;
 int _debug_console_level;
+int _debug_linkgraph_level;
 #ifdef RANDOM_DEBUG
 int _debug_random_level;
 #endif
@@ -75,6 +79,7 @@ static const std::initializer_list<DebugLevel> _debug_levels{
 	DEBUG_LEVEL(gamelog),
 	DEBUG_LEVEL(desync),
 	DEBUG_LEVEL(console),
+	DEBUG_LEVEL(linkgraph),
 #ifdef RANDOM_DEBUG
 	DEBUG_LEVEL(random),
 #endif
@@ -102,36 +107,201 @@ void DumpDebugFacilityNames(std::back_insert_iterator<std::string> &output_itera
 	}
 }
 
+/** Rate limit of the messages of a debug category. */
+struct DebugRateLimit {
+	std::atomic<uint32_t> limit; ///< Maximum number of messages per second, or 0 when not limited.
+	std::atomic<uint32_t> second; ///< Second of #_debug_rate_limit_epoch the count is for.
+	std::atomic<uint32_t> count; ///< Number of messages in that second.
+	std::atomic<uint32_t> suppressed; ///< Number of messages suppressed in that second.
+	std::atomic<uint64_t> total_suppressed; ///< Number of messages ever suppressed.
+};
+
+static constexpr size_t MAX_DEBUG_CATEGORIES = 32; ///< Maximum number of debug categories.
+static std::array<DebugRateLimit, MAX_DEBUG_CATEGORIES> _debug_rate_limits; ///< Rate limits, in the same order as #_debug_levels.
+static const auto _debug_rate_limit_epoch = std::chrono::steady_clock::now(); ///< Start of the seconds of the rate limits.
+static thread_local bool _debug_game_thread = false; ///< Whether the current thread runs the game, so it may read the tick and company.
+
 /**
- * Internal function for outputting the debug line.
- * @param level Debug category.
- * @param message The message to output.
+ * Get the index of a debug category.
+ * @param category Name of the category.
+ * @return The index in #_debug_levels, or std::nullopt when the category is not known.
  */
-void DebugPrint(std::string_view category, int level, std::string &&message)
+static std::optional<uint8_t> GetDebugCategoryIndex(std::string_view category)
+{
+	auto it = std::ranges::find(_debug_levels, category, &DebugLevel::name);
+	if (it == std::end(_debug_levels)) return std::nullopt;
+	assert(_debug_levels.size() <= MAX_DEBUG_CATEGORIES);
+	return static_cast<uint8_t>(std::distance(std::begin(_debug_levels), it));
+}
+
+/**
+ * Get the name of a debug category.
+ * @param category Index of the category.
+ * @return The name of the category.
+ */
+std::string_view GetDebugCategoryName(uint8_t category)
+{
+	assert(category < _debug_levels.size());
+	return std::data(_debug_levels)[category].name;
+}
+
+/**
+ * Format a time as prefix for logs.
+ * @param time The time.
+ * @return The prefix.
+ */
+static std::string FormatLogTime(std::time_t time)
+{
+	return fmt::format("[{:%Y-%m-%d %H:%M:%S}] ", fmt::localtime(time));
+}
+
+/**
+ * Test whether a debug message is written to a log file of its own, instead of to the standard error.
+ * @param message The message.
+ * @return True iff the message goes to 'commands-out.log' or 'random-out.log'.
+ */
+bool HasOwnLogFile(const DebugMessage &message)
 {
-	if (category == "desync" && level != 0) {
+	std::string_view category = GetDebugCategoryName(message.category);
+	return (category == "desync" && message.level != 0) || category == "random";
+}
+
+/**
+ * Write a debug message to its destination.
+ * Called on the thread that logged the message, or on the debug log writer thread.
+ * @param message The message.
+ */
+void WriteDebugMessage(const DebugMessage &message)
+{
+	std::string_view category = GetDebugCategoryName(message.category);
+
+	if (category == "desync" && message.level != 0) {
 		static auto f = FioFOpenFile("commands-out.log", "wb", AUTOSAVE_DIR);
 		if (!f.has_value()) return;
 
-		fmt::print(*f, "{}{}\n", GetLogPrefix(true), message);
+		fmt::print(*f, "{}{}\n", FormatLogTime(message.time), message.message);
 		fflush(*f);
 #ifdef RANDOM_DEBUG
 	} else if (category == "random") {
 		static auto f = FioFOpenFile("random-out.log", "wb", AUTOSAVE_DIR);
 		if (!f.has_value()) return;
 
-		fmt::print(*f, "{}\n", message);
+		fmt::print(*f, "{}\n", message.message);
 		fflush(*f);
 #endif
 	} else {
-		fmt::print(stderr, "{}dbg: [{}:{}] {}\n", GetLogPrefix(true), category, level, message);
+		fmt::print(stderr, "{}dbg: [{}:{}] {}\n", FormatLogTime(message.time), category, message.level, message.message);
+	}
+}
+
+/**
+ * Mark the current thread as one that runs the game.
+ * Debug messages get the tick and company of the game only when they are logged on such a thread,
+ * as other threads can't read them without racing with the game.
+ */
+void SetDebugGameThread()
+{
+	_debug_game_thread = true;
+}
+
+/**
+ * Create a debug message, with the tick and company when logged on a thread that runs the game.
+ * @param category Index of the category.
+ * @param level Level of the message.
+ * @param message The formatted message.
+ * @return The debug message.
+ */
+static DebugMessage CreateDebugMessage(uint8_t category, int level, std::string &&message)
+{
+	DebugMessage debug_message{time(nullptr), 0, CompanyID::Invalid(), category, static_cast<uint8_t>(level), std::move(message)};
+	if (_debug_game_thread) {
+		debug_message.tick = TimerGameTick::counter;
+		debug_message.company = _current_company;
+	}
+	return debug_message;
+}
 
-		if (_debug_remote_console.load()) {
-			/* Only add to the queue when there is at least one consumer of the data. */
-			std::lock_guard<std::mutex> lock(_debug_remote_console_mutex);
-			_debug_remote_console_queue.emplace_back(category, std::move(message));
+/**
+ * Test whether a message is within the rate limit of its category.
+ * When a new second starts, and messages were suppressed in the previous one, a message with their number is logged.
+ * @param category Index of the category.
+ * @param level Level of the message; errors (level 0) are never suppressed.
+ * @return True iff the message may be logged.
+ */
+static bool CheckDebugRateLimit(uint8_t category, int level)
+{
+	DebugRateLimit &rate_limit = _debug_rate_limits[category];
+	uint32_t limit = rate_limit.limit.load(std::memory_order_relaxed);
+	if (limit == 0 || level == 0) return true;
+
+	uint32_t now = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - _debug_rate_limit_epoch).count());
+	uint32_t second = rate_limit.second.load(std::memory_order_relaxed);
+	if (second != now && rate_limit.second.compare_exchange_strong(second, now, std::memory_order_relaxed)) {
+		rate_limit.count.store(0, std::memory_order_relaxed);
+		uint32_t suppressed = rate_limit.suppressed.exchange(0, std::memory_order_relaxed);
+		if (suppressed != 0) {
+			SubmitDebugMessage(CreateDebugMessage(category, level, fmt::format("{} messages suppressed by the rate limit of {} per second", suppressed, limit)));
 		}
 	}
+
+	if (rate_limit.count.fetch_add(1, std::memory_order_relaxed) < limit) return true;
+
+	rate_limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+	rate_limit.total_suppressed.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+/**
+ * Internal function for outputting the debug line.
+ * @param category Debug category.
+ * @param level Debug level.
+ * @param message The message to output.
+ */
+void DebugPrint(std::string_view category, int level, std::string &&message)
+{
+	std::optional<uint8_t> index = GetDebugCategoryIndex(category);
+	assert(index.has_value());
+
+	DebugMessage debug_message = CreateDebugMessage(*index, level, std::move(message));
+	/* The logs of their own have to be complete. */
+	if (!HasOwnLogFile(debug_message) && !CheckDebugRateLimit(*index, level)) return;
+
+	if (!HasOwnLogFile(debug_message) && _debug_remote_console.load()) {
+		/* Only add to the queue when there is at least one consumer of the data. */
+		std::lock_guard<std::mutex> lock(_debug_remote_console_mutex);
+		_debug_remote_console_queue.emplace_back(category, debug_message.message);
+	}
+
+	SubmitDebugMessage(std::move(debug_message));
+}
+
+/**
+ * Limit the number of messages of a debug category.
+ * @param category Name of the category.
+ * @param limit Maximum number of messages per second, or 0 to not limit the category.
+ * @return True iff the category exists.
+ */
+bool SetDebugRateLimit(std::string_view category, uint32_t limit)
+{
+	std::optional<uint8_t> index = GetDebugCategoryIndex(category);
+	if (!index.has_value()) return false;
+
+	_debug_rate_limits[*index].limit.store(limit, std::memory_order_relaxed);
+	return true;
+}
+
+/**
+ * Get the rate limits of all debug categories.
+ * @return The rate limit per category.
+ */
+std::vector<DebugRateLimitInfo> GetDebugRateLimits()
+{
+	std::vector<DebugRateLimitInfo> result;
+	for (uint8_t i = 0; i < _debug_levels.size(); i++) {
+		const DebugRateLimit &rate_limit = _debug_rate_limits[i];
+		result.emplace_back(GetDebugCategoryName(i), rate_limit.limit.load(std::memory_order_relaxed), rate_limit.total_suppressed.load(std::memory_order_relaxed));
+	}
+	return result;
 }
 
 /**
@@ -218,11 +388,8 @@ std::string GetDebugString()
  */
 std::string GetLogPrefix(bool force)
 {
-	std::string log_prefix;
-	if (force || _settings_client.gui.show_date_in_logs) {
-		log_prefix = fmt::format("[{:%Y-%m-%d %H:%M:%S}] ", fmt::localtime(time(nullptr)));
-	}
-	return log_prefix;
+	if (force || _settings_client.gui.show_date_in_logs) return FormatLogTime(time(nullptr));
+	return {};
 }
 
 /**
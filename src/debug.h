@@ -51,6 +51,7 @@ extern int _debug_sl_level;
 extern int _debug_gamelog_level;
 extern int _debug_desync_level;
 extern int _debug_console_level;
+extern int _debug_linkgraph_level;
 #ifdef RANDOM_DEBUG
 extern int _debug_random_level;
 #endif
@@ -137,4 +138,12 @@ std::string GetLogPrefix(bool force = false);
 void DebugSendRemoteMessages();
 void DebugReconsiderSendRemoteMessages();
 
+/** Memory usage of the process, in bytes; 0 when it can not be determined on this platform. */
+struct ProcessMemoryUsage {
+	size_t resident = 0; ///< Current resident set size.
+	size_t peak_resident = 0; ///< Highest resident set size since the process started.
+};
+
+ProcessMemoryUsage GetProcessMemoryUsage();
+
 #endif /* DEBUG_H */
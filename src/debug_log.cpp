@@ -0,0 +1,276 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file debug_log.cpp Asynchronous writing of debug messages, and the debug log file. */
+
+#include "stdafx.h"
+#include "debug_log.h"
+#include "debug.h"
+#include "fileio_func.h"
+#include "thread.h"
+#include "core/mpsc_ring_buffer.hpp"
+#include <condition_variable>
+#include <mutex>
+
+#include "3rdparty/fmt/chrono.h"
+
+#include "safeguards.h"
+
+static constexpr size_t DEBUG_LOG_QUEUE_SIZE = 4096; ///< Number of messages the queue can hold.
+static constexpr uint32_t DEBUG_LOG_BINARY_VERSION = 1; ///< Version of the binary format of the debug log file.
+
+static MPSCRingBuffer<DebugMessage, DEBUG_LOG_QUEUE_SIZE> _debug_log_queue; ///< Messages waiting for the writer thread.
+static std::atomic<bool> _debug_log_running; ///< Whether messages are passed to the writer thread.
+static std::atomic<uint32_t> _debug_log_submitting; ///< Number of threads that are passing a message to the writer thread.
+static std::atomic<uint32_t> _debug_log_pending; ///< Messages queued since the writer thread last woke up.
+static std::atomic<uint64_t> _debug_log_queued; ///< Number of messages passed to the writer thread.
+static std::atomic<uint64_t> _debug_log_dropped; ///< Number of messages dropped because the queue was full.
+static std::thread _debug_log_thread; ///< The writer thread.
+static std::mutex _debug_log_wakeup_mutex; ///< Mutex for #_debug_log_wakeup; held by the writer thread while it takes messages from the queue.
+static std::condition_variable _debug_log_wakeup; ///< Wakes up the writer thread.
+
+static std::mutex _debug_log_file_mutex; ///< Guards the debug log file against changes while the writer thread writes to it.
+static std::optional<FileHandle> _debug_log_file; ///< The debug log file, if any.
+static std::string _debug_log_file_name; ///< Name of the debug log file.
+static DebugLogFormat _debug_log_file_format; ///< Format of the debug log file.
+
+/**
+ * Append a number to a buffer in little endian order.
+ * @param buffer The buffer to append to.
+ * @param value The number.
+ */
+template <typename T>
+static void AppendLittleEndian(std::string &buffer, T value)
+{
+	for (size_t i = 0; i < sizeof(T); i++) buffer.push_back(static_cast<char>(static_cast<uint64_t>(value) >> (8 * i)));
+}
+
+/**
+ * Write a message to the debug log file.
+ * @param f The debug log file.
+ * @param message The message.
+ */
+static void WriteDebugLogFile(FILE *f, const DebugMessage &message)
+{
+	std::string_view category = GetDebugCategoryName(message.category);
+
+	if (_debug_log_file_format == DebugLogFormat::Text) {
+		fmt::print(f, "[{:%Y-%m-%d %H:%M:%S}] [{}] [{}] [{}:{}] {}\n", fmt::localtime(message.time), message.tick, message.company.base(), category, message.level, message.message);
+		return;
+	}
+
+	std::string record;
+	AppendLittleEndian<uint64_t>(record, message.time);
+	AppendLittleEndian<uint64_t>(record, message.tick);
+	AppendLittleEndian<uint8_t>(record, message.company.base());
+	AppendLittleEndian<uint8_t>(record, message.level);
+	AppendLittleEndian<uint8_t>(record, category.size());
+	record += category;
+	AppendLittleEndian<uint32_t>(record, message.message.size());
+	record += message.message;
+	fwrite(record.data(), 1, record.size(), f);
+}
+
+/**
+ * Write a message, to the debug log file when one is open.
+ * Errors, and messages with a log file of their own, are always written to their normal destination too.
+ * @param message The message.
+ */
+static void WriteDebugLogMessage(const DebugMessage &message)
+{
+	{
+		std::lock_guard<std::mutex> lock(_debug_log_file_mutex);
+		if (_debug_log_file.has_value()) {
+			WriteDebugLogFile(*_debug_log_file, message);
+			if (message.level != 0 && !HasOwnLogFile(message)) return;
+		}
+	}
+	WriteDebugMessage(message);
+}
+
+/**
+ * Write all messages that are in the queue.
+ * @pre The caller is the only one taking messages from the queue.
+ */
+static void DrainDebugLogQueue()
+{
+	while (std::optional<DebugMessage> message = _debug_log_queue.TryPop()) {
+		WriteDebugLogMessage(*message);
+	}
+
+	std::lock_guard<std::mutex> lock(_debug_log_file_mutex);
+	if (_debug_log_file.has_value()) fflush(*_debug_log_file);
+}
+
+/** Main function of the writer thread. */
+static void DebugLogThread()
+{
+	std::unique_lock<std::mutex> lock(_debug_log_wakeup_mutex);
+	while (_debug_log_running.load(std::memory_order_relaxed)) {
+		_debug_log_pending.store(0, std::memory_order_relaxed);
+		DrainDebugLogQueue();
+
+		/* Producers only wake us for errors and when the queue fills up, so also look every now and then. */
+		_debug_log_wakeup.wait_for(lock, std::chrono::milliseconds(50));
+	}
+}
+
+/**
+ * Write a debug message; on the writer thread when the debug log is running, otherwise right away.
+ * Errors and messages with a log file of their own are never dropped; when the queue is full they are written right away.
+ * @param message The message.
+ */
+void SubmitDebugMessage(DebugMessage &&message)
+{
+	/* Announce ourselves before looking whether the writer thread runs, so StopDebugLog waits for our message. */
+	_debug_log_submitting++;
+	if (!_debug_log_running.load()) {
+		_debug_log_submitting--;
+		WriteDebugLogMessage(message);
+		return;
+	}
+
+	bool error = message.level == 0;
+	bool keep = error || HasOwnLogFile(message);
+	if (_debug_log_queue.TryPush(std::move(message))) {
+		_debug_log_queued.fetch_add(1, std::memory_order_relaxed);
+		if (error || _debug_log_pending.fetch_add(1, std::memory_order_relaxed) + 1 == DEBUG_LOG_QUEUE_SIZE / 4) {
+			_debug_log_wakeup.notify_one();
+		}
+		_debug_log_submitting--;
+		return;
+	}
+	_debug_log_submitting--;
+
+	/* Never lose errors and the logs replaying the game; rather write them out of order. */
+	if (keep) {
+		WriteDebugLogMessage(message);
+		return;
+	}
+	_debug_log_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Start writing debug messages on the writer thread.
+ * @return True iff the writer thread is running.
+ */
+bool StartDebugLog()
+{
+	if (_debug_log_running.load()) return true;
+
+	_debug_log_running.store(true);
+	if (!StartNewThread(&_debug_log_thread, "ottd:debuglog", &DebugLogThread)) {
+		_debug_log_running.store(false);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Stop the writer thread, after it wrote all queued messages, and close the debug log file.
+ * Messages are written right away again afterwards.
+ */
+void StopDebugLog()
+{
+	if (!_debug_log_running.load()) return;
+
+	/* From now on new messages are written right away. */
+	{
+		std::lock_guard<std::mutex> lock(_debug_log_wakeup_mutex);
+		_debug_log_running.store(false);
+	}
+	_debug_log_wakeup.notify_one();
+	_debug_log_thread.join();
+
+	/* Wait for the messages that were being queued when the thread stopped; then this is the only consumer. */
+	while (_debug_log_submitting.load() != 0) std::this_thread::yield();
+	DrainDebugLogQueue();
+	CloseDebugLogFile();
+}
+
+/**
+ * Write the messages that are still queued, because the game crashed.
+ * This does not wait for the writer thread, as that might be the thread that crashed. When the writer
+ * thread or the debug log file is busy, the messages are left to the writer thread.
+ */
+void DrainDebugLogOnCrash()
+{
+	std::unique_lock<std::mutex> lock(_debug_log_wakeup_mutex, std::try_to_lock);
+	if (!lock.owns_lock()) return;
+
+	{
+		std::unique_lock<std::mutex> file_lock(_debug_log_file_mutex, std::try_to_lock);
+		if (!file_lock.owns_lock()) return;
+	}
+	DrainDebugLogQueue();
+}
+
+/**
+ * Test whether debug messages are written on the writer thread.
+ * @return True iff the writer thread is running.
+ */
+bool IsDebugLogRunning()
+{
+	return _debug_log_running.load();
+}
+
+/**
+ * Open a debug log file, in the autosave directory, and start the writer thread.
+ * A previously opened debug log file is closed.
+ * @param filename Name of the file.
+ * @param format Format to write the messages in.
+ * @return True iff the file is open.
+ */
+bool OpenDebugLogFile(std::string_view filename, DebugLogFormat format)
+{
+	std::optional<FileHandle> f = FioFOpenFile(filename, format == DebugLogFormat::Text ? "wt" : "wb", AUTOSAVE_DIR);
+	if (!f.has_value()) return false;
+
+	if (format == DebugLogFormat::Binary) {
+		std::string header{"OTTDDLOG"};
+		AppendLittleEndian<uint32_t>(header, DEBUG_LOG_BINARY_VERSION);
+		fwrite(header.data(), 1, header.size(), *f);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_debug_log_file_mutex);
+		_debug_log_file = std::move(f);
+		_debug_log_file_name = filename;
+		_debug_log_file_format = format;
+	}
+	return StartDebugLog();
+}
+
+/**
+ * Close the debug log file; messages are written to their normal destination again.
+ */
+void CloseDebugLogFile()
+{
+	std::lock_guard<std::mutex> lock(_debug_log_file_mutex);
+	_debug_log_file.reset();
+	_debug_log_file_name.clear();
+}
+
+/**
+ * Get the name of the debug log file.
+ * @return The name, or std::nullopt when no debug log file is open.
+ */
+std::optional<std::string> GetDebugLogFileName()
+{
+	std::lock_guard<std::mutex> lock(_debug_log_file_mutex);
+	if (!_debug_log_file.has_value()) return std::nullopt;
+	return _debug_log_file_name;
+}
+
+/**
+ * Get the statistics of the asynchronous debug log.
+ * @return The statistics since the game started.
+ */
+DebugLogStats GetDebugLogStats()
+{
+	return {_debug_log_queued.load(std::memory_order_relaxed), _debug_log_dropped.load(std::memory_order_relaxed)};
+}
@@ -0,0 +1,84 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file debug_log.h Asynchronous writing of debug messages, and the debug log file.
+ *
+ * By default every Debug() call writes its message before it returns. When the debug log is
+ * started, messages are instead queued in a lock-free ring buffer, and a writer thread writes
+ * them; the thread that logs never waits for I/O. When the queue is full messages are dropped,
+ * except errors (level 0) and messages that have a log file of their own, like the commands in
+ * 'commands-out.log'; those are then written directly.
+ *
+ * While a debug log file is open, the messages are written to it with their tick and company,
+ * instead of to stderr; errors still go to stderr too. Messages that have a log file of their
+ * own are still written there as well. Only the threads that run the game know the tick and
+ * company; messages of other threads have tick 0 and an invalid company. The binary format of the file is:
+ * - the magic "OTTDDLOG", followed by the version (uint32_t, currently 1);
+ * - per message: time (uint64_t, seconds since the epoch), tick (uint64_t), company (uint8_t),
+ *   level (uint8_t), category length (uint8_t) and bytes, message length (uint32_t) and bytes.
+ * All numbers are little endian.
+ *
+ * Independent of the above, every category can be limited to a number of messages per second.
+ * Errors and messages that have a log file of their own are never limited.
+ *
+ * @see debug_log.cpp for implementation
+ */
+
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include "company_type.h"
+#include <ctime>
+
+/** A debug message with the context it was logged in. */
+struct DebugMessage {
+	std::time_t time = 0; ///< Time the message was logged at.
+	uint64_t tick = 0; ///< Game tick counter when the message was logged.
+	CompanyID company = CompanyID::Invalid(); ///< Current company when the message was logged.
+	uint8_t category = 0; ///< Index of the category; see #GetDebugCategoryName.
+	uint8_t level = 0; ///< Level of the message.
+	std::string message; ///< The formatted message.
+};
+
+/** Formats of the debug log file. */
+enum class DebugLogFormat : uint8_t {
+	Text, ///< A line of text per message.
+	Binary, ///< Binary records; see the file documentation.
+};
+
+/** Statistics of the asynchronous debug log. */
+struct DebugLogStats {
+	uint64_t queued = 0; ///< Number of messages passed to the writer thread.
+	uint64_t dropped = 0; ///< Number of messages dropped because the queue was full.
+};
+
+/** Rate limit of the messages of a single category. */
+struct DebugRateLimitInfo {
+	std::string_view category; ///< Name of the category.
+	uint32_t limit; ///< Maximum number of messages per second, or 0 when not limited.
+	uint64_t suppressed; ///< Number of messages suppressed by the limit.
+};
+
+std::string_view GetDebugCategoryName(uint8_t category);
+bool HasOwnLogFile(const DebugMessage &message);
+void WriteDebugMessage(const DebugMessage &message);
+
+void SetDebugGameThread();
+void SubmitDebugMessage(DebugMessage &&message);
+bool StartDebugLog();
+void StopDebugLog();
+void DrainDebugLogOnCrash();
+bool IsDebugLogRunning();
+bool OpenDebugLogFile(std::string_view filename, DebugLogFormat format);
+void CloseDebugLogFile();
+std::optional<std::string> GetDebugLogFileName();
+DebugLogStats GetDebugLogStats();
+
+bool SetDebugRateLimit(std::string_view category, uint32_t limit);
+std::vector<DebugRateLimitInfo> GetDebugRateLimits();
+
+#endif /* DEBUG_LOG_H */
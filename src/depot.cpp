@@ -9,6 +9,9 @@
 
 #include "stdafx.h"
 #include "depot_base.h"
+#include "depot_func.h"
+#include "depot_kdtree.h"
+#include "company_type.h"
 #include "order_backup.h"
 #include "order_func.h"
 #include "window_func.h"
@@ -27,6 +30,8 @@ INSTANTIATE_POOL_METHODS(Depot)
  */
 Depot::~Depot()
 {
+	InvalidateDepotKdtrees();
+
 	if (CleaningPool()) return;
 
 	if (!IsDepotTile(this->xy) || GetDepotIndex(this->xy) != this->index) {
@@ -47,3 +52,41 @@ Depot::~Depot()
 	VehicleType vt = GetDepotVehicleType(this->xy);
 	CloseWindowById(GetWindowClassForVehicleType(vt), VehicleListIdentifier(VL_DEPOT_LIST, vt, GetTileOwner(this->xy), this->index).ToWindowNumber());
 }
+
+static TypedIndexContainer<std::array<DepotKdtree, MAX_COMPANIES>, CompanyID> _ship_depot_kdtrees; ///< Ship depots per company.
+static bool _depot_kdtrees_valid = false; ///< Whether _ship_depot_kdtrees reflects the current depots.
+
+/**
+ * Mark the trees of depots as outdated, e.g. because a depot was built or
+ * removed or changed owner. They are rebuilt when needed.
+ */
+void InvalidateDepotKdtrees()
+{
+	_depot_kdtrees_valid = false;
+}
+
+/**
+ * Get the tree of the ship depots of a company.
+ * @param owner Company to get the depots for.
+ * @return Tree of the ship depots.
+ */
+const DepotKdtree &GetShipDepotKdtree(Owner owner)
+{
+	assert(owner < MAX_COMPANIES);
+
+	if (!_depot_kdtrees_valid) {
+		TypedIndexContainer<std::array<std::vector<DepotID>, MAX_COMPANIES>, CompanyID> depots;
+		for (const Depot *depot : Depot::Iterate()) {
+			if (!IsShipDepotTile(depot->xy)) continue;
+			Owner depot_owner = GetTileOwner(depot->xy);
+			if (depot_owner >= MAX_COMPANIES) continue;
+			depots[depot_owner].push_back(depot->index);
+		}
+		for (CompanyID c = CompanyID::Begin(); c < MAX_COMPANIES; ++c) {
+			_ship_depot_kdtrees[c].Build(depots[c].begin(), depots[c].end());
+		}
+		_depot_kdtrees_valid = true;
+	}
+
+	return _ship_depot_kdtrees[owner];
+}
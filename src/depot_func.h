@@ -18,6 +18,8 @@ void InitDepotWindowBlockSizes();
 
 void DeleteDepotHighlightOfVehicle(const Vehicle *v);
 
+void InvalidateDepotKdtrees();
+
 /**
  * Find out if the slope of the tile is suitable to build a depot of given direction
  * @param direction The direction in which the depot's exit points
@@ -24,6 +24,10 @@
 #include <unistd.h>
 #include <pwd.h>
 #endif
+#ifdef UNIX
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
 #include <sys/stat.h>
 #include <filesystem>
 
@@ -1012,6 +1016,20 @@ void SanitizeFilename(std::string &filename)
 	}
 }
 
+/**
+ * Test whether a filename only names a file, without any directory, so it cannot point outside the directory it is opened in.
+ * @param filename the filename
+ * @return True iff the filename is not empty, not "." or "..", and has none of the characters #SanitizeFilename replaces.
+ */
+bool IsPlainFilename(std::string_view filename)
+{
+	if (filename.empty() || filename == "." || filename == "..") return false;
+
+	std::string sanitized{filename};
+	SanitizeFilename(sanitized);
+	return sanitized == filename;
+}
+
 /**
  * Load a file into memory.
  * @param filename Name of the file to load.
@@ -1039,6 +1057,50 @@ std::unique_ptr<char[]> ReadFileToMem(const std::string &filename, size_t &lenp,
 	return mem;
 }
 
+/**
+ * Open a file for read-only access to its whole contents.
+ * @param filename Name of the file to open.
+ * @param maxsize Maximum size of the file.
+ * @return The opened file, or \c nullptr when it could not be opened or is too big.
+ */
+/* static */ std::unique_ptr<MappedFile> MappedFile::Open(const std::string &filename, size_t maxsize)
+{
+	std::unique_ptr<MappedFile> file(new MappedFile());
+
+#ifdef UNIX
+	int fd = open(OTTD2FS(filename).c_str(), O_RDONLY);
+	if (fd < 0) return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) > maxsize) {
+		close(fd);
+		return nullptr;
+	}
+
+	size_t size = static_cast<size_t>(st.st_size);
+	void *mem = size == 0 ? MAP_FAILED : mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mem != MAP_FAILED) {
+		file->data = std::span<const char>(static_cast<const char *>(mem), size);
+		return file;
+	}
+	/* Mapping failed, e.g. because the file system does not support it. Fall back to reading. */
+#endif
+
+	size_t len = 0;
+	file->buffer = ReadFileToMem(filename, len, maxsize);
+	if (file->buffer == nullptr) return nullptr;
+	file->data = std::span<const char>(file->buffer.get(), len);
+	return file;
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef UNIX
+	if (this->buffer == nullptr && !this->data.empty()) munmap(const_cast<char *>(this->data.data()), this->data.size());
+#endif
+}
+
 /**
  * Helper to see whether a given filename matches the extension.
  * @param extension The extension to look for.
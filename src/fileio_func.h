@@ -24,9 +24,34 @@ bool FioRemove(const std::string &filename);
 std::string_view FiosGetScreenshotDir();
 
 void SanitizeFilename(std::string &filename);
+bool IsPlainFilename(std::string_view filename);
 void AppendPathSeparator(std::string &buf);
 void DeterminePaths(std::string_view exe, bool only_local_path);
 std::unique_ptr<char[]> ReadFileToMem(const std::string &filename, size_t &lenp, size_t maxsize);
+
+/**
+ * Read-only view on the contents of a whole file.
+ * Where the platform allows it the file is mapped into memory, so only the
+ * parts that are actually accessed get loaded, and the memory is shared with
+ * other processes using the same file. Otherwise the file is read into memory.
+ */
+class MappedFile {
+public:
+	static std::unique_ptr<MappedFile> Open(const std::string &filename, size_t maxsize);
+	~MappedFile();
+
+	/**
+	 * Get the contents of the file.
+	 * @return The contents of the file.
+	 */
+	std::span<const char> GetData() const { return this->data; }
+
+private:
+	MappedFile() = default;
+
+	std::span<const char> data{}; ///< The contents of the file.
+	std::unique_ptr<char[]> buffer{}; ///< Buffer with the contents of the file, when it could not be mapped.
+};
 bool FileExists(std::string_view filename);
 bool ExtractTar(const std::string &tar_filename, Subdirectory subdir);
 
@@ -12,6 +12,7 @@
 #include "framerate_type.h"
 #include <chrono>
 #include "gfx_func.h"
+#include "core/geometry_func.hpp"
 #include "newgrf_sound.h"
 #include "window_gui.h"
 #include "window_func.h"
@@ -24,6 +25,11 @@
 #include "ai/ai_instance.hpp"
 #include "game/game.hpp"
 #include "game/game_instance.hpp"
+#include "group.h"
+#include "memory_stats.h"
+#include "tick_cost.h"
+#include "vehicle_base.h"
+#include "vehicle_gui.h"
 #include "timer/timer.h"
 #include "timer/timer_window.h"
 #include "zoom_func.h"
@@ -32,6 +38,7 @@
 
 #include <atomic>
 #include <mutex>
+#include "3rdparty/nlohmann/json.hpp"
 
 #include "table/strings.h"
 
@@ -401,6 +408,10 @@ static constexpr NWidgetPart _framerate_window_widgets[] = {
 					NWidget(WWT_EMPTY, INVALID_COLOUR, WID_FRW_ALLOCSIZE), SetScrollbar(WID_FRW_SCROLLBAR),
 				EndContainer(),
 				NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_INFO_DATA_POINTS), SetFill(1, 0), SetResize(1, 0),
+				NWidget(NWID_HORIZONTAL, NWidContainerFlag::EqualSize), SetPIP(0, WidgetDimensions::unscaled.hsep_normal, 0),
+					NWidget(WWT_PUSHTXTBTN, COLOUR_GREY, WID_FRW_TICK_COSTS), SetStringTip(STR_FRAMERATE_TICK_COSTS, STR_FRAMERATE_TICK_COSTS_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
+					NWidget(WWT_PUSHTXTBTN, COLOUR_GREY, WID_FRW_MEMORY), SetStringTip(STR_FRAMERATE_MEMORY, STR_FRAMERATE_MEMORY_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
+				EndContainer(),
 			EndContainer(),
 		EndContainer(),
 		NWidget(NWID_VERTICAL),
@@ -675,6 +686,14 @@ struct FramerateWindow : Window {
 				}
 				break;
 			}
+
+			case WID_FRW_TICK_COSTS:
+				ShowTickCostWindow();
+				break;
+
+			case WID_FRW_MEMORY:
+				ShowMemoryWindow();
+				break;
 		}
 	}
 
@@ -982,6 +1001,347 @@ static WindowDesc _frametime_graph_window_desc(
 
 
 
+/** @hideinitializer */
+static constexpr NWidgetPart _tick_cost_window_widgets[] = {
+	NWidget(NWID_HORIZONTAL),
+		NWidget(WWT_CLOSEBOX, COLOUR_GREY),
+		NWidget(WWT_CAPTION, COLOUR_GREY), SetStringTip(STR_TICK_COST_CAPTION, STR_TOOLTIP_WINDOW_TITLE_DRAG_THIS),
+		NWidget(WWT_SHADEBOX, COLOUR_GREY),
+		NWidget(WWT_STICKYBOX, COLOUR_GREY),
+	EndContainer(),
+	NWidget(WWT_PANEL, COLOUR_GREY),
+		NWidget(NWID_VERTICAL), SetPadding(WidgetDimensions::unscaled.frametext), SetPIP(0, WidgetDimensions::unscaled.vsep_wide, 0),
+			NWidget(WWT_EMPTY, INVALID_COLOUR, WID_TCW_COMPANIES), SetFill(1, 0),
+			NWidget(NWID_HORIZONTAL), SetPIP(0, WidgetDimensions::unscaled.hsep_wide, 0),
+				NWidget(WWT_EMPTY, INVALID_COLOUR, WID_TCW_VEHICLES), SetFill(1, 0),
+				NWidget(WWT_EMPTY, INVALID_COLOUR, WID_TCW_GROUPS), SetFill(1, 0),
+			EndContainer(),
+			NWidget(WWT_EMPTY, INVALID_COLOUR, WID_TCW_INFO), SetFill(1, 0),
+		EndContainer(),
+	EndContainer(),
+};
+
+/** Window showing on behalf of which companies, vehicles and groups the game loop time is spent. */
+struct TickCostWindow : Window {
+	static constexpr int NUM_COLUMNS = to_underlying(TickCostType::End) + 1; ///< Value columns, including the total.
+
+	int name_width = 0; ///< Width of the company name column.
+	int value_width = 0; ///< Width of a value column.
+	size_t num_companies = 0; ///< Number of companies the window was sized for.
+
+	TickCostWindow(WindowDesc &desc, WindowNumber number) : Window(desc)
+	{
+		this->num_companies = Company::GetNumItems();
+		this->InitNested(number);
+	}
+
+	/** Update the window on a regular interval; the report changes every #TickCostAccounting::PERIOD ticks. */
+	const IntervalTimer<TimerWindow> update_interval = {std::chrono::seconds(1), [this](auto) {
+		if (Company::GetNumItems() != this->num_companies) {
+			this->num_companies = Company::GetNumItems();
+			this->ReInit();
+		}
+		this->SetDirty();
+	}};
+
+	void UpdateWidgetSize(WidgetID widget, Dimension &size, [[maybe_unused]] const Dimension &padding, [[maybe_unused]] Dimension &fill, [[maybe_unused]] Dimension &resize) override
+	{
+		int line_height = GetCharacterHeight(FS_NORMAL);
+		switch (widget) {
+			case WID_TCW_COMPANIES: {
+				Dimension name = maxdim(GetStringBoundingBox(STR_TICK_COST_COMPANY), GetStringBoundingBox(STR_TICK_COST_OTHER));
+				for (const Company *c : Company::Iterate()) name = maxdim(name, GetStringBoundingBox(GetString(STR_TICK_COST_COMPANY_NAME, c->index)));
+				Dimension value = GetStringBoundingBox(GetString(STR_FRAMERATE_MS_GOOD, GetParamMaxDigits(6), 3));
+				for (int i = 0; i < NUM_COLUMNS; i++) value = maxdim(value, GetStringBoundingBox(STR_TICK_COST_TRAINS + i));
+
+				this->name_width = name.width;
+				this->value_width = value.width;
+				size.width = this->name_width + NUM_COLUMNS * (this->value_width + WidgetDimensions::scaled.hsep_wide);
+				size.height = (this->num_companies + 2) * line_height + WidgetDimensions::scaled.vsep_normal;
+				break;
+			}
+
+			case WID_TCW_VEHICLES:
+			case WID_TCW_GROUPS:
+				size.width = std::max<uint>(GetStringBoundingBox(widget == WID_TCW_VEHICLES ? STR_TICK_COST_TOP_VEHICLES : STR_TICK_COST_TOP_GROUPS).width, 4 * this->value_width);
+				size.height = (TickCostReport::TOP_COUNT + 1) * line_height + WidgetDimensions::scaled.vsep_normal;
+				break;
+
+			case WID_TCW_INFO:
+				size.height = 2 * line_height;
+				break;
+		}
+	}
+
+	/**
+	 * Draw an average time per tick.
+	 * @param r Where to draw, right aligned.
+	 * @param ns Time in nanoseconds.
+	 */
+	static void DrawTime(const Rect &r, uint64_t ns)
+	{
+		/* A game loop using more than a third of the tick on a single company is worth a warning. */
+		uint64_t tick_ns = MILLISECONDS_PER_TICK * 1000000ULL;
+		StringID str = ns > tick_ns ? STR_FRAMERATE_MS_BAD : ns > tick_ns / 3 ? STR_FRAMERATE_MS_WARN : STR_FRAMERATE_MS_GOOD;
+		DrawString(r.left, r.right, r.top, GetString(str, ns / 1000, 3), TC_FROMSTRING, SA_RIGHT | SA_FORCE);
+	}
+
+	/**
+	 * Draw the row of a company in the cost table.
+	 * @param line Rectangle of the row.
+	 * @param index Index of the company in the report.
+	 * @param name The name of the company.
+	 */
+	void DrawCompanyRow(const Rect &line, size_t index, const std::string &name) const
+	{
+		const TickCostReport &report = TickCostAccounting::GetReport();
+		bool rtl = _current_text_dir == TD_RTL;
+
+		DrawString(line.WithWidth(this->name_width, rtl), name);
+		for (int i = 0; i < NUM_COLUMNS; i++) {
+			Rect cell = line.Indent(this->name_width + i * (this->value_width + WidgetDimensions::scaled.hsep_wide) + WidgetDimensions::scaled.hsep_wide, rtl).WithWidth(this->value_width, rtl);
+			if (i == to_underlying(TickCostType::End)) {
+				DrawTime(cell, report.sampled_ticks == 0 ? 0 : report.companies[index].GetTotal() / report.sampled_ticks);
+			} else {
+				DrawTime(cell, report.GetAverage(index, static_cast<TickCostType>(i)));
+			}
+		}
+	}
+
+	void DrawWidget(const Rect &r, WidgetID widget) const override
+	{
+		const TickCostReport &report = TickCostAccounting::GetReport();
+		bool rtl = _current_text_dir == TD_RTL;
+		int line_height = GetCharacterHeight(FS_NORMAL);
+		Rect line = r.WithHeight(line_height);
+
+		switch (widget) {
+			case WID_TCW_COMPANIES: {
+				DrawString(line.WithWidth(this->name_width, rtl), STR_TICK_COST_COMPANY);
+				for (int i = 0; i < NUM_COLUMNS; i++) {
+					Rect cell = line.Indent(this->name_width + i * (this->value_width + WidgetDimensions::scaled.hsep_wide) + WidgetDimensions::scaled.hsep_wide, rtl).WithWidth(this->value_width, rtl);
+					DrawString(cell, STR_TICK_COST_TRAINS + i, TC_FROMSTRING, SA_RIGHT | SA_FORCE);
+				}
+				line = line.Translate(0, line_height + WidgetDimensions::scaled.vsep_normal);
+
+				for (const Company *c : Company::Iterate()) {
+					this->DrawCompanyRow(line, c->index.base(), GetString(STR_TICK_COST_COMPANY_NAME, c->index));
+					line = line.Translate(0, line_height);
+				}
+				this->DrawCompanyRow(line, TickCostReport::OTHER, GetString(STR_TICK_COST_OTHER));
+				break;
+			}
+
+			case WID_TCW_VEHICLES:
+				DrawString(line, STR_TICK_COST_TOP_VEHICLES);
+				line = line.Translate(0, line_height + WidgetDimensions::scaled.vsep_normal);
+				for (const TickCostVehicle &entry : report.top_vehicles) {
+					const Vehicle *v = Vehicle::GetIfValid(entry.id);
+					if (v == nullptr || v->owner != entry.owner) continue;
+					DrawString(line.Indent(this->value_width, !rtl), GetString(STR_TICK_COST_VEHICLE, v->index, v->owner));
+					DrawTime(line.WithWidth(this->value_width, !rtl), entry.ns / report.sampled_ticks);
+					line = line.Translate(0, line_height);
+				}
+				break;
+
+			case WID_TCW_GROUPS:
+				DrawString(line, STR_TICK_COST_TOP_GROUPS);
+				line = line.Translate(0, line_height + WidgetDimensions::scaled.vsep_normal);
+				for (const TickCostGroup &entry : report.top_groups) {
+					std::string name;
+					if (entry.id == DEFAULT_GROUP) {
+						name = GetString(STR_TICK_COST_GROUP_DEFAULT, entry.owner);
+					} else if (Group::IsValidID(entry.id)) {
+						name = GetString(STR_TICK_COST_GROUP, entry.id, entry.owner);
+					} else {
+						continue;
+					}
+					DrawString(line.Indent(this->value_width, !rtl), name);
+					DrawTime(line.WithWidth(this->value_width, !rtl), entry.ns / report.sampled_ticks);
+					line = line.Translate(0, line_height);
+				}
+				break;
+
+			case WID_TCW_INFO:
+				DrawString(line, GetString(STR_TICK_COST_DATA_POINTS, report.sampled_ticks, TickCostAccounting::PERIOD));
+				if (TickCostAccounting::GetThrottleBudget() != 0) {
+					DrawString(line.Translate(0, line_height), GetString(STR_TICK_COST_THROTTLE, TickCostAccounting::GetThrottleBudget() / 1000, 3));
+				}
+				break;
+		}
+	}
+
+	void OnClick([[maybe_unused]] Point pt, WidgetID widget, [[maybe_unused]] int click_count) override
+	{
+		if (widget != WID_TCW_VEHICLES) return;
+
+		/* Open the vehicle that was clicked; rows of vehicles that no longer exist are not drawn. */
+		int row = this->GetRowFromWidget(pt.y, widget, WidgetDimensions::scaled.vsep_normal, GetCharacterHeight(FS_NORMAL)) - 1;
+		if (row < 0) return;
+		for (const TickCostVehicle &entry : TickCostAccounting::GetReport().top_vehicles) {
+			const Vehicle *v = Vehicle::GetIfValid(entry.id);
+			if (v == nullptr || v->owner != entry.owner) continue;
+			if (row-- == 0) {
+				ShowVehicleViewWindow(v);
+				return;
+			}
+		}
+	}
+};
+
+static WindowDesc _tick_cost_window_desc(
+	WDP_AUTO, "tick_costs", 0, 0,
+	WC_TICK_COSTS, WC_NONE,
+	{},
+	_tick_cost_window_widgets
+);
+
+
+/** @hideinitializer */
+static constexpr NWidgetPart _memory_window_widgets[] = {
+	NWidget(NWID_HORIZONTAL),
+		NWidget(WWT_CLOSEBOX, COLOUR_GREY),
+		NWidget(WWT_CAPTION, COLOUR_GREY), SetStringTip(STR_MEMORY_CAPTION, STR_TOOLTIP_WINDOW_TITLE_DRAG_THIS),
+		NWidget(WWT_SHADEBOX, COLOUR_GREY),
+		NWidget(WWT_STICKYBOX, COLOUR_GREY),
+	EndContainer(),
+	NWidget(NWID_HORIZONTAL),
+		NWidget(WWT_PANEL, COLOUR_GREY, WID_MW_POOLS), SetScrollbar(WID_MW_SCROLLBAR), SetResize(0, 1), EndContainer(),
+		NWidget(NWID_VSCROLLBAR, COLOUR_GREY, WID_MW_SCROLLBAR),
+	EndContainer(),
+	NWidget(NWID_HORIZONTAL),
+		NWidget(WWT_PANEL, COLOUR_GREY, WID_MW_SUMMARY), SetFill(1, 0), EndContainer(),
+		NWidget(WWT_RESIZEBOX, COLOUR_GREY),
+	EndContainer(),
+};
+
+/** Window showing the memory used by the pools, caches and scripts. */
+struct MemoryWindow : Window {
+	static constexpr int NUM_COLUMNS = 5; ///< Value columns of the pool table.
+	static constexpr int NUM_SUMMARY_LINES = 6; ///< Lines of the summary, including the explanation.
+	static constexpr int MIN_ROWS = 10; ///< Number of pools visible without resizing.
+
+	MemoryStats stats{}; ///< The memory use that is shown.
+	int name_width = 0; ///< Width of the pool name column.
+	int value_width = 0; ///< Width of a value column.
+	Scrollbar *vscroll = nullptr; ///< Scrollbar of the pool table.
+
+	MemoryWindow(WindowDesc &desc, WindowNumber number) : Window(desc)
+	{
+		this->UpdateStats();
+		this->CreateNestedTree();
+		this->vscroll = this->GetScrollbar(WID_MW_SCROLLBAR);
+		this->vscroll->SetCount(this->stats.pools.size());
+		this->FinishInitNested(number);
+	}
+
+	/** Get the current memory use, biggest pools first. */
+	void UpdateStats()
+	{
+		this->stats = GetMemoryStats();
+		std::ranges::sort(this->stats.pools, std::greater{}, &PoolMemoryStats::bytes);
+	}
+
+	/** Update the window on a regular interval. */
+	const IntervalTimer<TimerWindow> update_interval = {std::chrono::seconds(1), [this](auto) {
+		this->UpdateStats();
+		this->vscroll->SetCount(this->stats.pools.size());
+		this->SetDirty();
+	}};
+
+	void UpdateWidgetSize(WidgetID widget, Dimension &size, [[maybe_unused]] const Dimension &padding, [[maybe_unused]] Dimension &fill, [[maybe_unused]] Dimension &resize) override
+	{
+		int line_height = GetCharacterHeight(FS_NORMAL);
+		switch (widget) {
+			case WID_MW_POOLS: {
+				Dimension name = GetStringBoundingBox(STR_MEMORY_POOL);
+				for (const PoolMemoryStats &pool : this->stats.pools) name = maxdim(name, GetStringBoundingBox(GetString(STR_MEMORY_POOL_NAME, pool.name)));
+				Dimension value = GetStringBoundingBox(GetString(STR_MEMORY_BYTES, GetParamMaxValue(1ULL << 40)));
+				value = maxdim(value, GetStringBoundingBox(GetString(STR_MEMORY_GROWTH_UP, GetParamMaxDigits(7))));
+				for (int i = 0; i < NUM_COLUMNS; i++) value = maxdim(value, GetStringBoundingBox(STR_MEMORY_ITEMS + i));
+
+				this->name_width = name.width;
+				this->value_width = value.width;
+				size.width = this->name_width + NUM_COLUMNS * (this->value_width + WidgetDimensions::scaled.hsep_wide) + WidgetDimensions::scaled.framerect.Horizontal();
+				size.height = (MIN_ROWS + 1) * line_height + WidgetDimensions::scaled.vsep_normal + WidgetDimensions::scaled.framerect.Vertical();
+				fill.height = resize.height = line_height;
+				break;
+			}
+
+			case WID_MW_SUMMARY:
+				size.height = NUM_SUMMARY_LINES * line_height + WidgetDimensions::scaled.framerect.Vertical();
+				break;
+		}
+	}
+
+	void OnResize() override
+	{
+		this->vscroll->SetCapacityFromWidget(this, WID_MW_POOLS, WidgetDimensions::scaled.framerect.Vertical() + GetCharacterHeight(FS_NORMAL) + WidgetDimensions::scaled.vsep_normal);
+	}
+
+	/**
+	 * Get the rectangle of a value column.
+	 * @param line Rectangle of the row.
+	 * @param column The column.
+	 * @return The rectangle of the cell.
+	 */
+	Rect GetCell(const Rect &line, int column) const
+	{
+		bool rtl = _current_text_dir == TD_RTL;
+		return line.Indent(this->name_width + column * (this->value_width + WidgetDimensions::scaled.hsep_wide) + WidgetDimensions::scaled.hsep_wide, rtl).WithWidth(this->value_width, rtl);
+	}
+
+	void DrawWidget(const Rect &r, WidgetID widget) const override
+	{
+		bool rtl = _current_text_dir == TD_RTL;
+		int line_height = GetCharacterHeight(FS_NORMAL);
+		Rect line = r.Shrink(WidgetDimensions::scaled.framerect).WithHeight(line_height);
+
+		switch (widget) {
+			case WID_MW_POOLS: {
+				DrawString(line.WithWidth(this->name_width, rtl), STR_MEMORY_POOL);
+				for (int i = 0; i < NUM_COLUMNS; i++) DrawString(this->GetCell(line, i), STR_MEMORY_ITEMS + i, TC_FROMSTRING, SA_RIGHT | SA_FORCE);
+				line = line.Translate(0, line_height + WidgetDimensions::scaled.vsep_normal);
+
+				auto [first, last] = this->vscroll->GetVisibleRangeIterators(this->stats.pools);
+				for (auto it = first; it != last; ++it) {
+					const PoolMemoryStats &pool = *it;
+					DrawString(line.WithWidth(this->name_width, rtl), GetString(STR_MEMORY_POOL_NAME, pool.name));
+					DrawString(this->GetCell(line, 0), GetString(STR_MEMORY_NUMBER, pool.items), TC_FROMSTRING, SA_RIGHT | SA_FORCE);
+					DrawString(this->GetCell(line, 1), GetString(STR_MEMORY_NUMBER, pool.used_range), TC_FROMSTRING, SA_RIGHT | SA_FORCE);
+					DrawString(this->GetCell(line, 2), GetString(STR_MEMORY_NUMBER, pool.capacity), TC_FROMSTRING, SA_RIGHT | SA_FORCE);
+					DrawString(this->GetCell(line, 3), GetString(STR_MEMORY_BYTES, pool.bytes), TC_FROMSTRING, SA_RIGHT | SA_FORCE);
+					StringID growth = pool.growth > 0 ? STR_MEMORY_GROWTH_UP : pool.growth < 0 ? STR_MEMORY_GROWTH_DOWN : STR_MEMORY_NUMBER;
+					DrawString(this->GetCell(line, 4), GetString(growth, pool.growth), TC_FROMSTRING, SA_RIGHT | SA_FORCE);
+					line = line.Translate(0, line_height);
+				}
+				break;
+			}
+
+			case WID_MW_SUMMARY:
+				DrawString(line, GetString(STR_MEMORY_SPRITE_CACHE, this->stats.sprite_cache_used, this->stats.sprite_cache_limit));
+				line = line.Translate(0, line_height);
+				DrawString(line, GetString(STR_MEMORY_SOUNDS, this->stats.sound_bytes));
+				line = line.Translate(0, line_height);
+				DrawString(line, GetString(STR_MEMORY_SCRIPTS, this->stats.ai_bytes, this->stats.game_script_bytes));
+				line = line.Translate(0, line_height);
+				DrawString(line, GetString(STR_MEMORY_LINK_GRAPH_JOBS, this->stats.link_graph_jobs, this->stats.link_graph_job_bytes));
+				line = line.Translate(0, line_height);
+				DrawString(line, GetString(STR_MEMORY_PROCESS, this->stats.process.resident, this->stats.process.peak_resident));
+				line = line.Translate(0, line_height);
+				DrawString(line, GetString(STR_MEMORY_INFO, this->stats.history_ticks));
+				break;
+		}
+	}
+};
+
+static WindowDesc _memory_window_desc(
+	WDP_AUTO, "memory", 0, 0,
+	WC_MEMORY, WC_NONE,
+	{},
+	_memory_window_widgets
+);
+
 /** Open the general framerate window */
 void ShowFramerateWindow()
 {
@@ -995,6 +1355,55 @@ void ShowFrametimeGraphWindow(PerformanceElement elem)
 	AllocateWindowDescFront<FrametimeGraphWindow>(_frametime_graph_window_desc, elem);
 }
 
+/** Open the window with the game loop costs per company. */
+void ShowTickCostWindow()
+{
+	AllocateWindowDescFront<TickCostWindow>(_tick_cost_window_desc, 0);
+}
+
+/** Open the window with the memory use of the pools, caches and scripts. */
+void ShowMemoryWindow()
+{
+	AllocateWindowDescFront<MemoryWindow>(_memory_window_desc, 0);
+}
+
+/**
+ * Add the current performance measurements to a JSON object, for automated benchmarks.
+ * Per element the number of measurements and their average duration is added, and for the
+ * elements with a rate (game loop, drawing and video output) also that rate.
+ * @param json The JSON object to fill.
+ */
+void SurveyFramerate(nlohmann::json &json)
+{
+	static const std::array<std::string_view, PFE_AI0> ELEMENT_KEYS = {
+		"gameloop",
+		"gl_economy",
+		"gl_trains",
+		"gl_roadvehs",
+		"gl_ships",
+		"gl_aircraft",
+		"gl_landscape",
+		"gl_linkgraph",
+		"drawing",
+		"drawworld",
+		"video",
+		"sound",
+		"allscripts",
+		"gamescript",
+	};
+
+	json = nlohmann::json::object();
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		auto &pf = _pf_data[e];
+		if (pf.num_valid == 0) continue;
+
+		nlohmann::json &element = json[e < PFE_AI0 ? std::string{ELEMENT_KEYS[e]} : fmt::format("ai{}", e - PFE_AI0)];
+		element["samples"] = pf.num_valid;
+		element["average_ms"] = pf.GetAverageDurationMilliseconds(pf.num_valid);
+		if (e == PFE_GAMELOOP || e == PFE_DRAWING || e == PFE_VIDEO) element["rate"] = pf.GetRate();
+	}
+}
+
 /** Print performance statistics to game console */
 void ConPrintFramerate()
 {
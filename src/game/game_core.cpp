@@ -14,6 +14,8 @@
 #include "../network/network.h"
 #include "../window_func.h"
 #include "../framerate_type.h"
+#include "../allocation_tracker.h"
+#include "../scope_profiler.h"
 #include "game.hpp"
 #include "game_scanner.hpp"
 #include "game_config.hpp"
@@ -40,6 +42,8 @@
 	}
 
 	PerformanceMeasurer framerate(PFE_GAMESCRIPT);
+	ProfileScope profile("GameScript");
+	AllocationScope allocations(AllocationTag::Scripts);
 
 	Game::frame_counter++;
 
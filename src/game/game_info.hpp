@@ -42,6 +42,8 @@ public:
 
 	bool IsDeveloperOnly() const override { return this->is_developer_only; }
 
+	std::unique_ptr<ScriptInfo> Clone() const override { return std::make_unique<GameInfo>(*this); }
+
 private:
 	int min_loadable_version; ///< The Game can load savegame data if the version is equal or greater than this.
 	bool is_developer_only;   ///< Is the script selectable by non-developers?
@@ -68,6 +70,8 @@ public:
 	 */
 	const std::string &GetCategory() const { return this->category; }
 
+	std::unique_ptr<ScriptInfo> Clone() const override { return std::make_unique<GameLibrary>(*this); }
+
 private:
 	std::string category; ///< The category this library is in.
 };
@@ -24,6 +24,7 @@
 #include "core/container_func.hpp"
 #include "core/geometry_func.hpp"
 #include "viewport_func.h"
+#include "scope_profiler.h"
 
 #include "table/string_colours.h"
 #include "table/sprites.h"
@@ -1437,6 +1438,8 @@ void RedrawScreenRect(int left, int top, int right, int bottom)
  */
 void DrawDirtyBlocks()
 {
+	ProfileScope profile("DrawDirtyBlocks");
+
 	auto is_dirty = [](auto block) -> bool { return block != 0; };
 	auto block = _dirty_blocks.begin();
 
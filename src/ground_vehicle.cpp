@@ -15,31 +15,34 @@
 #include "safeguards.h"
 
 /**
- * Recalculates the cached total power of a vehicle. Should be called when the consist is changed.
+ * Add the power related properties of a part of the consist to the totals.
+ * @param totals The totals to add to.
+ * @param u The part to add.
+ * @param weight The current weight of the part.
  */
 template <class T, VehicleType Type>
-void GroundVehicle<T, Type>::PowerChanged()
+void GroundVehicle<T, Type>::AddPartPower(PowerTotals &totals, const T *u, uint16_t weight) const
 {
-	assert(this->First() == this);
-	const T *v = T::From(this);
+	uint32_t current_power = u->GetPower() + u->GetPoweredPartPower(u);
+	totals.total_power += current_power;
 
-	uint32_t total_power = 0;
-	uint32_t max_te = 0;
-	uint32_t number_of_parts = 0;
-	uint16_t max_track_speed = this->vcache.cached_max_speed; // Max track speed in internal units.
+	/* Only powered parts add tractive effort. */
+	if (current_power > 0) totals.max_te += weight * u->GetTractiveEffort();
+	totals.number_of_parts++;
 
-	for (const T *u = v; u != nullptr; u = u->Next()) {
-		uint32_t current_power = u->GetPower() + u->GetPoweredPartPower(u);
-		total_power += current_power;
-
-		/* Only powered parts add tractive effort. */
-		if (current_power > 0) max_te += u->GetWeight() * u->GetTractiveEffort();
-		number_of_parts++;
+	/* Get minimum max speed for this track. */
+	uint16_t track_speed = u->GetMaxTrackSpeed();
+	if (track_speed > 0) totals.max_track_speed = std::min(totals.max_track_speed, track_speed);
+}
 
-		/* Get minimum max speed for this track. */
-		uint16_t track_speed = u->GetMaxTrackSpeed();
-		if (track_speed > 0) max_track_speed = std::min(max_track_speed, track_speed);
-	}
+/**
+ * Update the cached power, tractive effort, air drag and max track speed from the totals of the consist.
+ * @param totals The totals of all parts of the consist.
+ */
+template <class T, VehicleType Type>
+void GroundVehicle<T, Type>::UpdatePowerCache(const PowerTotals &totals)
+{
+	const T *v = T::From(this);
 
 	uint8_t air_drag;
 	uint8_t air_drag_value = v->GetAirDrag();
@@ -54,26 +57,46 @@ void GroundVehicle<T, Type>::PowerChanged()
 		air_drag = (air_drag_value == 1) ? 0 : air_drag_value;
 	}
 
-	this->gcache.cached_air_drag = air_drag + 3 * air_drag * number_of_parts / 20;
+	this->gcache.cached_air_drag = air_drag + 3 * air_drag * totals.number_of_parts / 20;
 
+	uint32_t max_te = totals.max_te;
 	max_te *= GROUND_ACCELERATION; // Tractive effort in (tonnes * 1000 * 9.8 =) N.
 	max_te /= 256;  // Tractive effort is a [0-255] coefficient.
-	if (this->gcache.cached_power != total_power || this->gcache.cached_max_te != max_te) {
+	if (this->gcache.cached_power != totals.total_power || this->gcache.cached_max_te != max_te) {
 		/* Stop the vehicle if it has no power. */
-		if (total_power == 0) this->vehstatus.Set(VehState::Stopped);
+		if (totals.total_power == 0) this->vehstatus.Set(VehState::Stopped);
 
-		this->gcache.cached_power = total_power;
+		this->gcache.cached_power = totals.total_power;
 		this->gcache.cached_max_te = max_te;
 		SetWindowDirty(WC_VEHICLE_DETAILS, this->index);
 		SetWindowWidgetDirty(WC_VEHICLE_VIEW, this->index, WID_VV_START_STOP);
 	}
 
-	this->gcache.cached_max_track_speed = max_track_speed;
+	this->gcache.cached_max_track_speed = totals.max_track_speed;
+}
+
+/**
+ * Recalculates the cached total power of a vehicle. Should be called when the consist is changed.
+ */
+template <class T, VehicleType Type>
+void GroundVehicle<T, Type>::PowerChanged()
+{
+	assert(this->First() == this);
+
+	PowerTotals totals;
+	totals.max_track_speed = this->vcache.cached_max_speed; // Max track speed in internal units.
+	for (const T *u = T::From(this); u != nullptr; u = u->Next()) {
+		this->AddPartPower(totals, u, u->GetWeight());
+	}
+
+	this->UpdatePowerCache(totals);
 }
 
 /**
  * Recalculates the cached weight of a vehicle and its parts. Should be called each time the cargo on
  * the consist changes.
+ * The power is updated in the same pass over the consist, as the tractive effort depends on the
+ * weight. This saves walking the consist twice and querying the weight of every part twice.
  */
 template <class T, VehicleType Type>
 void GroundVehicle<T, Type>::CargoChanged()
@@ -81,11 +104,15 @@ void GroundVehicle<T, Type>::CargoChanged()
 	assert(this->First() == this);
 	uint32_t weight = 0;
 
+	PowerTotals totals;
+	totals.max_track_speed = this->vcache.cached_max_speed; // Max track speed in internal units.
 	for (T *u = T::From(this); u != nullptr; u = u->Next()) {
-		uint32_t current_weight = u->GetWeight();
+		uint16_t current_weight = u->GetWeight();
 		weight += current_weight;
 		/* Slope steepness is in percent, result in N. */
 		u->gcache.cached_slope_resistance = current_weight * u->GetSlopeSteepness() * 100;
+
+		this->AddPartPower(totals, u, current_weight);
 	}
 
 	/* Store consist weight in cache. */
@@ -94,7 +121,7 @@ void GroundVehicle<T, Type>::CargoChanged()
 	this->gcache.cached_axle_resistance = 10 * weight;
 
 	/* Now update vehicle power (tractive effort is dependent on weight). */
-	this->PowerChanged();
+	this->UpdatePowerCache(totals);
 }
 
 /**
@@ -349,6 +349,17 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	}
 
 protected:
+	/** Totals of the properties of the parts that determine the power related caches. */
+	struct PowerTotals {
+		uint32_t total_power = 0; ///< Sum of the power of all parts.
+		uint32_t max_te = 0; ///< Sum of weight times tractive effort coefficient of all powered parts.
+		uint32_t number_of_parts = 0; ///< Number of parts in the consist.
+		uint16_t max_track_speed = 0; ///< Minimum of the max track speed of all parts.
+	};
+
+	void AddPartPower(PowerTotals &totals, const T *u, uint16_t weight) const;
+	void UpdatePowerCache(const PowerTotals &totals);
+
 	/**
 	 * Update the speed of the vehicle.
 	 *
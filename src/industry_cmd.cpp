@@ -49,6 +49,8 @@
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_economy.h"
 #include "timer/timer_game_tick.h"
+#include "allocation_tracker.h"
+#include "scope_profiler.h"
 
 #include "table/strings.h"
 #include "table/industry_land.h"
@@ -1244,6 +1246,8 @@ void OnTick_Industry()
 	if (_game_mode == GM_EDITOR) return;
 
 	for (Industry *i : Industry::Iterate()) {
+		ProfileScope profile("Industry", i->index.base());
+		AllocationScope allocations(AllocationTag::Industries);
 		ProduceIndustryGoods(i);
 	}
 }
@@ -35,6 +35,8 @@
 #include "pathfinder/aystar.h"
 #include "saveload/saveload.h"
 #include "framerate_type.h"
+#include "allocation_tracker.h"
+#include "scope_profiler.h"
 #include "landscape_cmd.h"
 #include "terraform_cmd.h"
 #include "station_func.h"
@@ -760,6 +762,8 @@ TileIndex _cur_tileloop_tile;
 void RunTileLoop()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	ProfileScope profile("RunTileLoop");
+	AllocationScope allocations(AllocationTag::Landscape);
 
 	/* The pseudorandom sequence of tiles is generated using a Galois linear feedback
 	 * shift register (LFSR). This allows a deterministic pseudorandom ordering, but
@@ -3,12 +3,130 @@
 #include "../stdafx.h"
 #include "demands.h"
 #include "../core/math_func.hpp"
+#include "../thread.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <queue>
 
 #include "../safeguards.h"
 
 typedef std::queue<NodeID> NodeList;
 
+/** Minimum number of entries in a block of the table of precalculated divisors, i.e. the work a thread gets at once. */
+static constexpr size_t MIN_DIVISOR_BLOCK_SIZE = 1U << 16;
+/** Largest number of threads that calculate divisors, including the thread of the link graph job. */
+static constexpr uint MAX_DEMAND_THREADS = 4;
+
+/**
+ * Threads helping the link graph jobs with calculating their tables of divisors.
+ * They are shared by all jobs, so the number of threads stays bounded however many jobs run at
+ * the same time. A job works on its own table as well, so it never waits for threads that are
+ * busy with the table of another job.
+ */
+class DemandWorkerPool {
+public:
+	/**
+	 * Get the pool, starting its threads on first use.
+	 * @return The pool.
+	 */
+	static DemandWorkerPool &Get()
+	{
+		static DemandWorkerPool pool;
+		return pool;
+	}
+
+	void Run(size_t count, const std::function<void(size_t)> &proc);
+
+private:
+	/** Share of the work of a #Run for one worker. */
+	struct Share {
+		std::function<void()> work; ///< Work to do.
+		size_t *pending; ///< Number of shares of the run that are not finished yet, guarded by #lock.
+	};
+
+	std::mutex lock; ///< Lock for everything below.
+	std::condition_variable work_available; ///< Signalled when shares are added, or the pool stops.
+	std::condition_variable share_done; ///< Signalled when the last pending share of a run is finished.
+	std::deque<Share> shares; ///< Shares no worker picked up yet.
+	std::vector<std::thread> threads; ///< The workers.
+	bool exit = false; ///< Whether the workers have to stop.
+
+	DemandWorkerPool();
+	~DemandWorkerPool();
+	void Work();
+};
+
+/** Start the workers. */
+DemandWorkerPool::DemandWorkerPool()
+{
+	uint num_threads = std::clamp(std::thread::hardware_concurrency(), 1U, MAX_DEMAND_THREADS);
+	for (uint i = 1; i < num_threads; i++) {
+		if (!StartNewThread(&this->threads.emplace_back(), "ottd:demands", [this]() { this->Work(); })) this->threads.pop_back();
+	}
+}
+
+/** Stop the workers. */
+DemandWorkerPool::~DemandWorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->exit = true;
+	}
+	this->work_available.notify_all();
+	for (std::thread &thread : this->threads) thread.join();
+}
+
+/** Do shares of work until the pool stops. */
+void DemandWorkerPool::Work()
+{
+	std::unique_lock<std::mutex> guard(this->lock);
+	for (;;) {
+		this->work_available.wait(guard, [this]() { return this->exit || !this->shares.empty(); });
+		if (this->exit) return;
+
+		Share share = std::move(this->shares.front());
+		this->shares.pop_front();
+		guard.unlock();
+		share.work();
+		guard.lock();
+		if (--*share.pending == 0) this->share_done.notify_all();
+	}
+}
+
+/**
+ * Call a function for a number of items, with the help of the workers, and wait until it is done for all of them.
+ * The calling thread works as well, so this finishes even if all workers are busy.
+ * @param count Number of items.
+ * @param proc Function to call with the index of every item.
+ */
+void DemandWorkerPool::Run(size_t count, const std::function<void(size_t)> &proc)
+{
+	std::atomic<size_t> next = 0;
+	auto work = [&next, count, &proc]() {
+		for (size_t i = next++; i < count; i = next++) proc(i);
+	};
+
+	size_t pending = 0;
+	size_t helpers = 0;
+	if (count > 1) {
+		std::lock_guard<std::mutex> guard(this->lock);
+		helpers = std::min(count - 1, this->threads.size());
+		for (size_t i = 0; i < helpers; i++) this->shares.push_back({work, &pending});
+		pending = helpers;
+	}
+	if (helpers != 0) this->work_available.notify_all();
+
+	work();
+
+	if (helpers == 0) return;
+	std::unique_lock<std::mutex> guard(this->lock);
+	/* Shares that no worker picked up yet have nothing left to do. */
+	pending -= std::erase_if(this->shares, [&pending](const Share &share) { return share.pending == &pending; });
+	this->share_done.wait(guard, [&pending]() { return pending == 0; });
+}
+
 /**
  * Scale various things according to symmetric/asymmetric distribution.
  */
@@ -169,15 +287,23 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 	uint num_supplies = 0;
 	uint num_demands = 0;
 
+	/* Rows and columns of the nodes in the divisor table. */
+	std::vector<NodeID> supply_nodes;
+	std::vector<NodeID> demand_nodes;
+	std::vector<uint> rows(job.Size(), UINT_MAX);
+	std::vector<uint> columns(job.Size(), UINT_MAX);
+
 	for (NodeID node = 0; node < job.Size(); node++) {
 		scaler.AddNode(job[node]);
 		if (job[node].base.supply > 0) {
 			supplies.push(node);
-			num_supplies++;
+			rows[node] = num_supplies++;
+			supply_nodes.push_back(node);
 		}
 		if (job[node].base.demand > 0) {
 			demands.push(node);
-			num_demands++;
+			columns[node] = num_demands++;
+			demand_nodes.push_back(node);
 		}
 	}
 
@@ -189,9 +315,20 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 	scaler.SetDemandPerNode(num_demands);
 	uint chance = 0;
 
+	/* The divisors only depend on the positions of the nodes, unlike the
+	 * distribution itself. Every step of the loop below takes from the
+	 * undelivered supply of the supplying node and, in symmetric distribution,
+	 * from that of the accepting node, and whether a node is visited again
+	 * depends on what is left of it. So the steps have to be done one by one
+	 * and in order to get the same demands every time. */
+	const DivisorTable table = this->CalcDivisors(job, supply_nodes, demand_nodes);
+	/* Without distance modifier all nodes are at the same distance. */
+	const int32_t constant_divisor = this->mod_dist > 0 ? 0 : this->CalcDivisor(0);
+
 	while (!supplies.empty() && !demands.empty()) {
 		NodeID from_id = supplies.front();
 		supplies.pop();
+		const int32_t *row_divisors = table.GetRow(rows[from_id]);
 
 		for (uint i = 0; i < num_demands; ++i) {
 			assert(!demands.empty());
@@ -208,26 +345,15 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 			int32_t supply = scaler.EffectiveSupply(job[from_id], job[to_id]);
 			assert(supply > 0);
 
-			constexpr int32_t divisor_scale = 16;
-
-			int32_t scaled_distance = this->base_distance;
-			if (this->mod_dist > 0) {
-				const int32_t distance = DistanceMaxPlusManhattan(job[from_id].base.xy, job[to_id].base.xy);
-				/* Scale distance around base_distance by (mod_dist * (100 / 1024)).
-				 * mod_dist may be > 1024, so clamp result to be non-negative */
-				scaled_distance = std::max(0, this->base_distance + (((distance - this->base_distance) * this->mod_dist) / 1024));
-			}
-
-			/* Scale the accuracy by distance around accuracy / 2 */
-			const int32_t divisor = divisor_scale + ((this->accuracy * scaled_distance * divisor_scale) / (this->base_distance * 2));
-			assert(divisor >= divisor_scale);
+			const int32_t divisor = row_divisors != nullptr ? row_divisors[columns[to_id]] : constant_divisor;
+			assert(divisor >= DIVISOR_SCALE);
 
 			uint demand_forw = 0;
-			if (divisor <= (supply * divisor_scale)) {
+			if (divisor <= (supply * DIVISOR_SCALE)) {
 				/* At first only distribute demand if
 				 * effective supply / accuracy divisor >= 1
 				 * Others are too small or too far away to be considered. */
-				demand_forw = (supply * divisor_scale) / divisor;
+				demand_forw = (supply * DIVISOR_SCALE) / divisor;
 			} else if (++chance > this->accuracy * num_demands * num_supplies) {
 				/* After some trying, if there is still supply left, distribute
 				 * demand also to other nodes. */
@@ -255,6 +381,81 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 	}
 }
 
+/**
+ * Calculate the accuracy divisor for a pair of nodes.
+ * @param distance Distance between the nodes.
+ * @return Divisor, scaled by DIVISOR_SCALE.
+ */
+inline int32_t DemandCalculator::CalcDivisor(int32_t distance) const
+{
+	int32_t scaled_distance = this->base_distance;
+	if (this->mod_dist > 0) {
+		/* Scale distance around base_distance by (mod_dist * (100 / 1024)).
+		 * mod_dist may be > 1024, so clamp result to be non-negative */
+		scaled_distance = std::max(0, this->base_distance + (((distance - this->base_distance) * this->mod_dist) / 1024));
+	}
+
+	/* Scale the accuracy by distance around accuracy / 2 */
+	return DIVISOR_SCALE + ((this->accuracy * scaled_distance * DIVISOR_SCALE) / (this->base_distance * 2));
+}
+
+/**
+ * Calculate the accuracy divisors between all supplying and all accepting
+ * nodes. Every block of rows is calculated on its own by one of the threads of
+ * the #DemandWorkerPool, and the blocks are kept in the order of their rows, so
+ * the table is the same however many threads calculated it. The coordinates of
+ * the accepting nodes are kept in contiguous arrays so the inner loop can be
+ * vectorised.
+ * The table is not limited in size: it takes at most half the memory of the
+ * demand annotations the job already keeps for every pair of nodes, and it is
+ * split in blocks so it never needs one large allocation.
+ * @param job Job to calculate the divisors for.
+ * @param supply_nodes Supplying nodes, one per row.
+ * @param demand_nodes Accepting nodes, one per column.
+ * @return The table, or an empty table if all nodes are at the same distance.
+ */
+DemandCalculator::DivisorTable DemandCalculator::CalcDivisors(LinkGraphJob &job, const std::vector<NodeID> &supply_nodes, const std::vector<NodeID> &demand_nodes) const
+{
+	DivisorTable table;
+	const size_t num_rows = supply_nodes.size();
+	const size_t num_columns = demand_nodes.size();
+	/* Without distance modifier all divisors are the same. */
+	if (this->mod_dist == 0) return table;
+
+	std::vector<int32_t> xs(num_columns);
+	std::vector<int32_t> ys(num_columns);
+	for (size_t column = 0; column < num_columns; ++column) {
+		TileIndex xy = job[demand_nodes[column]].base.xy;
+		xs[column] = TileX(xy);
+		ys[column] = TileY(xy);
+	}
+
+	table.num_columns = num_columns;
+	table.rows_per_block = std::max<size_t>(1, MIN_DIVISOR_BLOCK_SIZE / num_columns);
+	table.blocks.resize((num_rows + table.rows_per_block - 1) / table.rows_per_block);
+
+	DemandWorkerPool::Get().Run(table.blocks.size(), [&](size_t block) {
+		const size_t first = block * table.rows_per_block;
+		const size_t last = std::min(first + table.rows_per_block, num_rows);
+		std::vector<int32_t> &out = table.blocks[block];
+		out.resize((last - first) * num_columns);
+		int32_t *divisor = out.data();
+		for (size_t row = first; row < last; ++row) {
+			TileIndex from = job[supply_nodes[row]].base.xy;
+			const int32_t x = TileX(from);
+			const int32_t y = TileY(from);
+			for (size_t column = 0; column < num_columns; ++column) {
+				/* Same as DistanceMaxPlusManhattan(). */
+				const int32_t dx = std::abs(x - xs[column]);
+				const int32_t dy = std::abs(y - ys[column]);
+				*divisor++ = this->CalcDivisor(std::max(dx, dy) + dx + dy);
+			}
+		}
+	});
+
+	return table;
+}
+
 /**
  * Create the DemandCalculator and immediately do the calculation.
  * @param job Job to calculate the demands for.
@@ -18,6 +18,29 @@ private:
 	int32_t mod_dist;      ///< Distance modifier, determines how much demands decrease with distance.
 	int32_t accuracy;      ///< Accuracy of the calculation.
 
+	static constexpr int32_t DIVISOR_SCALE = 16; ///< Scale of the accuracy divisors.
+
+	/** Accuracy divisors between all supplying and all accepting nodes, in blocks of rows that are calculated independently. */
+	struct DivisorTable {
+		size_t rows_per_block = 0; ///< Number of rows in every block.
+		size_t num_columns = 0; ///< Number of entries in every row.
+		std::vector<std::vector<int32_t>> blocks; ///< The blocks, in order of their rows.
+
+		/**
+		 * Get the divisors of a supplying node.
+		 * @param row Row of the supplying node.
+		 * @return The divisors towards the accepting nodes, or nullptr if the table is empty.
+		 */
+		inline const int32_t *GetRow(size_t row) const
+		{
+			if (this->blocks.empty()) return nullptr;
+			return this->blocks[row / this->rows_per_block].data() + (row % this->rows_per_block) * this->num_columns;
+		}
+	};
+
+	int32_t CalcDivisor(int32_t distance) const;
+	DivisorTable CalcDivisors(LinkGraphJob &job, const std::vector<NodeID> &supply_nodes, const std::vector<NodeID> &demand_nodes) const;
+
 	template <class Tscaler>
 	void CalcDemand(LinkGraphJob &job, Tscaler scaler);
 };
@@ -55,8 +55,8 @@ void FlowMapper::Run(LinkGraphJob &job) const
 				it.second.ScaleToMonthly(runtime.base());
 			}
 		}
-		/* Clear paths. */
-		for (Path *i : node.paths) delete i;
-		node.paths.clear();
 	}
+
+	/* Clear paths. */
+	job.ClearPaths();
 }
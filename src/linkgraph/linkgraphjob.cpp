@@ -10,6 +10,7 @@
 #include "../stdafx.h"
 #include "../core/pool_func.hpp"
 #include "../window_func.h"
+#include "../allocation_tracker.h"
 #include "linkgraphjob.h"
 #include "linkgraphschedule.h"
 
@@ -99,6 +100,8 @@ LinkGraphJob::~LinkGraphJob()
 	/* Link graph has been merged into another one. */
 	if (!LinkGraph::IsValidID(this->link_graph.index)) return;
 
+	/* Attribute the flow maps of the stations to the link graph. */
+	AllocationScope allocations(AllocationTag::LinkGraph);
 	uint16_t size = this->Size();
 	for (NodeID node_id = 0; node_id < size; ++node_id) {
 		NodeAnnotation &from = this->nodes[node_id];
@@ -188,6 +191,70 @@ void LinkGraphJob::Init()
 	}
 }
 
+/**
+ * Create a new path for this job. Paths are allocated in blocks owned by the
+ * job, so running the solvers does not allocate memory for every single leg.
+ * @param node Id of the link graph node the path passes.
+ * @param source If true, this is the first leg of the path.
+ * @return The new path.
+ */
+Path *LinkGraphJob::CreatePath(NodeID node, bool source)
+{
+	Path *path;
+	if (!this->free_paths.empty()) {
+		path = this->free_paths.back();
+		this->free_paths.pop_back();
+	} else {
+		if (this->path_block_used == PATH_BLOCK_SIZE) {
+			this->path_blocks.push_back(std::make_unique<Path[]>(PATH_BLOCK_SIZE));
+			this->path_block_used = 0;
+			this->path_block_count.store(this->path_blocks.size(), std::memory_order_relaxed);
+		}
+		path = &this->path_blocks.back()[this->path_block_used++];
+	}
+	*path = Path(node, source);
+	return path;
+}
+
+/**
+ * Return a path to the job, so it can be reused.
+ * @param path Path created by #CreatePath that is not used anymore.
+ */
+void LinkGraphJob::FreePath(Path *path)
+{
+	this->free_paths.push_back(path);
+}
+
+/**
+ * Release the memory of all paths of this job, and forget all paths through its nodes.
+ */
+void LinkGraphJob::ClearPaths()
+{
+	for (NodeAnnotation &node : this->nodes) node.paths.clear();
+	this->path_blocks.clear();
+	this->path_block_used = PATH_BLOCK_SIZE;
+	this->path_block_count.store(0, std::memory_order_relaxed);
+	this->free_paths.clear();
+}
+
+/**
+ * Estimate the memory used by this job. Only looks at data the job thread does not change,
+ * so it can be called while the job runs. Flows and other containers that grow during the
+ * calculation are not included.
+ * @return Number of bytes.
+ */
+size_t LinkGraphJob::GetMemoryUsage() const
+{
+	size_t nodes = this->link_graph.Size();
+	size_t edges = 0;
+	for (NodeID i = 0; i < nodes; i++) edges += this->link_graph[i].edges.size();
+
+	size_t graph = nodes * sizeof(LinkGraph::BaseNode) + edges * sizeof(LinkGraph::BaseEdge);
+	size_t annotations = nodes * (sizeof(NodeAnnotation) + nodes * sizeof(DemandAnnotation)) + edges * sizeof(EdgeAnnotation);
+	size_t paths = this->path_block_count.load(std::memory_order_relaxed) * PATH_BLOCK_SIZE * sizeof(Path);
+	return sizeof(LinkGraphJob) + graph + annotations + paths;
+}
+
 /**
  * Add this path as a new child to the given base path, thus making this path
  * a "fork" of the base path.
@@ -167,6 +167,12 @@ protected:
 	std::atomic<bool> job_completed = false; ///< Is the job still running. This is accessed by multiple threads and reads may be stale.
 	std::atomic<bool> job_aborted = false; ///< Has the job been aborted. This is accessed by multiple threads and reads may be stale.
 
+	static constexpr size_t PATH_BLOCK_SIZE = 1024; ///< Number of paths allocated at once.
+	std::vector<std::unique_ptr<Path[]>> path_blocks{}; ///< Storage of all paths of this job.
+	size_t path_block_used = PATH_BLOCK_SIZE; ///< Number of paths handed out from the last block in #path_blocks.
+	std::atomic<size_t> path_block_count = 0; ///< Number of blocks in #path_blocks, readable from other threads.
+	std::vector<Path *> free_paths{}; ///< Paths in #path_blocks that have been freed and can be reused.
+
 	void EraseFlows(NodeID from);
 	void JoinThread();
 	void SpawnThread();
@@ -182,6 +188,11 @@ public:
 	~LinkGraphJob();
 
 	void Init();
+	size_t GetMemoryUsage() const;
+
+	Path *CreatePath(NodeID node, bool source = false);
+	void FreePath(Path *path);
+	void ClearPaths();
 
 	/**
 	 * Check if job has actually finished.
@@ -274,8 +285,8 @@ class Path {
 public:
 	static Path *invalid_path;
 
+	Path() = default;
 	Path(NodeID n, bool source = false);
-	virtual ~Path() = default;
 
 	/** Get the node this leg passes. */
 	inline NodeID GetNode() const { return this->node; }
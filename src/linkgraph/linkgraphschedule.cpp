@@ -14,9 +14,12 @@
 #include "mcf.h"
 #include "flowmapper.h"
 #include "../framerate_type.h"
+#include "../allocation_tracker.h"
+#include "../scope_profiler.h"
 #include "../command_func.h"
 #include "../network/network.h"
 #include "../misc_cmd.h"
+#include "../debug.h"
 
 #include "../safeguards.h"
 
@@ -86,9 +89,20 @@ void LinkGraphSchedule::JoinNext()
  */
 /* static */ void LinkGraphSchedule::Run(LinkGraphJob *job)
 {
-	for (const auto &handler : instance.handlers) {
+	/* Names of the handlers, in the order they are run, for the timing output. */
+	static const std::array<std::string_view, 6> handler_names = {"init", "demands", "mcf1", "flowmapper1", "mcf2", "flowmapper2"};
+	static_assert(std::tuple_size_v<decltype(handler_names)> == std::tuple_size_v<decltype(instance.handlers)>);
+
+	ProfileScope profile("LinkGraphJob", job->LinkGraphIndex().base());
+	AllocationScope allocations(AllocationTag::LinkGraph);
+	for (size_t i = 0; i < instance.handlers.size(); ++i) {
 		if (job->IsJobAborted()) return;
-		handler->Run(*job);
+
+		ProfileScope profile_handler(handler_names[i], job->LinkGraphIndex().base());
+		auto start = std::chrono::steady_clock::now();
+		instance.handlers[i]->Run(*job);
+		Debug(linkgraph, 2, "Link graph {} ({} nodes): {} took {} us", job->LinkGraphIndex(), job->Size(), handler_names[i],
+				std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 	}
 
 	/*
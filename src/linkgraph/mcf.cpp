@@ -9,40 +9,53 @@
 
 typedef std::map<NodeID, Path *> PathViaMap;
 
+/**
+ * Relation that creates a weak order without duplicates.
+ * Avoid accidentally deleting different paths of the same capacity/distance in
+ * a set. When the annotation is the same node IDs are compared, so there are
+ * no equal ranges.
+ * @tparam T Type to be compared on.
+ * @param x_anno First value.
+ * @param y_anno Second value.
+ * @param x Node id associated with the first value.
+ * @param y Node id associated with the second value.
+ */
+template <typename T>
+bool Greater(T x_anno, T y_anno, NodeID x, NodeID y)
+{
+	if (x_anno > y_anno) return true;
+	if (x_anno < y_anno) return false;
+	return x > y;
+}
+
 /**
  * Distance-based annotation for use in the Dijkstra algorithm. This is close
  * to the original meaning of "annotation" in this context. Paths are rated
  * according to the sum of distances of their edges.
  */
-class DistanceAnnotation : public Path {
+class DistanceAnnotation {
 public:
-
-	/**
-	 * Constructor.
-	 * @param n ID of node to be annotated.
-	 * @param source If the node is the source of its path.
-	 */
-	DistanceAnnotation(NodeID n, bool source = false) : Path(n, source) {}
-
-	bool IsBetter(const DistanceAnnotation *base, uint cap, int free_cap, uint dist) const;
+	static bool IsBetter(const Path &path, const Path &base, uint cap, int free_cap, uint dist);
 
 	/**
 	 * Return the actual value of the annotation, in this case the distance.
+	 * @param path Path to get the annotation of.
 	 * @return Distance.
 	 */
-	inline uint GetAnnotation() const { return this->distance; }
+	static inline uint GetAnnotation(const Path &path) { return path.GetDistance(); }
 
 	/**
-	 * Update the cached annotation value
+	 * Determine whether a node with the given annotation is to be visited before another.
+	 * @param x First annotation.
+	 * @param y Second annotation.
+	 * @param x_node Node associated with the first annotation.
+	 * @param y_node Node associated with the second annotation.
+	 * @return True if the shorter distance is x's.
 	 */
-	inline void UpdateAnnotation() { }
-
-	/**
-	 * Comparator for std containers.
-	 */
-	struct Comparator {
-		bool operator()(const DistanceAnnotation *x, const DistanceAnnotation *y) const;
-	};
+	static inline bool Before(uint x, uint y, NodeID x_node, NodeID y_node)
+	{
+		return !Greater<uint>(x, y, x_node, y_node);
+	}
 };
 
 /**
@@ -51,40 +64,154 @@ public:
  * algorithm still gives meaningful results like this as the capacity of a path
  * can only decrease or stay the same if you add more edges.
  */
-class CapacityAnnotation : public Path {
-	int cached_annotation = 0;
-
+class CapacityAnnotation {
 public:
+	static bool IsBetter(const Path &path, const Path &base, uint cap, int free_cap, uint dist);
 
 	/**
-	 * Constructor.
-	 * @param n ID of node to be annotated.
-	 * @param source If the node is the source of its path.
+	 * Return the actual value of the annotation, in this case the capacity.
+	 * @param path Path to get the annotation of.
+	 * @return Capacity.
 	 */
-	CapacityAnnotation(NodeID n, bool source = false) : Path(n, source) {}
+	static inline int GetAnnotation(const Path &path) { return path.GetCapacityRatio(); }
 
-	bool IsBetter(const CapacityAnnotation *base, uint cap, int free_cap, uint dist) const;
+	/**
+	 * Determine whether a node with the given annotation is to be visited before another.
+	 * @param x First annotation.
+	 * @param y Second annotation.
+	 * @param x_node Node associated with the first annotation.
+	 * @param y_node Node associated with the second annotation.
+	 * @return True if the higher capacity is x's.
+	 */
+	static inline bool Before(int x, int y, NodeID x_node, NodeID y_node)
+	{
+		return Greater<int>(x, y, x_node, y_node);
+	}
+};
 
+/**
+ * Priority queue of the nodes to visit in the Dijkstra algorithm. It is a
+ * 4-ary heap on the annotations of the nodes' paths, which also keeps track
+ * of where each node is in the heap, so a node's annotation can be changed
+ * without searching for it.
+ * @tparam Tannotation Annotation to order the nodes by.
+ */
+template <class Tannotation>
+class DijkstraQueue {
+	using Key = decltype(Tannotation::GetAnnotation(std::declval<const Path &>()));
+
+	/** Entry in the heap. */
+	struct Entry {
+		Key key; ///< Annotation of the node's path when it was queued.
+		NodeID node; ///< The queued node.
+	};
+
+	static constexpr size_t ARITY = 4; ///< Number of children of each heap entry.
+	static constexpr size_t NOT_QUEUED = SIZE_MAX; ///< Position of nodes that are not in the heap.
+
+	std::vector<Entry> heap; ///< The heap itself.
+	std::vector<size_t> position; ///< Position of each node in #heap, or #NOT_QUEUED.
+
+public:
 	/**
-	 * Return the actual value of the annotation, in this case the capacity.
-	 * @return Capacity.
+	 * Create an empty queue.
+	 * @param size Number of nodes in the link graph.
 	 */
-	inline int GetAnnotation() const { return this->cached_annotation; }
+	DijkstraQueue(size_t size) : position(size, NOT_QUEUED)
+	{
+		this->heap.reserve(size);
+	}
+
+	/**
+	 * Check whether there are no more nodes to visit.
+	 * @return True if the queue is empty.
+	 */
+	inline bool empty() const { return this->heap.empty(); }
 
 	/**
-	 * Update the cached annotation value
+	 * Queue a node, or move it to its new place if it is already queued.
+	 * @param node Node to queue.
+	 * @param key Current annotation of the node's path.
 	 */
-	inline void UpdateAnnotation()
+	void Update(NodeID node, Key key)
 	{
-		this->cached_annotation = this->GetCapacityRatio();
+		size_t pos = this->position[node];
+		if (pos == NOT_QUEUED) {
+			this->heap.push_back({key, node});
+			this->SiftUp(this->heap.size() - 1);
+			return;
+		}
+
+		this->heap[pos].key = key;
+		if (pos > 0 && this->Before(this->heap[pos], this->heap[(pos - 1) / ARITY])) {
+			this->SiftUp(pos);
+		} else {
+			this->SiftDown(pos);
+		}
 	}
 
 	/**
-	 * Comparator for std containers.
+	 * Remove the node to visit next from the queue.
+	 * @return The node with the best annotation.
 	 */
-	struct Comparator {
-		bool operator()(const CapacityAnnotation *x, const CapacityAnnotation *y) const;
-	};
+	NodeID Pop()
+	{
+		NodeID node = this->heap.front().node;
+		this->position[node] = NOT_QUEUED;
+
+		Entry last = this->heap.back();
+		this->heap.pop_back();
+		if (!this->heap.empty()) {
+			this->Place(0, last);
+			this->SiftDown(0);
+		}
+		return node;
+	}
+
+private:
+	inline bool Before(const Entry &x, const Entry &y) const
+	{
+		return Tannotation::Before(x.key, y.key, x.node, y.node);
+	}
+
+	inline void Place(size_t pos, const Entry &entry)
+	{
+		this->heap[pos] = entry;
+		this->position[entry.node] = pos;
+	}
+
+	void SiftUp(size_t pos)
+	{
+		Entry entry = this->heap[pos];
+		while (pos > 0) {
+			size_t parent = (pos - 1) / ARITY;
+			if (!this->Before(entry, this->heap[parent])) break;
+			this->Place(pos, this->heap[parent]);
+			pos = parent;
+		}
+		this->Place(pos, entry);
+	}
+
+	void SiftDown(size_t pos)
+	{
+		Entry entry = this->heap[pos];
+		size_t size = this->heap.size();
+		for (;;) {
+			size_t first = pos * ARITY + 1;
+			if (first >= size) break;
+
+			size_t best = first;
+			size_t last = std::min(first + ARITY, size);
+			for (size_t child = first + 1; child < last; ++child) {
+				if (this->Before(this->heap[child], this->heap[best])) best = child;
+			}
+			if (!this->Before(this->heap[best], entry)) break;
+
+			this->Place(pos, this->heap[best]);
+			pos = best;
+		}
+		this->Place(pos, entry);
+	}
 };
 
 /**
@@ -189,56 +316,56 @@ public:
 
 /**
  * Determines if an extension to the given Path with the given parameters is
- * better than this path.
+ * better than a path.
+ * @param path Path to compare with.
  * @param base Other path.
  * @param free_cap Capacity of the new edge to be added to base.
  * @param dist Distance of the new edge.
- * @return True if base + the new edge would be better than the path associated
- * with this annotation.
+ * @return True if base + the new edge would be better than path.
  */
-bool DistanceAnnotation::IsBetter(const DistanceAnnotation *base, uint,
-		int free_cap, uint dist) const
+/* static */ bool DistanceAnnotation::IsBetter(const Path &path, const Path &base, uint,
+		int free_cap, uint dist)
 {
 	/* If any of the paths is disconnected, the other one is better. If both
 	 * are disconnected, this path is better.*/
-	if (base->distance == UINT_MAX) {
+	if (base.GetDistance() == UINT_MAX) {
 		return false;
-	} else if (this->distance == UINT_MAX) {
+	} else if (path.GetDistance() == UINT_MAX) {
 		return true;
 	}
 
-	if (free_cap > 0 && base->free_capacity > 0) {
+	if (free_cap > 0 && base.GetFreeCapacity() > 0) {
 		/* If both paths have capacity left, compare their distances.
 		 * If the other path has capacity left and this one hasn't, the
 		 * other one's better (thus, return true). */
-		return this->free_capacity > 0 ? (base->distance + dist < this->distance) : true;
+		return path.GetFreeCapacity() > 0 ? (base.GetDistance() + dist < path.GetDistance()) : true;
 	} else {
 		/* If the other path doesn't have capacity left, but this one has,
 		 * the other one is worse (thus, return false).
 		 * If both paths are out of capacity, do the regular distance
 		 * comparison. */
-		return this->free_capacity > 0 ? false : (base->distance + dist < this->distance);
+		return path.GetFreeCapacity() > 0 ? false : (base.GetDistance() + dist < path.GetDistance());
 	}
 }
 
 /**
  * Determines if an extension to the given Path with the given parameters is
- * better than this path.
+ * better than a path.
+ * @param path Path to compare with.
  * @param base Other path.
  * @param free_cap Capacity of the new edge to be added to base.
  * @param dist Distance of the new edge.
- * @return True if base + the new edge would be better than the path associated
- * with this annotation.
+ * @return True if base + the new edge would be better than path.
  */
-bool CapacityAnnotation::IsBetter(const CapacityAnnotation *base, uint cap,
-		int free_cap, uint dist) const
+/* static */ bool CapacityAnnotation::IsBetter(const Path &path, const Path &base, uint cap,
+		int free_cap, uint dist)
 {
-	int min_cap = Path::GetCapacityRatio(std::min(base->free_capacity, free_cap), std::min(base->capacity, cap));
-	int this_cap = this->GetCapacityRatio();
+	int min_cap = Path::GetCapacityRatio(std::min(base.GetFreeCapacity(), free_cap), std::min(base.GetCapacity(), cap));
+	int this_cap = path.GetCapacityRatio();
 	if (min_cap == this_cap) {
 		/* If the capacities are the same and the other path isn't disconnected
 		 * choose the shorter path. */
-		return base->distance == UINT_MAX ? false : (base->distance + dist < this->distance);
+		return base.GetDistance() == UINT_MAX ? false : (base.GetDistance() + dist < path.GetDistance());
 	} else {
 		return min_cap > this_cap;
 	}
@@ -256,22 +383,25 @@ bool CapacityAnnotation::IsBetter(const CapacityAnnotation *base, uint cap,
 template <class Tannotation, class Tedge_iterator>
 void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 {
-	typedef std::set<Tannotation *, typename Tannotation::Comparator> AnnoSet;
 	Tedge_iterator iter(this->job);
 	uint16_t size = this->job.Size();
-	AnnoSet annos;
+	DijkstraQueue<Tannotation> queue(size);
 	paths.resize(size, nullptr);
 	for (NodeID node = 0; node < size; ++node) {
-		Tannotation *anno = new Tannotation(node, node == source_node);
-		anno->UpdateAnnotation();
-		annos.insert(anno);
-		paths[node] = anno;
+		Path *path = this->job.CreatePath(node, node == source_node);
+		queue.Update(node, Tannotation::GetAnnotation(*path));
+		paths[node] = path;
 	}
-	while (!annos.empty()) {
-		typename AnnoSet::iterator i = annos.begin();
-		Tannotation *source = *i;
-		annos.erase(i);
-		NodeID from = source->GetNode();
+
+	/* Prioritize the fastest route for passengers, mail and express cargo,
+	 * and the shortest route for other classes of cargo. */
+	bool express = IsCargoInClass(this->job.Cargo(), CargoClass::Passengers) ||
+		IsCargoInClass(this->job.Cargo(), CargoClass::Mail) ||
+		IsCargoInClass(this->job.Cargo(), CargoClass::Express);
+
+	while (!queue.empty()) {
+		NodeID from = queue.Pop();
+		Path *source = paths[from];
 		iter.SetNode(source_node, from);
 		for (NodeID to = iter.Next(); to != INVALID_NODE; to = iter.Next()) {
 			if (to == from) continue; // Not a real edge but a consumption sign.
@@ -282,23 +412,16 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 				capacity /= 100;
 				if (capacity == 0) capacity = 1;
 			}
-			/* Prioritize the fastest route for passengers, mail and express cargo,
-			 * and the shortest route for other classes of cargo.
-			 * In-between stops are punished with a 1 tile or 1 day penalty. */
-			bool express = IsCargoInClass(this->job.Cargo(), CargoClass::Passengers) ||
-				IsCargoInClass(this->job.Cargo(), CargoClass::Mail) ||
-				IsCargoInClass(this->job.Cargo(), CargoClass::Express);
+			/* In-between stops are punished with a 1 tile or 1 day penalty. */
 			uint distance = DistanceMaxPlusManhattan(this->job[from].base.xy, this->job[to].base.xy) + 1;
 			/* Compute a default travel time from the distance and an average speed of 1 tile/day. */
 			uint time = (edge.base.TravelTime() != 0) ? edge.base.TravelTime() + Ticks::DAY_TICKS : distance * Ticks::DAY_TICKS;
 			uint distance_anno = express ? time : distance;
 
-			Tannotation *dest = static_cast<Tannotation *>(paths[to]);
-			if (dest->IsBetter(source, capacity, capacity - edge.Flow(), distance_anno)) {
-				annos.erase(dest);
+			Path *dest = paths[to];
+			if (Tannotation::IsBetter(*dest, *source, capacity, capacity - edge.Flow(), distance_anno)) {
 				dest->Fork(source, capacity, capacity - edge.Flow(), distance_anno);
-				dest->UpdateAnnotation();
-				annos.insert(dest);
+				queue.Update(to, Tannotation::GetAnnotation(*dest));
 			}
 		}
 	}
@@ -322,12 +445,12 @@ void MultiCommodityFlow::CleanupPaths(NodeID source_id, PathVector &paths)
 			path->Detach();
 			if (path->GetNumChildren() == 0) {
 				paths[path->GetNode()] = nullptr;
-				delete path;
+				this->job.FreePath(path);
 			}
 			path = parent;
 		}
 	}
-	delete source;
+	this->job.FreePath(source);
 	paths.clear();
 }
 
@@ -576,48 +699,3 @@ MCF2ndPass::MCF2ndPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 		}
 	}
 }
-
-/**
- * Relation that creates a weak order without duplicates.
- * Avoid accidentally deleting different paths of the same capacity/distance in
- * a set. When the annotation is the same node IDs are compared, so there are
- * no equal ranges.
- * @tparam T Type to be compared on.
- * @param x_anno First value.
- * @param y_anno Second value.
- * @param x Node id associated with the first value.
- * @param y Node id associated with the second value.
- */
-template <typename T>
-bool Greater(T x_anno, T y_anno, NodeID x, NodeID y)
-{
-	if (x_anno > y_anno) return true;
-	if (x_anno < y_anno) return false;
-	return x > y;
-}
-
-/**
- * Compare two capacity annotations.
- * @param x First capacity annotation.
- * @param y Second capacity annotation.
- * @return If x is better than y.
- */
-bool CapacityAnnotation::Comparator::operator()(const CapacityAnnotation *x,
-		const CapacityAnnotation *y) const
-{
-	return x != y && Greater<int>(x->GetAnnotation(), y->GetAnnotation(),
-			x->GetNode(), y->GetNode());
-}
-
-/**
- * Compare two distance annotations.
- * @param x First distance annotation.
- * @param y Second distance annotation.
- * @return If x is better than y.
- */
-bool DistanceAnnotation::Comparator::operator()(const DistanceAnnotation *x,
-		const DistanceAnnotation *y) const
-{
-	return x != y && !Greater<uint>(x->GetAnnotation(), y->GetAnnotation(),
-			x->GetNode(), y->GetNode());
-}
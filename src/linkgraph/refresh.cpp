@@ -17,6 +17,11 @@
 
 #include "../safeguards.h"
 
+/** Maximum number of refresh runs recorded per order list. */
+static constexpr size_t MAX_TRACES_PER_ORDERLIST = 16;
+
+/* static */ std::map<OrderListID, LinkRefresher::Prediction> LinkRefresher::predictions;
+
 /**
  * Refresh all links the given vehicle will visit.
  * @param v Vehicle to refresh links for.
@@ -35,7 +40,97 @@
 	HopSet seen_hops;
 	LinkRefresher refresher(v, &seen_hops, allow_merge, is_full_loading);
 
-	refresher.RefreshLinks(first, first, v->last_loading_station != StationID::Invalid() ? RefreshFlags{RefreshFlag::HasCargo} : RefreshFlags{});
+	bool has_cargo = v->last_loading_station != StationID::Invalid();
+
+	/* Vehicles sharing orders usually take the same path through them; only
+	 * their capacities differ. So replay a run recorded for another vehicle. */
+	Prediction &prediction = GetPrediction(*v->orders);
+	auto it = std::ranges::find_if(prediction.traces, [first, has_cargo, v](const auto &recorded) { return recorded.first.Matches(first, has_cargo, v); });
+	if (it != prediction.traces.end()) {
+		refresher.Replay(it->second);
+		return;
+	}
+
+	TraceKey key{first, has_cargo, {}};
+	for (const Vehicle *u = v; u != nullptr; u = u->Next()) key.engines.push_back(u->engine_type);
+
+	Trace trace;
+	refresher.trace = &trace;
+	refresher.RefreshLinks(first, first, has_cargo ? RefreshFlags{RefreshFlag::HasCargo} : RefreshFlags{});
+
+	if (prediction.traces.size() >= MAX_TRACES_PER_ORDERLIST) prediction.traces.clear();
+	prediction.traces.emplace_back(std::move(key), std::move(trace));
+}
+
+/**
+ * Check whether a run was recorded for a consist starting at the given order.
+ * @param first Order the run starts at.
+ * @param has_cargo If the consist starts out carrying cargo.
+ * @param v First vehicle of the consist.
+ * @return True iff the run is for the same start and engines.
+ */
+bool LinkRefresher::TraceKey::Matches(VehicleOrderID first, bool has_cargo, const Vehicle *v) const
+{
+	if (this->first != first || this->has_cargo != has_cargo) return false;
+
+	auto it = this->engines.begin();
+	for (; v != nullptr; v = v->Next(), ++it) {
+		if (it == this->engines.end() || *it != v->engine_type) return false;
+	}
+	return it == this->engines.end();
+}
+
+/**
+ * Forget all recorded refresh runs, e.g. because the game or the engines changed.
+ */
+/* static */ void LinkRefresher::ClearPredictions()
+{
+	LinkRefresher::predictions.clear();
+}
+
+/**
+ * Forget the refresh runs recorded for an order list, because the list is deleted.
+ * @param orderlist The order list.
+ */
+/* static */ void LinkRefresher::ForgetPrediction(OrderListID orderlist)
+{
+	LinkRefresher::predictions.erase(orderlist);
+}
+
+/**
+ * Get the refresh runs recorded for an order list. If the orders changed
+ * since they were recorded, they are dropped.
+ * @param orderlist Order list to get the runs for.
+ * @return Runs recorded for the current orders.
+ */
+/* static */ LinkRefresher::Prediction &LinkRefresher::GetPrediction(const OrderList &orderlist)
+{
+	Prediction &prediction = LinkRefresher::predictions[orderlist.index];
+	if (prediction.version != orderlist.GetVersion()) {
+		prediction.version = orderlist.GetVersion();
+		prediction.traces.clear();
+	}
+	return prediction;
+}
+
+/**
+ * Replay a recorded refresh run with the capacities of this refresher's consist.
+ * @param trace Run to replay.
+ */
+void LinkRefresher::Replay(const Trace &trace)
+{
+	std::vector<LinkRefresher> saved;
+	for (const TraceStep &step : trace) {
+		switch (step.action) {
+			case TraceAction::Save: saved.push_back(*this); break;
+			case TraceAction::Restore: *this = saved.back(); break;
+			case TraceAction::Drop: saved.pop_back(); break;
+			case TraceAction::Refit: this->HandleRefit(step.cargo); break;
+			case TraceAction::ResetRefit: this->ResetRefit(); break;
+			case TraceAction::RefreshStats: this->RefreshStats(step.cur, step.next); break;
+			default: NOT_REACHED();
+		}
+	}
 }
 
 /**
@@ -48,7 +143,7 @@
  */
 LinkRefresher::LinkRefresher(Vehicle *vehicle, HopSet *seen_hops, bool allow_merge, bool is_full_loading) :
 	vehicle(vehicle), seen_hops(seen_hops), cargo(INVALID_CARGO), allow_merge(allow_merge),
-	is_full_loading(is_full_loading)
+	is_full_loading(is_full_loading), trace(nullptr)
 {
 	/* Assemble list of capacities and set last loading stations to 0. */
 	for (Vehicle *v = this->vehicle; v != nullptr; v = v->Next()) {
@@ -161,8 +256,11 @@ VehicleOrderID LinkRefresher::PredictNextOrder(VehicleOrderID cur, VehicleOrderI
 				 * for optimization here: If the vehicle never refits we don't
 				 * need to copy anything. Also, if we've seen the branched link
 				 * before we don't need to branch at all. */
+				this->Record(TraceAction::Save);
 				LinkRefresher branch(*this);
 				branch.RefreshLinks(cur, skip_to, flags, num_hops + 1);
+				this->Record(TraceAction::Restore);
+				this->Record(TraceAction::Drop);
 			}
 		}
 
@@ -257,15 +355,20 @@ void LinkRefresher::RefreshLinks(VehicleOrderID cur, VehicleOrderID next, Refres
 			flags.Set(RefreshFlag::WasRefit);
 			if (!next_order->IsAutoRefit()) {
 				this->HandleRefit(next_order->GetRefitCargo());
+				this->Record(TraceAction::Refit, next_order->GetRefitCargo());
 			} else if (!flags.Test(RefreshFlag::InAutorefit)) {
 				flags.Set(RefreshFlag::InAutorefit);
+				this->Record(TraceAction::Save);
 				LinkRefresher backup(*this);
 				for (CargoType cargo = 0; cargo != NUM_CARGO; ++cargo) {
 					if (CargoSpec::Get(cargo)->IsValid() && this->HandleRefit(cargo)) {
+						this->Record(TraceAction::Refit, cargo);
 						this->RefreshLinks(cur, next, flags, num_hops);
 						*this = backup;
+						this->Record(TraceAction::Restore);
 					}
 				}
+				this->Record(TraceAction::Drop);
 			}
 		}
 
@@ -297,6 +400,7 @@ void LinkRefresher::RefreshLinks(VehicleOrderID cur, VehicleOrderID next, Refres
 
 		if (flags.Test(RefreshFlag::ResetRefit)) {
 			this->ResetRefit();
+			this->Record(TraceAction::ResetRefit);
 			flags.Reset({RefreshFlag::ResetRefit, RefreshFlag::WasRefit});
 		}
 
@@ -306,6 +410,7 @@ void LinkRefresher::RefreshLinks(VehicleOrderID cur, VehicleOrderID next, Refres
 			if (cur_order->CanLeaveWithCargo(flags.Test(RefreshFlag::HasCargo))) {
 				flags.Set(RefreshFlag::HasCargo);
 				this->RefreshStats(cur, next);
+				this->Record(TraceAction::RefreshStats, INVALID_CARGO, cur, next);
 			} else {
 				flags.Reset(RefreshFlag::HasCargo);
 			}
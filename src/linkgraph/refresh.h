@@ -19,6 +19,8 @@
 class LinkRefresher {
 public:
 	static void Run(Vehicle *v, bool allow_merge = true, bool is_full_loading = false);
+	static void ClearPredictions();
+	static void ForgetPrediction(OrderListID orderlist);
 
 protected:
 	/**
@@ -77,9 +79,53 @@ protected:
 		constexpr auto operator<=>(const Hop &) const noexcept = default;
 	};
 
+	/**
+	 * Steps of a refresh run that change the capacities of the consist or
+	 * refresh a link. Everything else only depends on the orders.
+	 */
+	enum class TraceAction : uint8_t {
+		Save,         ///< Save the state of the refresher.
+		Restore,      ///< Restore the last saved state, but keep it saved.
+		Drop,         ///< Forget the last saved state.
+		Refit,        ///< Refit the consist.
+		ResetRefit,   ///< Reset the refit capacities.
+		RefreshStats, ///< Refresh the link between two orders.
+	};
+
+	/** A single step of a recorded refresh run. */
+	struct TraceStep {
+		TraceAction action; ///< What to do.
+		CargoType cargo; ///< Cargo to refit to for TraceAction::Refit.
+		VehicleOrderID cur; ///< First order of the link for TraceAction::RefreshStats.
+		VehicleOrderID next; ///< Second order of the link for TraceAction::RefreshStats.
+	};
+
+	/**
+	 * Identification of a refresh run within an order list. Whether a refit
+	 * succeeds only depends on the engines of the consist, so consists of the
+	 * same engines take the same path through the orders.
+	 */
+	struct TraceKey {
+		VehicleOrderID first; ///< Order the run starts at.
+		bool has_cargo; ///< If the consist starts out carrying cargo.
+		std::vector<EngineID> engines; ///< Engines of the vehicles in the consist.
+
+		bool Matches(VehicleOrderID first, bool has_cargo, const Vehicle *v) const;
+	};
+
+	typedef std::vector<TraceStep> Trace;
+
+	/** Refresh runs recorded for an order list. */
+	struct Prediction {
+		uint64_t version = 0; ///< Version of the orders the runs were recorded with, see OrderList::GetVersion.
+		std::vector<std::pair<TraceKey, Trace>> traces; ///< Recorded runs.
+	};
+
 	typedef std::vector<RefitDesc> RefitList;
 	typedef std::set<Hop> HopSet;
 
+	static std::map<OrderListID, Prediction> predictions; ///< Refresh runs recorded per order list.
+
 	Vehicle *vehicle;           ///< Vehicle for which the links should be refreshed.
 	CargoArray capacities{}; ///< Current added capacities per cargo type in the consist.
 	RefitList refit_capacities; ///< Current state of capacity remaining from previous refits versus overall capacity per vehicle in the consist.
@@ -87,9 +133,25 @@ protected:
 	CargoType cargo;              ///< Cargo given in last refit order.
 	bool allow_merge;           ///< If the refresher is allowed to merge or extend link graphs.
 	bool is_full_loading;       ///< If the vehicle is full loading.
+	Trace *trace;               ///< Run being recorded, or nullptr if not recording. This is shared like seen_hops.
 
 	LinkRefresher(Vehicle *v, HopSet *seen_hops, bool allow_merge, bool is_full_loading);
 
+	/**
+	 * Record a step of the run if a run is being recorded.
+	 * @param action What was done.
+	 * @param cargo Cargo the consist was refit to.
+	 * @param cur First order of the refreshed link.
+	 * @param next Second order of the refreshed link.
+	 */
+	inline void Record(TraceAction action, CargoType cargo = INVALID_CARGO, VehicleOrderID cur = INVALID_VEH_ORDER_ID, VehicleOrderID next = INVALID_VEH_ORDER_ID)
+	{
+		if (this->trace != nullptr) this->trace->push_back({action, cargo, cur, next});
+	}
+
+	static Prediction &GetPrediction(const OrderList &orderlist);
+	void Replay(const Trace &trace);
+
 	bool HandleRefit(CargoType refit_cargo);
 	void ResetRefit();
 	void RefreshStats(VehicleOrderID cur, VehicleOrderID next);
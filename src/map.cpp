@@ -52,6 +52,10 @@
 	Map::size = size_x * size_y;
 	Map::tile_mask = Map::size - 1;
 
+	/* Release the old map first, so loading a game does not hold two full maps at once. */
+	Tile::base_tiles.reset();
+	Tile::extended_tiles.reset();
+
 	Tile::base_tiles = std::make_unique<Tile::TileBase[]>(Map::size);
 	Tile::extended_tiles = std::make_unique<Tile::TileExtended[]>(Map::size);
 
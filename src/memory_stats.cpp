@@ -0,0 +1,78 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file memory_stats.cpp Memory use of the pools, caches and scripts, for the memory window and the console. */
+
+#include "stdafx.h"
+#include "memory_stats.h"
+#include "company_base.h"
+#include "newgrf_sound.h"
+#include "spritecache.h"
+#include "ai/ai_instance.hpp"
+#include "core/pool_type.hpp"
+#include "game/game.hpp"
+#include "game/game_instance.hpp"
+#include "linkgraph/linkgraphjob.h"
+#include "timer/timer.h"
+#include "timer/timer_game_tick.h"
+
+#include "safeguards.h"
+
+/** Item counts of all pools at a moment in the past. */
+struct PoolHistorySample {
+	TimerGameTick::TickCounter tick; ///< Tick the sample was taken.
+	std::vector<size_t> items; ///< Number of items per pool, in the order of PoolBase::GetPools().
+};
+
+static std::deque<PoolHistorySample> _pool_history; ///< Samples of the pools, oldest first.
+
+/** Take a sample of the item counts of the pools for the growth over time. */
+static const IntervalTimer<TimerGameTick> _pool_history_interval({TimerGameTick::Priority::NONE, MemoryStats::HISTORY_INTERVAL}, [](auto) {
+	PoolHistorySample &sample = _pool_history.emplace_back(TimerGameTick::counter);
+	for (const PoolBase *pool : *PoolBase::GetPools()) sample.items.push_back(pool->GetItemCount());
+
+	if (_pool_history.size() > MemoryStats::HISTORY_LENGTH) _pool_history.pop_front();
+});
+
+/**
+ * Get the current memory use of the game.
+ * @return The memory use.
+ */
+MemoryStats GetMemoryStats()
+{
+	MemoryStats stats;
+
+	/* Loading a game resets the tick counter; the samples from before are meaningless. */
+	if (!_pool_history.empty() && _pool_history.front().tick > TimerGameTick::counter) _pool_history.clear();
+	const PoolHistorySample *oldest = _pool_history.empty() ? nullptr : &_pool_history.front();
+	if (oldest != nullptr) stats.history_ticks = TimerGameTick::counter - oldest->tick;
+
+	const PoolVector &pools = *PoolBase::GetPools();
+	for (size_t i = 0; i < pools.size(); i++) {
+		const PoolBase *pool = pools[i];
+		size_t items = pool->GetItemCount();
+		int64_t growth = oldest != nullptr && i < oldest->items.size() ? static_cast<int64_t>(items) - static_cast<int64_t>(oldest->items[i]) : 0;
+		stats.pools.emplace_back(pool->GetName(), items, pool->GetUsedRange(), pool->GetCapacity(), pool->bytes + pool->GetAdministrationBytes(), growth);
+	}
+
+	stats.sprite_cache_used = GetSpriteCacheUsage();
+	stats.sprite_cache_limit = GetSpriteCacheLimit();
+	stats.sound_bytes = GetSoundPoolAllocatedMemory();
+
+	for (const Company *c : Company::Iterate()) {
+		if (c->ai_instance != nullptr) stats.ai_bytes += c->ai_instance->GetAllocatedMemory();
+	}
+	if (Game::GetInstance() != nullptr) stats.game_script_bytes = Game::GetInstance()->GetAllocatedMemory();
+
+	for (const LinkGraphJob *job : LinkGraphJob::Iterate()) {
+		stats.link_graph_jobs++;
+		stats.link_graph_job_bytes += job->GetMemoryUsage();
+	}
+
+	stats.process = GetProcessMemoryUsage();
+	return stats;
+}
@@ -0,0 +1,46 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file memory_stats.h Memory use of the pools, caches and scripts, for the memory window and the console. */
+
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include "debug.h"
+
+/** Memory use of a single pool. */
+struct PoolMemoryStats {
+	std::string_view name; ///< Name of the pool.
+	size_t items; ///< Number of items in the pool.
+	size_t used_range; ///< Number of items up to the highest used index; the difference with #items are holes.
+	size_t capacity; ///< Number of items the pool has room for without growing.
+	size_t bytes; ///< Bytes of the items, without the memory they allocate themselves, and of the administration of the pool.
+	int64_t growth; ///< Change of the number of items over #MemoryStats::history_ticks.
+};
+
+/** Memory use of the game. */
+struct MemoryStats {
+	static constexpr uint HISTORY_INTERVAL = 256; ///< Number of ticks between the samples of the item counts of the pools.
+	static constexpr size_t HISTORY_LENGTH = 32; ///< Number of samples that are kept.
+
+	std::vector<PoolMemoryStats> pools; ///< Memory use per pool.
+	uint64_t history_ticks = 0; ///< Number of ticks the growth of the pools is measured over.
+	size_t sprite_cache_used = 0; ///< Bytes used by the sprite cache.
+	size_t sprite_cache_limit = 0; ///< Size the sprite cache is kept under.
+	size_t sound_bytes = 0; ///< Bytes used by the sound effects.
+	size_t ai_bytes = 0; ///< Bytes used by the script VMs of all AIs.
+	size_t game_script_bytes = 0; ///< Bytes used by the script VM of the game script.
+	size_t link_graph_jobs = 0; ///< Number of running link graph jobs.
+	size_t link_graph_job_bytes = 0; ///< Estimated bytes used by the running link graph jobs.
+	ProcessMemoryUsage process{}; ///< Memory use of the whole process.
+};
+
+MemoryStats GetMemoryStats();
+
+void ShowMemoryWindow();
+
+#endif /* MEMORY_STATS_H */
@@ -1228,29 +1228,145 @@ struct InvokeGrfActionHandler {
 	}
 };
 
+/**
+ * Pseudo-sprite stream of a NewGRF, indexed once and then replayed from memory in the later loading stages.
+ * The file position of every sprite is kept, so action handlers that read from or seek in the file
+ * (action 1, 5, 6, 7/9, 10, 11, ...) still see exactly the same file as without the stream.
+ */
+struct GRFSpriteStream {
+	/** A single sprite of the stream. */
+	struct Entry {
+		size_t pos; ///< File position of the sprite header.
+		size_t next_pos; ///< File position directly after the sprite.
+		uint32_t num; ///< Size of the sprite as given by its header; 0 for the end of the stream.
+		uint8_t type; ///< Type of the sprite; 0xFF for pseudo sprites.
+		size_t data; ///< Offset of the content of the pseudo sprite in #data, or SIZE_MAX if it is not stored.
+	};
+
+	std::vector<Entry> entries; ///< All sprites, in file order, terminated by an entry with #num 0.
+	std::vector<uint8_t> data; ///< Content of all pseudo sprites.
+
+	/**
+	 * Find the sprite starting at a file position.
+	 * @param pos File position of the sprite header.
+	 * @param[in,out] cursor Index of the sprite that is expected next; updated to the sprite after the found one.
+	 * @return The sprite, or \c nullptr when no sprite starts at \a pos.
+	 */
+	const Entry *Find(size_t pos, size_t &cursor) const
+	{
+		if (cursor < this->entries.size() && this->entries[cursor].pos == pos) return &this->entries[cursor++];
+
+		/* Jumped around by action 7/9 or the action handlers read sprites themselves. */
+		auto it = std::ranges::lower_bound(this->entries, pos, std::less{}, &Entry::pos);
+		if (it == std::end(this->entries) || it->pos != pos) return nullptr;
+		cursor = std::distance(std::begin(this->entries), it) + 1;
+		return &*it;
+	}
+};
+
+/** Upper limit for the memory used by all pseudo-sprite streams together. */
+static constexpr size_t GRF_SPRITE_STREAM_BUDGET = 64 * 1024 * 1024;
+
+static std::map<std::string, GRFSpriteStream, std::less<>> _grf_sprite_streams; ///< Pseudo-sprite streams of the NewGRFs being loaded, by filename.
+static size_t _grf_sprite_stream_bytes = 0; ///< Memory used by #_grf_sprite_streams.
+
+/** Free the pseudo-sprite streams of all NewGRFs. */
+static void ClearGRFSpriteStreams()
+{
+	_grf_sprite_streams.clear();
+	_grf_sprite_stream_bytes = 0;
+}
+
+/**
+ * Index the pseudo-sprite stream of a NewGRF, starting at the current file position.
+ * The file position is restored afterwards.
+ * @param file The file to read the stream from.
+ * @return The stream, or \c nullptr when it does not fit in the memory budget.
+ */
+static const GRFSpriteStream *BuildGRFSpriteStream(SpriteFile &file)
+{
+	auto found = _grf_sprite_streams.find(file.GetFilename());
+	if (found != std::end(_grf_sprite_streams)) return found->second.entries.empty() ? nullptr : &found->second;
+
+	/* Remember that this file was tried, so a file that does not fit is not indexed again in every stage. */
+	GRFSpriteStream &stream = _grf_sprite_streams[file.GetFilename()];
+	uint8_t grf_container_version = file.GetContainerVersion();
+	size_t start = file.GetPos();
+	size_t bytes = 0;
+
+	for (;;) {
+		GRFSpriteStream::Entry &entry = stream.entries.emplace_back();
+		entry.pos = file.GetPos();
+		entry.num = grf_container_version >= 2 ? file.ReadDword() : file.ReadWord();
+		entry.data = SIZE_MAX;
+		if (entry.num == 0) {
+			entry.type = 0;
+			entry.next_pos = file.GetPos();
+			break;
+		}
+
+		entry.type = file.ReadByte();
+		if (entry.type == 0xFF) {
+			/* Sprites above the limit of DecodeSpecialSprite are never decoded. */
+			if (entry.num <= 1024 * 1024) {
+				entry.data = stream.data.size();
+				stream.data.resize(entry.data + entry.num);
+				file.ReadBlock(stream.data.data() + entry.data, entry.num);
+			} else {
+				file.SkipBytes(entry.num);
+			}
+		} else if (grf_container_version >= 2 && entry.type == 0xFD) {
+			file.SkipBytes(entry.num);
+		} else {
+			file.SkipBytes(7);
+			SkipSpriteData(file, entry.type, entry.num - 8);
+		}
+		entry.next_pos = file.GetPos();
+
+		bytes = stream.data.capacity() + stream.entries.capacity() * sizeof(GRFSpriteStream::Entry);
+		if (_grf_sprite_stream_bytes + bytes > GRF_SPRITE_STREAM_BUDGET) {
+			Debug(grf, 3, "LoadNewGRFFile: Pseudo-sprite stream of '{}' does not fit in memory budget, reading from file", file.GetFilename());
+			stream.entries = {};
+			stream.data = {};
+			file.SeekTo(start, SEEK_SET);
+			return nullptr;
+		}
+	}
+
+	_grf_sprite_stream_bytes += bytes;
+	Debug(grf, 3, "LoadNewGRFFile: Indexed {} sprites with {} bytes of pseudo sprites of '{}'", stream.entries.size() - 1, stream.data.size(), file.GetFilename());
+
+	file.SeekTo(start, SEEK_SET);
+	return &stream;
+}
+
 /* Here we perform initial decoding of some special sprites (as are they
  * described at http://www.ttdpatch.net/src/newgrf.txt, but this is only a very
  * partial implementation yet).
  * XXX: We consider GRF files trusted. It would be trivial to exploit OTTD by
  * a crafted invalid GRF file. We should tell that to the user somehow, or
  * better make this more robust in the future. */
-static void DecodeSpecialSprite(ReusableBuffer<uint8_t> &allocator, uint num, GrfLoadingStage stage)
+static void DecodeSpecialSprite(ReusableBuffer<uint8_t> &allocator, uint num, GrfLoadingStage stage, const uint8_t *streamed = nullptr)
 {
-	uint8_t *buf;
+	const uint8_t *buf;
 	auto it = _grf_line_to_action6_sprite_override.find({_cur_gps.grfconfig->ident.grfid, _cur_gps.nfo_line});
-	if (it == _grf_line_to_action6_sprite_override.end()) {
-		/* No preloaded sprite to work with; read the
-		 * pseudo sprite content. */
-		buf = allocator.Allocate(num);
-		_cur_gps.file->ReadBlock(buf, num);
-	} else {
+	if (it != _grf_line_to_action6_sprite_override.end()) {
 		/* Use the preloaded sprite data. */
 		buf = it->second.data();
 		assert(it->second.size() == num);
 		GrfMsg(7, "DecodeSpecialSprite: Using preloaded pseudo sprite data");
 
 		/* Skip the real (original) content of this action. */
-		_cur_gps.file->SeekTo(num, SEEK_CUR);
+		if (streamed == nullptr) _cur_gps.file->SeekTo(num, SEEK_CUR);
+	} else if (streamed != nullptr) {
+		/* Use the content from the pseudo-sprite stream; the file is already past it. */
+		buf = streamed;
+	} else {
+		/* No preloaded sprite to work with; read the
+		 * pseudo sprite content. */
+		uint8_t *block = allocator.Allocate(num);
+		_cur_gps.file->ReadBlock(block, num);
+		buf = block;
 	}
 
 	ByteReader br(buf, num);
@@ -1323,8 +1439,32 @@ static void LoadNewGRFFileFromFile(GRFConfig &config, GrfLoadingStage stage, Spr
 
 	ReusableBuffer<uint8_t> allocator;
 
-	while ((num = (grf_container_version >= 2 ? file.ReadDword() : file.ReadWord())) != 0) {
-		uint8_t type = file.ReadByte();
+	/* The loading stages of LoadNewGRF replay the pseudo-sprite stream, instead of parsing the file again. */
+	const GRFSpriteStream *stream = stage >= GLS_LABELSCAN ? BuildGRFSpriteStream(file) : nullptr;
+	size_t stream_pos = file.GetPos();
+	size_t stream_cursor = 0;
+
+	for (;;) {
+		const GRFSpriteStream::Entry *entry = nullptr;
+		if (stream != nullptr) {
+			entry = stream->Find(stream_pos, stream_cursor);
+			if (entry == nullptr) {
+				/* Not at a sprite boundary we know about; continue reading from the file. */
+				file.SeekTo(stream_pos, SEEK_SET);
+				stream = nullptr;
+			}
+		}
+
+		uint8_t type = 0;
+		if (entry != nullptr) {
+			num = entry->num;
+			type = entry->type;
+			stream_pos = entry->next_pos;
+		} else {
+			num = grf_container_version >= 2 ? file.ReadDword() : file.ReadWord();
+			if (num != 0) type = file.ReadByte();
+		}
+		if (num == 0) break;
 		_cur_gps.nfo_line++;
 
 		if (type == 0xFF) {
@@ -1336,13 +1476,20 @@ static void LoadNewGRFFileFromFile(GRFConfig &config, GrfLoadingStage stage, Spr
 					break;
 				}
 
-				DecodeSpecialSprite(allocator, num, stage);
+				if (entry != nullptr) {
+					/* Action handlers expect the file to be positioned directly after the pseudo sprite. */
+					file.SeekTo(entry->next_pos, SEEK_SET);
+					DecodeSpecialSprite(allocator, num, stage, stream->data.data() + entry->data);
+					stream_pos = file.GetPos();
+				} else {
+					DecodeSpecialSprite(allocator, num, stage);
+				}
 
 				/* Stop all processing if we are to skip the remaining sprites */
 				if (_cur_gps.skip_sprites == -1) break;
 
 				continue;
-			} else {
+			} else if (entry == nullptr) {
 				file.SkipBytes(num);
 			}
 		} else {
@@ -1352,7 +1499,9 @@ static void LoadNewGRFFileFromFile(GRFConfig &config, GrfLoadingStage stage, Spr
 				break;
 			}
 
-			if (grf_container_version >= 2 && type == 0xFD) {
+			if (entry != nullptr) {
+				/* Already skipped when indexing the stream. */
+			} else if (grf_container_version >= 2 && type == 0xFD) {
 				/* Reference to data section. Container version >= 2 only. */
 				file.SkipBytes(num);
 			} else {
@@ -1786,6 +1935,8 @@ void LoadNewGRF(SpriteID load_index, uint num_baseset)
 	 * in each loading stage, (try to) open each file specified in the config
 	 * and load information from it. */
 	for (GrfLoadingStage stage = GLS_LABELSCAN; stage <= GLS_ACTIVATION; stage++) {
+		auto stage_start = std::chrono::steady_clock::now();
+
 		/* Set activated grfs back to will-be-activated between reservation- and activation-stage.
 		 * This ensures that action7/9 conditions 0x06 - 0x0A work correctly. */
 		for (const auto &c : _grfconfig) {
@@ -1838,6 +1989,7 @@ void LoadNewGRF(SpriteID load_index, uint num_baseset)
 			} else if (stage == GLS_ACTIVATION) {
 				c->flags.Reset(GRFConfigFlag::Reserved);
 				assert(GetFileByGRFID(c->ident.grfid) == _cur_gps.grffile);
+				TranslatePendingGRFTexts(c->ident.grfid);
 				ClearTemporaryNewGRFData(_cur_gps.grffile);
 				BuildCargoTranslationMap();
 				Debug(sprite, 2, "LoadNewGRF: Currently {} sprites are loaded", _cur_gps.spriteid);
@@ -1846,11 +1998,15 @@ void LoadNewGRF(SpriteID load_index, uint num_baseset)
 				ClearTemporaryNewGRFData(_cur_gps.grffile);
 			}
 		}
+
+		Debug(grf, 1, "LoadNewGRF: Loading stage {} of {} NewGRFs took {} ms", stage, num_grfs,
+				std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - stage_start).count());
 	}
 
 	/* We've finished reading files. */
 	_cur_gps.grfconfig = nullptr;
 	_cur_gps.grffile = nullptr;
+	ClearGRFSpriteStreams();
 
 	/* Pseudo sprite processing is finished; free temporary stuff */
 	_cur_gps.ClearDataForNextFile();
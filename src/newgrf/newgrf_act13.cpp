@@ -69,6 +69,9 @@ static void TranslateGRFStrings(ByteReader &buf)
 
 		AddGRFString(grfid, GRFStringID(first_id + i), language, true, true, string, STR_UNDEFINED);
 	}
+
+	/* The target NewGRF has been activated already, so its texts are not translated anymore otherwise. */
+	TranslatePendingGRFTexts(grfid);
 }
 
 template <> void GrfActionHandler<0x13>::FileScan(ByteReader &) { }
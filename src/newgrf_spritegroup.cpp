@@ -12,6 +12,7 @@
 #include "newgrf_spritegroup.h"
 #include "newgrf_profiling.h"
 #include "core/pool_func.hpp"
+#include "scope_profiler.h"
 
 #include "safeguards.h"
 
@@ -36,6 +37,12 @@ INSTANTIATE_POOL_METHODS(SpriteGroup)
 	if (group == nullptr) return std::monostate{};
 
 	const GRFFile *grf = object.grffile;
+
+	std::optional<ProfileScope> profile;
+	if (top_level && object.callback != CBID_NO_CALLBACK && ScopeProfiler::IsRunning()) {
+		profile.emplace("NewGRF callback", grf == nullptr ? ProfileEvent::NO_OBJECT : std::byteswap(grf->grfid));
+	}
+
 	auto profiler = std::ranges::find(_newgrf_profilers, grf, &NewGRFProfiler::grffile);
 
 	if (profiler == _newgrf_profilers.end() || !profiler->active) {
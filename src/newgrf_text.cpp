@@ -67,10 +67,20 @@ enum GRFExtendedLanguages : uint8_t {
  * since it is NOT SUPPOSED to happen.
  */
 struct GRFTextEntry {
+	/** A text as read from the NewGRF, which is only translated once its language is needed. */
+	struct UntranslatedText {
+		uint8_t langid; ///< The language associated with this text.
+		bool allow_newlines; ///< Whether newlines are allowed in this text.
+		std::string text; ///< The text, still containing TTDPatch string codes.
+	};
+
 	GRFTextList textholder;
+	std::vector<UntranslatedText> untranslated; ///< Texts that have not been translated into #textholder yet.
 	StringID def_string;
 	uint32_t grfid;
 	GRFStringID stringid;
+
+	void TranslateTexts();
 };
 
 
@@ -565,10 +575,17 @@ StringID AddGRFString(uint32_t grfid, GRFStringID stringid, uint8_t langid_to_ad
 	}
 	StringIndexInTab id(it - std::begin(_grf_text));
 
-	std::string newtext = TranslateTTDPatchCodes(grfid, langid_to_add, allow_newlines, text_to_add);
-	AddGRFTextToList(it->textholder, langid_to_add, newtext);
+	/* Most texts are only shown in one language, so translation is deferred until the NewGRF is activated, and then only done for the languages that are needed. */
+	std::erase_if(it->textholder, [langid_to_add](const GRFText &text) { return text.langid == langid_to_add; });
+	auto untranslated = std::ranges::find(it->untranslated, langid_to_add, &GRFTextEntry::UntranslatedText::langid);
+	if (untranslated == std::end(it->untranslated)) {
+		it->untranslated.emplace_back(langid_to_add, allow_newlines, std::string{text_to_add});
+	} else {
+		untranslated->allow_newlines = allow_newlines;
+		untranslated->text = text_to_add;
+	}
 
-	GrfMsg(3, "Added 0x{:X} grfid {:08X} string 0x{:X} lang 0x{:X} string '{}' ({:X})", id, grfid, stringid, langid_to_add, newtext, MakeStringID(TEXT_TAB_NEWGRF_START, id));
+	GrfMsg(3, "Added 0x{:X} grfid {:08X} string 0x{:X} lang 0x{:X} string '{}' ({:X})", id, grfid, stringid, langid_to_add, TranslateTTDPatchCodes(grfid, langid_to_add, allow_newlines, text_to_add), MakeStringID(TEXT_TAB_NEWGRF_START, id));
 
 	return MakeStringID(TEXT_TAB_NEWGRF_START, id);
 }
@@ -625,6 +642,37 @@ std::optional<std::string_view> GetGRFStringFromGRFText(const GRFTextWrapper &te
 	return text ? GetGRFStringFromGRFText(*text) : std::nullopt;
 }
 
+/**
+ * Translate the texts that might be needed for the current language.
+ * Texts in other languages stay untranslated until the language is changed.
+ * @pre All strings and the language map of the NewGRF have been loaded, so string references and genders and cases resolve as during loading.
+ */
+void GRFTextEntry::TranslateTexts()
+{
+	auto is_needed = [](const UntranslatedText &text) {
+		return text.langid == _current_lang_id || text.langid == GRFLX_UNSPECIFIED || text.langid == GRFLX_ENGLISH || text.langid == GRFLX_AMERICAN;
+	};
+
+	for (const UntranslatedText &text : this->untranslated) {
+		if (!is_needed(text)) continue;
+		AddGRFTextToList(this->textholder, text.langid, TranslateTTDPatchCodes(this->grfid, text.langid, text.allow_newlines, text.text));
+	}
+	std::erase_if(this->untranslated, is_needed);
+}
+
+/**
+ * Translate the texts of a NewGRF that are needed for the current language.
+ * Called once the NewGRF has been activated, so all its strings and its language map are known,
+ * and after action 13 added translations to an already activated NewGRF.
+ * @param grfid The NewGRF to translate the texts of.
+ */
+void TranslatePendingGRFTexts(uint32_t grfid)
+{
+	for (GRFTextEntry &entry : _grf_text) {
+		if (entry.grfid == grfid && !entry.untranslated.empty()) entry.TranslateTexts();
+	}
+}
+
 /**
  * Get a C-string from a stringid set by a newgrf.
  */
@@ -651,6 +699,11 @@ std::string_view GetGRFStringPtr(StringIndexInTab stringid)
 void SetCurrentGrfLangID(uint8_t language_id)
 {
 	_current_lang_id = language_id;
+
+	/* Texts in the new language were not needed before. */
+	for (GRFTextEntry &entry : _grf_text) {
+		if (!entry.untranslated.empty()) entry.TranslateTexts();
+	}
 }
 
 bool CheckGrfLangID(uint8_t lang_id, uint8_t grf_version)
@@ -19,6 +19,7 @@ StringID GetGRFStringID(uint32_t grfid, GRFStringID stringid);
 std::optional<std::string_view> GetGRFStringFromGRFText(const GRFTextList &text_list);
 std::optional<std::string_view> GetGRFStringFromGRFText(const GRFTextWrapper &text);
 std::string_view GetGRFStringPtr(StringIndexInTab stringid);
+void TranslatePendingGRFTexts(uint32_t grfid);
 void CleanUpStrings();
 void SetCurrentGrfLangID(uint8_t language_id);
 std::string TranslateTTDPatchCodes(uint32_t grfid, uint8_t language_id, bool allow_newlines, std::string_view str, StringControlCode byte80 = SCC_NEWGRF_PRINT_WORD_STRING_ID);
@@ -70,6 +70,10 @@
 #include "viewport_func.h"
 #include "viewport_sprite_sorter.h"
 #include "framerate_type.h"
+#include "scope_profiler.h"
+#include "tick_cost.h"
+#include "tick_watchdog.h"
+#include "debug_log.h"
 #include "industry.h"
 #include "network/network_gui.h"
 #include "network/network_survey.h"
@@ -316,6 +320,8 @@ static void ShutdownGame()
 	if (_game_mode != GM_BOOTSTRAP) ResetNewGRFData();
 
 	UninitFontCache();
+
+	StopDebugLog();
 }
 
 /**
@@ -501,6 +507,7 @@ int openttd_main(std::span<std::string_view> arguments)
 {
 	_game_session_stats.start_time = std::chrono::steady_clock::now();
 	_game_session_stats.savegame_size = std::nullopt;
+	SetDebugGameThread();
 
 	std::string musicdriver;
 	std::string sounddriver;
@@ -1231,8 +1238,10 @@ void StateGameLoop()
 		return;
 	}
 
+	TickWatchdogScope watchdog;
 	PerformanceMeasurer framerate(PFE_GAMELOOP);
 	PerformanceAccumulator::Reset(PFE_GL_LANDSCAPE);
+	ProfileScope profile("StateGameLoop", static_cast<uint32_t>(TimerGameTick::counter));
 
 	if (_game_mode == GM_EDITOR) {
 		BasePersistentStorageArray::SwitchMode(PSM_ENTER_GAMELOOP);
@@ -1252,6 +1261,7 @@ void StateGameLoop()
 		}
 
 		CheckCaches();
+		TickCostAccounting::OnTick();
 
 		/* All these actions has to be done from OWNER_NONE
 		 *  for multiplayer compatibility */
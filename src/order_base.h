@@ -278,6 +278,10 @@ private:
 	TimerGameTick::Ticks timetable_duration{}; ///< NOSAVE: Total timetabled duration of the order list.
 	TimerGameTick::Ticks total_duration{}; ///< NOSAVE: Total (timetabled or not) duration of the order list.
 
+	uint64_t version = OrderList::NewVersion(); ///< NOSAVE: Version of the orders, changed whenever an order in the list changes.
+
+	static uint64_t NewVersion();
+
 public:
 	/** Default constructor producing an invalid order list. */
 	OrderList() {}
@@ -304,8 +308,7 @@ public:
 		this->Initialize(v);
 	}
 
-	/** Destructor. Invalidates OrderList for re-usage by the pool. */
-	~OrderList() {}
+	~OrderList();
 
 	void Initialize(Vehicle *v);
 
@@ -367,6 +370,18 @@ public:
 	 */
 	inline VehicleOrderID GetNumManualOrders() const { return this->num_manual_orders; }
 
+	/**
+	 * Get the version of the orders in this list.
+	 * Versions are unique over all order lists, so a version identifies both the list and the state of its orders.
+	 * @return The version.
+	 */
+	inline uint64_t GetVersion() const { return this->version; }
+
+	/**
+	 * Must be called whenever an order of the list is modified in place, to invalidate results cached for the orders.
+	 */
+	inline void MarkOrdersChanged() { this->version = OrderList::NewVersion(); }
+
 	StationIDStack GetNextStoppingStation(const Vehicle *v, VehicleOrderID first = INVALID_VEH_ORDER_ID, uint hops = 0) const;
 	VehicleOrderID GetNextDecisionNode(VehicleOrderID next, uint hops) const;
 
@@ -27,6 +27,7 @@
 #include "cheat_type.h"
 #include "order_cmd.h"
 #include "train_cmd.h"
+#include "linkgraph/refresh.h"
 
 #include "table/strings.h"
 
@@ -246,6 +247,14 @@ void Order::AssignOrder(const Order &other)
 	this->max_speed   = other.max_speed;
 }
 
+/** Destructor. Invalidates OrderList for re-usage by the pool. */
+OrderList::~OrderList()
+{
+	if (CleaningPool()) return;
+
+	LinkRefresher::ForgetPrediction(this->index);
+}
+
 /**
  * Recomputes everything.
  * @param chain first order in the chain
@@ -253,6 +262,7 @@ void Order::AssignOrder(const Order &other)
  */
 void OrderList::Initialize(Vehicle *v)
 {
+	this->MarkOrdersChanged();
 	this->first_shared = v;
 
 	this->num_manual_orders = 0;
@@ -286,6 +296,17 @@ void OrderList::RecalculateTimetableDuration()
 	}
 }
 
+/**
+ * Get a new version for the orders of an order list.
+ * Versions are never reused, so cached results can't be mistaken for those of another list.
+ * @return The version.
+ */
+/* static */ uint64_t OrderList::NewVersion()
+{
+	static uint64_t last_version = 0;
+	return ++last_version;
+}
+
 /**
  * Free a complete order chain.
  * @param keep_orderlist If this is true only delete the orders, otherwise also delete the OrderList.
@@ -306,6 +327,7 @@ void OrderList::FreeChain(bool keep_orderlist)
 	}
 
 	if (keep_orderlist) {
+		this->MarkOrdersChanged();
 		this->orders.clear();
 		this->num_manual_orders = 0;
 		this->timetable_duration = 0;
@@ -420,6 +442,7 @@ void OrderList::InsertOrderAt(Order &&order, VehicleOrderID index)
 {
 	auto it = std::ranges::next(std::begin(this->orders), index, std::end(this->orders));
 	auto new_order = this->orders.emplace(it, std::move(order));
+	this->MarkOrdersChanged();
 
 	if (!new_order->IsType(OT_IMPLICIT)) ++this->num_manual_orders;
 	this->timetable_duration += new_order->GetTimetabledWait() + new_order->GetTimetabledTravel();
@@ -449,6 +472,7 @@ void OrderList::DeleteOrderAt(VehicleOrderID index)
 	this->total_duration -= (to_remove->GetWaitTime() + to_remove->GetTravelTime());
 
 	this->orders.erase(to_remove);
+	this->MarkOrdersChanged();
 }
 
 /**
@@ -468,6 +492,7 @@ void OrderList::MoveOrder(VehicleOrderID from, VehicleOrderID to)
 	} else {
 		std::rotate(it + to, it + from, it + from + 1);
 	}
+	this->MarkOrdersChanged();
 }
 
 /**
@@ -892,6 +917,7 @@ void InsertOrder(Vehicle *v, Order &&new_o, VehicleOrderID sel_ord)
 		}
 		cur_order_id++;
 	}
+	v->orders->MarkOrdersChanged();
 
 	/* Make sure to rebuild the whole list */
 	InvalidateWindowClassesData(GetWindowClassForVehicleType(v->type), 0);
@@ -1010,6 +1036,7 @@ void DeleteOrder(Vehicle *v, VehicleOrderID sel_ord)
 		}
 		cur_order_id++;
 	}
+	v->orders->MarkOrdersChanged();
 
 	InvalidateWindowClassesData(GetWindowClassForVehicleType(v->type), 0);
 }
@@ -1138,6 +1165,7 @@ CommandCost CmdMoveOrder(DoCommandFlags flags, VehicleID veh, VehicleOrderID mov
 				order.SetConditionSkipToOrder(order_id);
 			}
 		}
+		v->orders->MarkOrdersChanged();
 
 		/* Make sure to rebuild the whole list */
 		InvalidateWindowClassesData(GetWindowClassForVehicleType(v->type), 0);
@@ -1375,6 +1403,7 @@ CommandCost CmdModifyOrder(DoCommandFlags flags, VehicleID veh, VehicleOrderID s
 
 			default: NOT_REACHED();
 		}
+		v->orders->MarkOrdersChanged();
 
 		/* Update the windows and full load flags, also for vehicles that share the same order list */
 		Vehicle *u = v->FirstShared();
@@ -1610,6 +1639,7 @@ CommandCost CmdOrderRefit(DoCommandFlags flags, VehicleID veh, VehicleOrderID or
 			order->SetDepotOrderType((OrderDepotTypeFlags)(order->GetDepotOrderType() & ~ODTFB_SERVICE));
 			order->SetDepotActionType((OrderDepotActionFlags)(order->GetDepotActionType() & ~ODATFB_HALT));
 		}
+		v->orders->MarkOrdersChanged();
 
 		for (Vehicle *u = v->FirstShared(); u != nullptr; u = u->NextShared()) {
 			/* Update any possible open window of the vehicle */
@@ -1752,6 +1782,7 @@ void RemoveOrderFromAllVehicles(OrderType type, DestinationID destination, bool
 				bool travel_timetabled = order->IsTravelTimetabled();
 				order->MakeDummy();
 				order->SetTravelTimetabled(travel_timetabled);
+				v->orders->MarkOrdersChanged();
 
 				for (const Vehicle *w = v->FirstShared(); w != nullptr; w = w->NextShared()) {
 					/* In GUI, simulate by removing the order and adding it back */
@@ -21,6 +21,7 @@
 #include <time.h>
 #include <signal.h>
 #include <pthread.h>
+#include <sys/resource.h>
 
 #ifdef WITH_SDL2
 #include <SDL.h>
@@ -48,6 +49,10 @@
 #include <sys/sysctl.h>
 #endif
 
+#ifdef __APPLE__
+#	include <mach/mach.h>
+#endif
+
 #if defined(__APPLE__)
 #	include "../macosx/macos.h"
 #endif
@@ -252,3 +257,31 @@ void SetCurrentThreadName([[maybe_unused]] const std::string &thread_name)
 	MacOSSetThreadName(thread_name);
 #endif /* defined(__APPLE__) */
 }
+
+ProcessMemoryUsage GetProcessMemoryUsage()
+{
+	ProcessMemoryUsage usage;
+
+#if defined(__linux__)
+	if (auto f = FileHandle::Open(std::string{"/proc/self/statm"}, "r"); f.has_value()) {
+		unsigned long size, resident;
+		if (fscanf(*f, "%lu %lu", &size, &resident) == 2) usage.resident = static_cast<size_t>(resident) * sysconf(_SC_PAGESIZE);
+	}
+#elif defined(__APPLE__)
+	mach_task_basic_info_data_t info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) usage.resident = info.resident_size;
+#endif
+
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru) == 0) {
+#if defined(__APPLE__)
+		/* macOS reports bytes, everybody else kilobytes. */
+		usage.peak_resident = static_cast<size_t>(ru.ru_maxrss);
+#else
+		usage.peak_resident = static_cast<size_t>(ru.ru_maxrss) * 1024;
+#endif
+	}
+
+	return usage;
+}
@@ -20,6 +20,7 @@
 #include <shlobj.h> /* SHGetFolderPath */
 #include <shellapi.h>
 #include <winnls.h>
+#include <psapi.h>
 #include <io.h>
 #include "win32.h"
 #include "../../fios.h"
@@ -530,3 +531,16 @@ void SetCurrentThreadName(const std::string &thread_name)
 #else
 void SetCurrentThreadName(const std::string &) {}
 #endif
+
+ProcessMemoryUsage GetProcessMemoryUsage()
+{
+	ProcessMemoryUsage usage;
+
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		usage.resident = counters.WorkingSetSize;
+		usage.peak_resident = counters.PeakWorkingSetSize;
+	}
+
+	return usage;
+}
@@ -13,6 +13,11 @@
 #include "../../debug.h"
 #include "../../settings_type.h"
 #include "../../misc/dbg_helpers.h"
+#include "../../allocation_tracker.h"
+#include "../../tick_cost.h"
+#include "yapf_stats.h"
+
+#include <chrono>
 #include "yapf_type.hpp"
 
 /**
@@ -102,6 +107,11 @@ public:
 	 */
 	inline bool FindPath(const VehicleType *v)
 	{
+		AllocationScope allocations(AllocationTag::Pathfinder);
+		TickCostMeasurer tick_cost(v->owner, TickCostType::Pathfinder);
+		const auto start = std::chrono::steady_clock::now();
+		const int initial_cache_hits = this->stats_cache_hits;
+		const int initial_cost_calcs = this->stats_cost_calcs;
 		this->vehicle = v;
 
 		Yapf().PfSetStartupNodes();
@@ -125,6 +135,10 @@ public:
 
 		const bool destination_found = (this->best_dest_node != nullptr);
 
+		const bool max_nodes_hit = !destination_found && this->max_search_nodes != 0 && this->nodes.ClosedCount() >= this->max_search_nodes;
+		YapfRecordSearch(v, this->nodes.ClosedCount(), max_nodes_hit, this->stats_cache_hits - initial_cache_hits, this->stats_cost_calcs - initial_cost_calcs,
+				std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
 		if (_debug_yapf_level >= 3) {
 			const UnitID veh_idx = (this->vehicle != nullptr) ? this->vehicle->unitnumber : 0;
 			const char ttc = Yapf().TransportTypeChar();
@@ -0,0 +1,116 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file yapf_stats.cpp Statistics of YAPF searches and the log of slow searches. */
+
+#include "../../stdafx.h"
+#include "yapf_stats.h"
+#include "../../vehicle_base.h"
+#include "../../debug.h"
+#include "../../core/bitmath_func.hpp"
+
+#include "../../safeguards.h"
+
+static constexpr size_t SLOW_SEARCH_LOG_SIZE = 64; ///< Number of slow searches that are remembered.
+
+static std::array<YapfStats, VEH_COMPANY_END> _yapf_stats; ///< Statistics per vehicle type.
+static TimerGameTick::TickCounter _yapf_stats_start = 0; ///< Tick at which the statistics were last reset.
+
+static std::array<YapfSlowSearch, SLOW_SEARCH_LOG_SIZE> _yapf_slow_searches; ///< Ring buffer of slow searches.
+static size_t _yapf_slow_search_count = 0; ///< Number of slow searches ever logged.
+static uint64_t _yapf_slow_search_threshold = 5'000'000; ///< Duration above which a search is logged, in nanoseconds.
+
+/**
+ * Record the result of a pathfinder search.
+ * @param v The vehicle the search was for.
+ * @param nodes Number of nodes the search expanded.
+ * @param max_nodes_hit Whether the search gave up after max_search_nodes.
+ * @param cache_hits Number of segment costs reused from the cost cache.
+ * @param cost_calcs Number of segment costs that had to be calculated.
+ * @param ns Duration of the search, in nanoseconds.
+ */
+void YapfRecordSearch(const Vehicle *v, uint32_t nodes, bool max_nodes_hit, uint32_t cache_hits, uint32_t cost_calcs, uint64_t ns)
+{
+	assert(v->type < VEH_COMPANY_END);
+	YapfStats &stats = _yapf_stats[v->type];
+	stats.searches++;
+	stats.nodes += nodes;
+	if (max_nodes_hit) stats.max_nodes_hit++;
+	stats.cache_hits += cache_hits;
+	stats.cost_calcs += cost_calcs;
+	stats.ns += ns;
+
+	uint64_t us = ns / 1000;
+	size_t bucket = us == 0 ? 0 : FindLastBit(us) + 1;
+	stats.latency[std::min(bucket, YapfStats::LATENCY_BUCKETS - 1)]++;
+
+	if (ns < _yapf_slow_search_threshold) return;
+
+	_yapf_slow_searches[_yapf_slow_search_count % SLOW_SEARCH_LOG_SIZE] = {TimerGameTick::counter, v->index, v->type, v->tile, v->dest_tile, nodes, max_nodes_hit, ns};
+	_yapf_slow_search_count++;
+	Debug(yapf, 1, "Slow search for vehicle {}: {} nodes{} in {} us", v->index, nodes, max_nodes_hit ? " (gave up)" : "", us);
+}
+
+/**
+ * Get the search statistics of a vehicle type.
+ * @param type The vehicle type.
+ * @return The statistics since the last reset.
+ */
+const YapfStats &GetYapfStats(VehicleType type)
+{
+	assert(type < VEH_COMPANY_END);
+	return _yapf_stats[type];
+}
+
+/**
+ * Get the tick at which the statistics were last reset, to calculate the number of searches per tick.
+ * @return The tick counter at the last reset.
+ */
+TimerGameTick::TickCounter GetYapfStatsStart()
+{
+	return _yapf_stats_start;
+}
+
+/**
+ * Reset the search statistics and forget the logged slow searches.
+ */
+void ResetYapfStats()
+{
+	_yapf_stats = {};
+	_yapf_stats_start = TimerGameTick::counter;
+	_yapf_slow_search_count = 0;
+}
+
+/**
+ * Get the logged slow searches.
+ * @return The slow searches, oldest first.
+ */
+std::vector<YapfSlowSearch> GetYapfSlowSearches()
+{
+	std::vector<YapfSlowSearch> result;
+	size_t first = _yapf_slow_search_count > SLOW_SEARCH_LOG_SIZE ? _yapf_slow_search_count - SLOW_SEARCH_LOG_SIZE : 0;
+	for (size_t i = first; i < _yapf_slow_search_count; i++) result.push_back(_yapf_slow_searches[i % SLOW_SEARCH_LOG_SIZE]);
+	return result;
+}
+
+/**
+ * Set the duration above which a search is logged as slow.
+ * @param ns The threshold in nanoseconds.
+ */
+void SetYapfSlowSearchThreshold(uint64_t ns)
+{
+	_yapf_slow_search_threshold = ns;
+}
+
+/**
+ * Get the duration above which a search is logged as slow.
+ * @return The threshold in nanoseconds.
+ */
+uint64_t GetYapfSlowSearchThreshold()
+{
+	return _yapf_slow_search_threshold;
+}
@@ -0,0 +1,51 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file yapf_stats.h Statistics of YAPF searches and the log of slow searches. */
+
+#ifndef YAPF_STATS_H
+#define YAPF_STATS_H
+
+#include "../../tile_type.h"
+#include "../../vehicle_type.h"
+#include "../../timer/timer_game_tick.h"
+
+/** Statistics of the searches for a single vehicle type. */
+struct YapfStats {
+	static constexpr size_t LATENCY_BUCKETS = 16; ///< Bucket i counts searches of less than 2^i microseconds; the last bucket also counts all slower searches.
+
+	uint64_t searches = 0; ///< Number of searches.
+	uint64_t nodes = 0; ///< Number of nodes expanded by all searches.
+	uint64_t max_nodes_hit = 0; ///< Number of searches that gave up after max_search_nodes.
+	uint64_t cache_hits = 0; ///< Number of segment costs reused from the cost cache.
+	uint64_t cost_calcs = 0; ///< Number of segment costs that had to be calculated.
+	uint64_t ns = 0; ///< Total time of all searches, in nanoseconds.
+	std::array<uint64_t, LATENCY_BUCKETS> latency{}; ///< Histogram of the search times.
+};
+
+/** A search that took longer than the slow search threshold. */
+struct YapfSlowSearch {
+	TimerGameTick::TickCounter tick; ///< Tick of the search.
+	VehicleID vehicle; ///< Vehicle the search was for.
+	VehicleType type; ///< Type of the vehicle.
+	TileIndex origin; ///< Tile of the vehicle at the time of the search.
+	TileIndex destination; ///< Destination tile of the vehicle at the time of the search.
+	uint32_t nodes; ///< Number of nodes expanded.
+	bool max_nodes_hit; ///< Whether the search gave up after max_search_nodes.
+	uint64_t ns; ///< Duration of the search, in nanoseconds.
+};
+
+void YapfRecordSearch(const Vehicle *v, uint32_t nodes, bool max_nodes_hit, uint32_t cache_hits, uint32_t cost_calcs, uint64_t ns);
+const YapfStats &GetYapfStats(VehicleType type);
+TimerGameTick::TickCounter GetYapfStatsStart();
+void ResetYapfStats();
+
+std::vector<YapfSlowSearch> GetYapfSlowSearches();
+void SetYapfSlowSearchThreshold(uint64_t ns);
+uint64_t GetYapfSlowSearchThreshold();
+
+#endif /* YAPF_STATS_H */
@@ -14,6 +14,7 @@
 #include "roadstop_base.h"
 #include "station_base.h"
 #include "vehicle_func.h"
+#include "debug.h"
 
 #include "safeguards.h"
 
@@ -86,8 +87,8 @@ void RoadStop::MakeDriveThrough()
 		if (south && rs_south->entries != nullptr) {
 			/* There more southern tiles too, they must 'join' us too */
 			rs_south->status.Reset(RoadStopStatusFlag::BaseEntry);
-			this->entries->east.occupied += rs_south->entries->east.occupied;
-			this->entries->west.occupied += rs_south->entries->west.occupied;
+			this->entries->east.Join(rs_south->entries->east);
+			this->entries->west.Join(rs_south->entries->west);
 
 			/* Free the now unneeded entries struct */
 			delete rs_south->entries;
@@ -166,18 +167,14 @@ void RoadStop::ClearDriveThrough()
 				rs_north = RoadStop::GetByTile(north_tile, rst);
 			}
 
-			/* We have to rebuild the entries because we cannot easily determine
-			 * how full each part is. So instead of keeping and maintaining a list
-			 * of vehicles and using that to 'rebuild' the occupied state we just
-			 * rebuild it from scratch as that removes lots of maintenance code
-			 * for the vehicle list and it's faster in real games as long as you
-			 * do not keep split and merge road stop every tick by the millions. */
-			rs_south_base->entries->east.Rebuild(rs_south_base);
-			rs_south_base->entries->west.Rebuild(rs_south_base);
-
+			/* Hand the vehicles on the southern part over to its own entries. */
 			assert(rs_north->status.Test(RoadStopStatusFlag::BaseEntry));
-			rs_north->entries->east.Rebuild(rs_north);
-			rs_north->entries->west.Rebuild(rs_north);
+			rs_north->entries->east.SplitOff(rs_south_base, rs_south_base->entries->east);
+			rs_north->entries->west.SplitOff(rs_south_base, rs_south_base->entries->west);
+
+			/* And remove ourselves from the northern part. */
+			rs_north->entries->east.length -= TILE_SIZE;
+			rs_north->entries->west.length -= TILE_SIZE;
 		} else {
 			/* Only we left, so simple update the length. */
 			rs_north->entries->east.length -= TILE_SIZE;
@@ -270,6 +267,11 @@ void RoadStop::Entry::Leave(const RoadVehicle *rv)
 {
 	assert(this->occupied >= rv->gcache.cached_total_length);
 	this->occupied -= rv->gcache.cached_total_length;
+
+	/* Vehicles mostly leave in the order they entered, so this is usually the first one. */
+	auto it = std::ranges::find(this->vehicles, rv->index);
+	assert(it != std::end(this->vehicles));
+	this->vehicles.erase(it);
 }
 
 /**
@@ -282,6 +284,54 @@ void RoadStop::Entry::Enter(const RoadVehicle *rv)
 	 * remote possibility that RVs are running through each other when
 	 * trying to prevention an infinite jam. */
 	this->occupied += rv->gcache.cached_total_length;
+	this->vehicles.push_back(rv->index);
+}
+
+/**
+ * Join the entry of another drive through stop that got connected to the end of this one.
+ * @param other the entry to take the vehicles and occupied space of
+ */
+void RoadStop::Entry::Join(Entry &other)
+{
+	this->occupied += other.occupied;
+	this->vehicles.insert(std::end(this->vehicles), std::begin(other.vehicles), std::end(other.vehicles));
+}
+
+/**
+ * Split off the southern part of this entry when the drive through stop is cut in two.
+ * The vehicles in the stop are known, so they are divided by their position
+ * instead of looking for them on the tiles of the stop.
+ * @param rs    the base road stop of the part that is split off
+ * @param other the (empty) entry of the part that is split off
+ * @note The length of the tile that cuts the stop in two is not removed.
+ */
+void RoadStop::Entry::SplitOff(const RoadStop *rs, Entry &other)
+{
+	assert(rs->status.Test(RoadStopStatusFlag::BaseEntry));
+	assert(other.length == 0 && other.occupied == 0 && other.vehicles.empty());
+
+	Axis axis = GetDriveThroughStopAxis(rs->xy);
+	TileIndexDiff offset = TileOffsByAxis(axis);
+	for (TileIndex tile = rs->xy; IsDriveThroughRoadStopContinuation(rs->xy, tile); tile += offset) {
+		other.length += TILE_SIZE;
+	}
+	this->length -= other.length;
+
+	/* All vehicles are on the same line, so the ones at or beyond the base of the other part are in it. */
+	auto coordinate = [axis](TileIndex tile) { return axis == AXIS_X ? TileX(tile) : TileY(tile); };
+	uint split = coordinate(rs->xy);
+	for (auto it = std::begin(this->vehicles); it != std::end(this->vehicles);) {
+		const RoadVehicle *rv = RoadVehicle::Get(*it);
+		if (coordinate(rv->tile) < split) {
+			++it;
+			continue;
+		}
+
+		other.vehicles.push_back(*it);
+		other.occupied += rv->gcache.cached_total_length;
+		this->occupied -= rv->gcache.cached_total_length;
+		it = this->vehicles.erase(it);
+	}
 }
 
 /**
@@ -347,8 +397,10 @@ void RoadStop::Entry::Rebuild(const RoadStop *rs, int side)
 	}
 
 	this->occupied = 0;
+	this->vehicles.clear();
 	for (const auto &it : vehicles) {
 		this->occupied += it->gcache.cached_total_length;
+		this->vehicles.push_back(it->index);
 	}
 }
 
@@ -365,6 +417,19 @@ void RoadStop::Entry::CheckIntegrity(const RoadStop *rs) const
 	assert(IsDriveThroughStopTile(rs->xy));
 	assert(!IsDriveThroughRoadStopContinuation(rs->xy, rs->xy - TileOffsByAxis(GetDriveThroughStopAxis(rs->xy))));
 
+	/* The occupied space is that of the vehicles that entered. */
+	uint occupied = 0;
+	for (VehicleID id : this->vehicles) {
+		const RoadVehicle *rv = RoadVehicle::GetIfValid(id);
+		if (rv == nullptr || !rv->IsFrontEngine()) NOT_REACHED();
+		occupied += rv->gcache.cached_total_length;
+	}
+	if (occupied != this->occupied) NOT_REACHED();
+
+	/* And those vehicles are the ones that are actually in the stop.
+	 * Looking for them on the tiles is slow, so only do so when asked for. */
+	if (_debug_desync_level <= 2) return;
+
 	Entry temp;
 	temp.Rebuild(rs, &rs->entries->east == this);
 	if (temp.length != this->length || temp.occupied != this->occupied) NOT_REACHED();
@@ -33,6 +33,7 @@ struct RoadStop : RoadStopPool::PoolItem<&_roadstop_pool> {
 	private:
 		uint16_t length = 0; ///< The length of the stop in tile 'units'
 		uint16_t occupied = 0; ///< The amount of occupied stop in tile 'units'
+		std::vector<VehicleID> vehicles; ///< The vehicles in the stop, in order of entering
 
 	public:
 		friend struct RoadStop; ///< Oh yeah, the road stop may play with me.
@@ -57,6 +58,8 @@ struct RoadStop : RoadStopPool::PoolItem<&_roadstop_pool> {
 
 		void Leave(const RoadVehicle *rv);
 		void Enter(const RoadVehicle *rv);
+		void Join(Entry &other);
+		void SplitOff(const RoadStop *rs, Entry &other);
 		void CheckIntegrity(const RoadStop *rs) const;
 		void Rebuild(const RoadStop *rs, int side = -1);
 	};
@@ -66,6 +66,8 @@
 #include "../timer/timer_game_economy.h"
 #include "../timer/timer_game_tick.h"
 #include "../picker_func.h"
+#include "../depot_func.h"
+#include "../linkgraph/refresh.h"
 
 #include "saveload_internal.h"
 
@@ -572,6 +574,7 @@ bool AfterLoadGame()
 
 	RebuildTownKdtree();
 	RebuildStationKdtree();
+	InvalidateDepotKdtrees();
 	/* This needs to be done even before conversion, because some conversions will destroy objects
 	 * that otherwise won't exist in the tree. */
 	RebuildViewportKdtree();
@@ -3451,6 +3454,8 @@ void ReloadNewGRFData()
 	AfterLoadVehiclesPhase2(false);
 	StartupEngines();
 	GroupStatistics::UpdateAfterLoad();
+	/* Refit masks might have changed */
+	LinkRefresher::ClearPredictions();
 	/* update station graphics */
 	AfterLoadStations();
 	/* Update company statistics. */
@@ -0,0 +1,623 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file savegame_store.cpp Deduplicating store for savegames, sharing identical parts between them.
+ *
+ * Consecutive autosaves are mostly identical; in particular the map hardly
+ * changes. The store therefore keeps the uncompressed savegame stream cut
+ * into content-defined blocks: the block boundaries are determined by a
+ * rolling hash over the data itself, so an insertion or removal only changes
+ * the blocks around it. Every block is kept once in a single pack file and
+ * each stored savegame is a list of block hashes.
+ */
+
+#include "../stdafx.h"
+#include "../debug.h"
+#include "../fileio_func.h"
+#include "../string_func.h"
+#include "../settings_type.h"
+#include "../3rdparty/md5/md5.h"
+#include "saveload_filter.h"
+#include "saveload_error.hpp"
+#include "savegame_store.h"
+
+#include "../table/strings.h"
+
+#include <filesystem>
+#include <mutex>
+
+#if defined(WITH_ZLIB)
+#include <zlib.h>
+#endif /* WITH_ZLIB */
+
+#include "../safeguards.h"
+
+static const uint64_t STORE_BOUNDARY_MASK = 0xFFFC000000000000ULL; ///< 14 bits of the rolling hash, so on average a block per 16 KiB.
+
+static const uint32_t STORE_INDEX_TAG = 'OTSI'; ///< Tag at the start of an index file.
+static const uint32_t STORE_INDEX_VERSION = 1; ///< Version of the index file format.
+static const std::string_view STORE_PACK_NAME = "store.pack"; ///< Name of the file with the blocks.
+static const std::string_view STORE_INDEX_EXTENSION = ".idx"; ///< Extension of the index files.
+
+static const size_t STORE_BLOCK_HEADER_SIZE = MD5_HASH_BYTES + 4 + 4 + 1; ///< Hash, raw size, stored size and encoding.
+
+/** Location of a block in the pack. */
+struct StoreBlock {
+	size_t offset; ///< Offset of the block data in the pack, just after the header.
+	uint32_t raw_size; ///< Size of the block when decoded.
+	uint32_t stored_size; ///< Size of the block in the pack.
+	StoreBlockEncoding encoding; ///< How the block is stored.
+};
+
+/** The contents of an index file. */
+struct StoreIndex {
+	uint64_t raw_size = 0; ///< Size of the savegame.
+	std::vector<MD5Hash> blocks; ///< Hashes of the blocks the savegame consists of, in order.
+};
+
+/* The state of the store is used by the thread that saves the game, so it may only be accessed with #_store_mutex held. */
+static std::mutex _store_mutex; ///< Protects the state of the store below.
+static std::map<MD5Hash, StoreBlock> _store_blocks; ///< All blocks in the pack.
+static size_t _store_pack_size = 0; ///< Size of the valid part of the pack.
+static bool _store_scanned = false; ///< Whether #_store_blocks reflects the pack on disk.
+static SavegameStoreStats _store_last_stats; ///< Statistics of the last stored savegame.
+
+/** Random values for the gear hash, one per byte value. */
+static const std::array<uint64_t, 256> _store_gear = []() {
+	std::array<uint64_t, 256> gear{};
+	uint64_t state = 0;
+	for (auto &g : gear) {
+		/* SplitMix64, so the table is the same on every platform and run. */
+		state += 0x9E3779B97F4A7C15ULL;
+		uint64_t z = state;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		g = z ^ (z >> 31);
+	}
+	return gear;
+}();
+
+static void WriteStoreUint32(uint8_t *buf, uint32_t value)
+{
+	for (int i = 0; i < 4; i++) buf[i] = GB(value, i * 8, 8);
+}
+
+static uint32_t ReadStoreUint32(const uint8_t *buf)
+{
+	return buf[0] | buf[1] << 8 | buf[2] << 16 | static_cast<uint32_t>(buf[3]) << 24;
+}
+
+/**
+ * Get the directory of the store, creating it when needed.
+ * @return The directory, with trailing path separator.
+ */
+static std::string GetStoreDirectory()
+{
+	std::string dir = FioFindDirectory(AUTOSAVE_DIR) + "store" PATHSEP;
+	FioCreateDirectory(dir);
+	return dir;
+}
+
+/**
+ * Get the full path of the pack.
+ * @return The path.
+ */
+static std::string GetStorePackPath()
+{
+	return GetStoreDirectory() + std::string{STORE_PACK_NAME};
+}
+
+/**
+ * Read the headers of all blocks in the pack, to know which blocks are stored.
+ * A partially written block at the end, e.g. due to a crash, is ignored and
+ * will be overwritten by the next block that is stored.
+ * The pack is only read again when it has been removed or truncated since it was last read.
+ * @pre #_store_mutex is held.
+ */
+static void ScanStorePack()
+{
+	std::string filename = GetStorePackPath();
+	if (_store_scanned) {
+		std::error_code ec;
+		uintmax_t size = std::filesystem::file_size(OTTD2FS(filename), ec);
+		if (!ec && size >= _store_pack_size) return;
+	}
+
+	_store_blocks.clear();
+	_store_pack_size = 0;
+	_store_scanned = true;
+
+	auto f = FileHandle::Open(filename, "rb");
+	if (!f.has_value()) return;
+
+	fseek(*f, 0, SEEK_END);
+	size_t file_size = ftell(*f);
+	fseek(*f, 0, SEEK_SET);
+
+	uint8_t header[STORE_BLOCK_HEADER_SIZE];
+	while (fread(header, 1, sizeof(header), *f) == sizeof(header)) {
+		MD5Hash hash;
+		std::copy_n(header, MD5_HASH_BYTES, hash.begin());
+		StoreBlock block;
+		block.offset = _store_pack_size + STORE_BLOCK_HEADER_SIZE;
+		block.raw_size = ReadStoreUint32(header + MD5_HASH_BYTES);
+		block.stored_size = ReadStoreUint32(header + MD5_HASH_BYTES + 4);
+		block.encoding = static_cast<StoreBlockEncoding>(header[MD5_HASH_BYTES + 8]);
+
+		if (block.offset + block.stored_size > file_size || fseek(*f, block.stored_size, SEEK_CUR) != 0) break;
+
+		_store_blocks.try_emplace(hash, block);
+		_store_pack_size = block.offset + block.stored_size;
+	}
+
+	Debug(sl, 3, "Savegame store contains {} blocks in {} KiB", _store_blocks.size(), _store_pack_size / 1024);
+}
+
+/**
+ * Read an index file.
+ * @param filename Full path of the index.
+ * @return The index, or std::nullopt when it could not be read.
+ */
+static std::optional<StoreIndex> ReadStoreIndex(const std::string &filename)
+{
+	auto f = FileHandle::Open(filename, "rb");
+	if (!f.has_value()) return std::nullopt;
+
+	uint8_t header[20];
+	if (fread(header, 1, sizeof(header), *f) != sizeof(header)) return std::nullopt;
+	if (ReadStoreUint32(header) != STORE_INDEX_TAG || ReadStoreUint32(header + 4) != STORE_INDEX_VERSION) return std::nullopt;
+
+	StoreIndex index;
+	index.raw_size = ReadStoreUint32(header + 8) | static_cast<uint64_t>(ReadStoreUint32(header + 12)) << 32;
+	index.blocks.resize(ReadStoreUint32(header + 16));
+	for (MD5Hash &hash : index.blocks) {
+		if (fread(hash.data(), 1, hash.size(), *f) != hash.size()) return std::nullopt;
+	}
+	return index;
+}
+
+/**
+ * Get the full path of the index file of a stored savegame.
+ * @param name The name of the stored savegame.
+ * @return The path.
+ */
+static std::string GetStoreIndexPath(const std::string &name)
+{
+	/* The name comes from the user, so it must not lead out of the store. */
+	std::string filename = name;
+	SanitizeFilename(filename);
+	return GetStoreDirectory() + filename + std::string{STORE_INDEX_EXTENSION};
+}
+
+/**
+ * Remove the blocks that are not used by any stored savegame anymore from the
+ * pack, when they take up more space than the blocks that are still used.
+ * @pre #_store_mutex is held.
+ */
+static void CompactStorePack()
+{
+	std::set<MD5Hash> live;
+	for (const std::string &name : GetStoredSavegames()) {
+		auto index = ReadStoreIndex(GetStoreIndexPath(name));
+		/* When we can not tell which blocks are used, we can not safely remove any. */
+		if (!index.has_value()) return;
+		live.insert(index->blocks.begin(), index->blocks.end());
+	}
+
+	size_t live_size = 0;
+	for (const MD5Hash &hash : live) {
+		auto it = _store_blocks.find(hash);
+		if (it != _store_blocks.end()) live_size += STORE_BLOCK_HEADER_SIZE + it->second.stored_size;
+	}
+	if (_store_pack_size <= live_size * 2) return;
+
+	std::string pack_name = GetStorePackPath();
+	std::string new_name = pack_name + ".new";
+
+	auto in = FileHandle::Open(pack_name, "rb");
+	auto out = FileHandle::Open(new_name, "wb");
+	if (!in.has_value() || !out.has_value()) return;
+
+	std::map<MD5Hash, StoreBlock> blocks;
+	size_t size = 0;
+	std::vector<uint8_t> buffer;
+	for (const auto &[hash, block] : _store_blocks) {
+		if (!live.contains(hash)) continue;
+
+		buffer.resize(STORE_BLOCK_HEADER_SIZE + block.stored_size);
+		if (fseek(*in, block.offset - STORE_BLOCK_HEADER_SIZE, SEEK_SET) != 0 ||
+				fread(buffer.data(), 1, buffer.size(), *in) != buffer.size() ||
+				fwrite(buffer.data(), 1, buffer.size(), *out) != buffer.size()) {
+			Debug(sl, 0, "Compacting the savegame store failed");
+			out.reset();
+			FioRemove(new_name);
+			return;
+		}
+
+		StoreBlock moved = block;
+		moved.offset = size + STORE_BLOCK_HEADER_SIZE;
+		blocks.emplace(hash, moved);
+		size += buffer.size();
+	}
+	in.reset();
+	out.reset();
+
+	std::error_code ec;
+	std::filesystem::rename(OTTD2FS(new_name), OTTD2FS(pack_name), ec);
+	if (ec) {
+		Debug(sl, 0, "Renaming {} to {} failed: {}", new_name, pack_name, ec.message());
+		FioRemove(new_name);
+		return;
+	}
+
+	Debug(sl, 1, "Compacted savegame store from {} KiB to {} KiB", _store_pack_size / 1024, size / 1024);
+	_store_blocks = std::move(blocks);
+	_store_pack_size = size;
+}
+
+/**
+ * Create the chunker.
+ * @param proc The function to call with every block that is cut.
+ */
+SavegameStoreChunker::SavegameStoreChunker(BlockProc proc) : proc(std::move(proc))
+{
+	this->block.reserve(MAX_BLOCK_SIZE);
+}
+
+/**
+ * Add data to the stream, and cut the blocks that end in it.
+ * @param data The data.
+ */
+void SavegameStoreChunker::Write(std::span<const uint8_t> data)
+{
+	while (!data.empty()) {
+		/* Find the next block boundary within the new data. */
+		size_t i = 0;
+		bool boundary = false;
+		size_t filled = this->block.size();
+		while (i < data.size()) {
+			this->rolling_hash = (this->rolling_hash << 1) + _store_gear[data[i]];
+			i++;
+			if (filled + i >= MAX_BLOCK_SIZE || (filled + i >= MIN_BLOCK_SIZE && (this->rolling_hash & STORE_BOUNDARY_MASK) == 0)) {
+				boundary = true;
+				break;
+			}
+		}
+
+		this->block.insert(this->block.end(), data.begin(), data.begin() + i);
+		if (boundary) this->CutBlock();
+		data = data.subspan(i);
+	}
+}
+
+/** End the stream; cuts the last block, if there is any data left. */
+void SavegameStoreChunker::Finish()
+{
+	if (!this->block.empty()) this->CutBlock();
+}
+
+/** Pass the current block on, and start a new one. */
+void SavegameStoreChunker::CutBlock()
+{
+	this->proc(this->block);
+	this->block.clear();
+	this->rolling_hash = 0;
+}
+
+/**
+ * Encode a block for storing it in the pack; it is compressed when that makes it smaller.
+ * @param raw The data of the block.
+ * @param buffer Buffer for the encoded data, when it differs from \a raw.
+ * @param[out] encoding How the block is encoded.
+ * @return The data to store; either \a raw or part of \a buffer.
+ */
+std::span<const uint8_t> EncodeStoreBlock(std::span<const uint8_t> raw, std::vector<uint8_t> &buffer, StoreBlockEncoding &encoding)
+{
+#if defined(WITH_ZLIB)
+	buffer.resize(compressBound(static_cast<uLong>(raw.size())));
+	uLongf compressed_size = static_cast<uLongf>(buffer.size());
+	if (compress2(buffer.data(), &compressed_size, raw.data(), static_cast<uLong>(raw.size()), 6) == Z_OK && compressed_size < raw.size()) {
+		encoding = SBE_ZLIB;
+		return std::span<const uint8_t>(buffer.data(), compressed_size);
+	}
+#endif /* WITH_ZLIB */
+
+	encoding = SBE_RAW;
+	return raw;
+}
+
+/**
+ * Decode a block that was stored in the pack.
+ * @param encoding How the block is encoded.
+ * @param stored The data of the block in the pack.
+ * @param raw_size The size of the block when decoded.
+ * @param[out] raw The decoded data.
+ * @return True iff the block could be decoded to the expected size.
+ */
+bool DecodeStoreBlock(StoreBlockEncoding encoding, std::span<const uint8_t> stored, size_t raw_size, std::vector<uint8_t> &raw)
+{
+	switch (encoding) {
+		case SBE_RAW:
+			if (stored.size() != raw_size) return false;
+			raw.assign(stored.begin(), stored.end());
+			return true;
+
+#if defined(WITH_ZLIB)
+		case SBE_ZLIB: {
+			raw.resize(raw_size);
+			uLongf size = static_cast<uLongf>(raw.size());
+			return uncompress(raw.data(), &size, stored.data(), static_cast<uLong>(stored.size())) == Z_OK && size == raw_size;
+		}
+#endif /* WITH_ZLIB */
+
+		default:
+			return false;
+	}
+}
+
+/** Filter that cuts the savegame into blocks and adds the new ones to the store. */
+struct StoreSaveFilter : SaveFilter {
+	std::string name; ///< Name the savegame is stored under.
+	std::optional<FileHandle> pack; ///< The pack, opened for appending.
+	SavegameStoreChunker chunker; ///< Cutter of the savegame into blocks.
+	StoreIndex index; ///< Index of the savegame being stored.
+	SavegameStoreStats stats; ///< Statistics of storing this savegame.
+
+	/**
+	 * Create the filter.
+	 * @param name The name to store the savegame under.
+	 */
+	StoreSaveFilter(const std::string &name) : SaveFilter(nullptr), name(name), chunker([this](std::span<const uint8_t> block) { this->AddBlock(block); })
+	{
+		/* Notice when the pack was removed since the last save. */
+		std::lock_guard<std::mutex> lock(_store_mutex);
+		ScanStorePack();
+	}
+
+	void Write(uint8_t *buf, size_t size) override
+	{
+		this->chunker.Write(std::span<const uint8_t>(buf, size));
+	}
+
+	void Finish() override
+	{
+		this->chunker.Finish();
+		this->pack.reset();
+
+		this->WriteIndex();
+
+		std::lock_guard<std::mutex> lock(_store_mutex);
+		CompactStorePack();
+
+		this->stats.store_bytes = _store_pack_size;
+		_store_last_stats = this->stats;
+		Debug(sl, 1, "Stored '{}': {} KiB in {} blocks, {} new blocks of {} KiB ({} KiB written), {:.1f}% deduplicated; store is {} KiB",
+				this->name, this->stats.raw_bytes / 1024, this->stats.blocks, this->stats.new_blocks, this->stats.new_bytes / 1024,
+				this->stats.written_bytes / 1024, this->stats.DedupRatio() * 100, this->stats.store_bytes / 1024);
+	}
+
+private:
+	/**
+	 * Add a block to the savegame, and to the pack if it is not there yet.
+	 * @param block The data of the block.
+	 */
+	void AddBlock(std::span<const uint8_t> block)
+	{
+		MD5Hash hash;
+		Md5 checksum;
+		checksum.Append(block.data(), block.size());
+		checksum.Finish(hash);
+
+		this->index.blocks.push_back(hash);
+		this->index.raw_size += block.size();
+		this->stats.raw_bytes += block.size();
+		this->stats.blocks++;
+
+		std::lock_guard<std::mutex> lock(_store_mutex);
+		if (!_store_scanned) ScanStorePack();
+		if (!_store_blocks.contains(hash)) this->AppendBlock(hash, block);
+	}
+
+	/**
+	 * Append a block to the pack.
+	 * @param hash The hash of the block.
+	 * @param block The data of the block.
+	 * @pre #_store_mutex is held.
+	 */
+	void AppendBlock(const MD5Hash &hash, std::span<const uint8_t> block)
+	{
+		if (!this->pack.has_value()) {
+			std::string filename = GetStorePackPath();
+			this->pack = FileHandle::Open(filename, "r+b");
+			if (!this->pack.has_value() && _store_pack_size != 0) {
+				/* The pack disappeared while saving, so the blocks this savegame shares with it are lost. */
+				_store_scanned = false;
+				SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE);
+			}
+			if (!this->pack.has_value()) this->pack = FileHandle::Open(filename, "w+b");
+			if (!this->pack.has_value()) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE);
+		}
+
+		std::vector<uint8_t> buffer;
+		StoreBlockEncoding encoding;
+		std::span<const uint8_t> data = EncodeStoreBlock(block, buffer, encoding);
+
+		uint8_t header[STORE_BLOCK_HEADER_SIZE];
+		std::copy(hash.begin(), hash.end(), header);
+		WriteStoreUint32(header + MD5_HASH_BYTES, static_cast<uint32_t>(block.size()));
+		WriteStoreUint32(header + MD5_HASH_BYTES + 4, static_cast<uint32_t>(data.size()));
+		header[MD5_HASH_BYTES + 8] = encoding;
+
+		if (fseek(*this->pack, _store_pack_size, SEEK_SET) != 0 ||
+				fwrite(header, 1, sizeof(header), *this->pack) != sizeof(header) ||
+				fwrite(data.data(), 1, data.size(), *this->pack) != data.size()) {
+			/* Whatever got written is beyond the known end, so it will be overwritten by the next block. */
+			SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE);
+		}
+
+		_store_blocks.try_emplace(hash, StoreBlock{_store_pack_size + STORE_BLOCK_HEADER_SIZE, static_cast<uint32_t>(block.size()), static_cast<uint32_t>(data.size()), encoding});
+		_store_pack_size += sizeof(header) + data.size();
+
+		this->stats.new_bytes += block.size();
+		this->stats.written_bytes += sizeof(header) + data.size();
+		this->stats.new_blocks++;
+	}
+
+	/** Write the index of the stored savegame, replacing any previous one with the same name. */
+	void WriteIndex()
+	{
+		std::string filename = GetStoreIndexPath(this->name);
+		std::string new_name = filename + ".new";
+
+		auto f = FileHandle::Open(new_name, "wb");
+		if (!f.has_value()) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE);
+
+		uint8_t header[20];
+		WriteStoreUint32(header, STORE_INDEX_TAG);
+		WriteStoreUint32(header + 4, STORE_INDEX_VERSION);
+		WriteStoreUint32(header + 8, GB(this->index.raw_size, 0, 32));
+		WriteStoreUint32(header + 12, GB(this->index.raw_size, 32, 32));
+		WriteStoreUint32(header + 16, static_cast<uint32_t>(this->index.blocks.size()));
+
+		bool ok = fwrite(header, 1, sizeof(header), *f) == sizeof(header);
+		for (const MD5Hash &hash : this->index.blocks) {
+			if (!ok) break;
+			ok = fwrite(hash.data(), 1, hash.size(), *f) == hash.size();
+		}
+		f.reset();
+		if (!ok) {
+			FioRemove(new_name);
+			SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE);
+		}
+
+		/* Only replace the old index once the new one is complete. */
+		std::error_code ec;
+		std::filesystem::rename(OTTD2FS(new_name), OTTD2FS(filename), ec);
+		if (ec) {
+			FioRemove(new_name);
+			SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE, ec.message());
+		}
+	}
+};
+
+/**
+ * Save the current game into the store.
+ * @param name The name to store the savegame under; an existing savegame with that name is replaced.
+ * @param threaded Whether saving may be done in a separate thread.
+ * @return #SL_OK or #SL_ERROR.
+ */
+SaveOrLoadResult SaveToStore(const std::string &name, bool threaded)
+{
+	WaitTillSaved();
+	if (!_settings_client.gui.threaded_saves) threaded = false;
+
+	/* Compression would hide the similarities between savegames; the blocks are compressed on their own instead. */
+	return SaveWithFilter(std::make_shared<StoreSaveFilter>(name), threaded, true);
+}
+
+/**
+ * Rebuild a savegame from the store.
+ * @param name The name of the stored savegame.
+ * @param filename The file to write the savegame to, in the save directory.
+ * @return True iff the savegame was written; otherwise no file is left behind.
+ */
+bool RestoreFromStore(const std::string &name, const std::string &filename)
+{
+	WaitTillSaved();
+
+	auto index = ReadStoreIndex(GetStoreIndexPath(name));
+	if (!index.has_value()) {
+		Debug(sl, 0, "No valid stored savegame named '{}'", name);
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(_store_mutex);
+	ScanStorePack();
+	auto pack = FileHandle::Open(GetStorePackPath(), "rb");
+	if (!pack.has_value()) {
+		/* Whatever we knew about the pack is wrong now. */
+		_store_scanned = false;
+		return false;
+	}
+
+	std::string path = filename;
+	SanitizeFilename(path);
+	path = FioFindDirectory(SAVE_DIR) + path;
+	auto out = FileHandle::Open(path, "wb");
+	if (!out.has_value()) return false;
+
+	/* Do not leave a partial savegame behind. */
+	auto fail = [&out, &path]() {
+		out.reset();
+		FioRemove(path);
+		return false;
+	};
+
+	std::vector<uint8_t> stored;
+	std::vector<uint8_t> raw;
+	for (const MD5Hash &hash : index->blocks) {
+		auto it = _store_blocks.find(hash);
+		if (it == _store_blocks.end()) {
+			Debug(sl, 0, "Stored savegame '{}' refers to a missing block", name);
+			return fail();
+		}
+		const StoreBlock &block = it->second;
+
+		stored.resize(block.stored_size);
+		if (fseek(*pack, block.offset, SEEK_SET) != 0 || fread(stored.data(), 1, stored.size(), *pack) != stored.size()) return fail();
+
+		if (!DecodeStoreBlock(block.encoding, stored, block.raw_size, raw)) {
+			Debug(sl, 0, "Stored savegame '{}' contains a block that can not be decoded", name);
+			return fail();
+		}
+
+		MD5Hash check;
+		Md5 checksum;
+		checksum.Append(raw.data(), raw.size());
+		checksum.Finish(check);
+		if (check != hash) {
+			Debug(sl, 0, "Stored savegame '{}' contains a corrupt block", name);
+			return fail();
+		}
+
+		if (fwrite(raw.data(), 1, raw.size(), *out) != raw.size()) return fail();
+	}
+
+	return true;
+}
+
+/**
+ * Get the names of all savegames in the store.
+ * @return The sorted names.
+ */
+std::vector<std::string> GetStoredSavegames()
+{
+	std::vector<std::string> names;
+
+	std::error_code ec;
+	for (const auto &entry : std::filesystem::directory_iterator(OTTD2FS(GetStoreDirectory()), ec)) {
+		if (!entry.is_regular_file(ec)) continue;
+
+		std::string filename = FS2OTTD(entry.path().filename().native());
+		if (!filename.ends_with(STORE_INDEX_EXTENSION)) continue;
+		names.push_back(filename.substr(0, filename.size() - STORE_INDEX_EXTENSION.size()));
+	}
+
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+/**
+ * Get the statistics of the savegame that was stored last.
+ * @return The statistics.
+ */
+SavegameStoreStats GetLastSavegameStoreStats()
+{
+	std::lock_guard<std::mutex> lock(_store_mutex);
+	return _store_last_stats;
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file savegame_store.h Deduplicating store for savegames, sharing identical parts between them. */
+
+#ifndef SAVEGAME_STORE_H
+#define SAVEGAME_STORE_H
+
+#include "saveload.h"
+
+/** Statistics of storing a single savegame in the store. */
+struct SavegameStoreStats {
+	size_t raw_bytes = 0; ///< Size of the uncompressed savegame.
+	size_t new_bytes = 0; ///< Uncompressed size of the blocks that were not in the store yet.
+	size_t written_bytes = 0; ///< Bytes actually appended to the store.
+	size_t blocks = 0; ///< Number of blocks the savegame was cut into.
+	size_t new_blocks = 0; ///< Number of those blocks that were not in the store yet.
+	size_t store_bytes = 0; ///< Size of the store after adding the savegame.
+
+	/**
+	 * Get the fraction of the savegame that was already in the store.
+	 * @return Ratio between 0 and 1.
+	 */
+	double DedupRatio() const
+	{
+		return this->raw_bytes == 0 ? 0.0 : 1.0 - static_cast<double>(this->new_bytes) / this->raw_bytes;
+	}
+};
+
+/** How the data of a block is stored in the pack. */
+enum StoreBlockEncoding : uint8_t {
+	SBE_RAW = 0, ///< Stored as is.
+	SBE_ZLIB = 1, ///< Compressed with zlib.
+};
+
+/**
+ * Cutter of a stream into content-defined blocks. The block boundaries are
+ * determined by a rolling hash over the data itself, so an insertion or
+ * removal only changes the blocks around it, and the boundaries do not
+ * depend on how the stream is split over the calls to #Write.
+ */
+class SavegameStoreChunker {
+public:
+	static constexpr size_t MIN_BLOCK_SIZE = 4 * 1024; ///< Never cut blocks smaller than this, except at the end.
+	static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024; ///< Always cut blocks at this size.
+
+	/** Function that is called with every block that is cut. */
+	using BlockProc = std::function<void(std::span<const uint8_t> block)>;
+
+	explicit SavegameStoreChunker(BlockProc proc);
+	void Write(std::span<const uint8_t> data);
+	void Finish();
+
+private:
+	BlockProc proc; ///< Function that is called with every block.
+	std::vector<uint8_t> block; ///< Data of the block that is currently being cut.
+	uint64_t rolling_hash = 0; ///< Gear hash of the last 64 bytes of #block.
+
+	void CutBlock();
+};
+
+std::span<const uint8_t> EncodeStoreBlock(std::span<const uint8_t> raw, std::vector<uint8_t> &buffer, StoreBlockEncoding &encoding);
+bool DecodeStoreBlock(StoreBlockEncoding encoding, std::span<const uint8_t> stored, size_t raw_size, std::vector<uint8_t> &raw);
+
+SaveOrLoadResult SaveToStore(const std::string &name, bool threaded);
+bool RestoreFromStore(const std::string &name, const std::string &filename);
+std::vector<std::string> GetStoredSavegames();
+SavegameStoreStats GetLastSavegameStoreStats();
+
+#endif /* SAVEGAME_STORE_H */
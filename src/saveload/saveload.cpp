@@ -50,6 +50,9 @@
 #include "../settings_internal.h"
 #include "saveload_internal.h"
 #include "saveload_filter.h"
+#include "savegame_store.h"
+#include "../allocation_tracker.h"
+#include "../scope_profiler.h"
 
 #include <atomic>
 #ifdef __EMSCRIPTEN__
@@ -180,6 +183,56 @@ struct MemoryDumper {
 	}
 };
 
+/** Accounting of the memory used while loading a savegame. */
+struct LoadMemoryStats {
+	ProcessMemoryUsage start{}; ///< Memory usage when loading started.
+	size_t peak_resident = 0; ///< Highest resident memory seen between chunks; only sampled at sl debug level 3 and higher.
+	uint32_t largest_chunk = 0; ///< Chunk that increased the resident memory the most.
+	size_t largest_chunk_growth = 0; ///< Increase of resident memory by #largest_chunk.
+
+	/** Start accounting for a new load; only when the memory usage is going to be reported. */
+	void Start()
+	{
+		*this = {};
+		if (_debug_sl_level < 1) return;
+		this->start = GetProcessMemoryUsage();
+		this->peak_resident = this->start.resident;
+	}
+
+	/**
+	 * Account for a chunk that has just been loaded.
+	 * Only called when the memory usage per chunk is reported, as reading it for every chunk is not free.
+	 * @param id The identifier of the chunk.
+	 * @param resident_before The resident memory before the chunk was loaded.
+	 * @param bytes The number of (decompressed) bytes the chunk took in the savegame.
+	 */
+	void ChunkLoaded(uint32_t id, size_t resident_before, size_t bytes)
+	{
+		size_t resident = GetProcessMemoryUsage().resident;
+		this->peak_resident = std::max(this->peak_resident, resident);
+		if (resident > resident_before && resident - resident_before > this->largest_chunk_growth) {
+			this->largest_chunk = id;
+			this->largest_chunk_growth = resident - resident_before;
+		}
+		Debug(sl, 3, "Chunk {:c}{:c}{:c}{:c}: {} bytes, resident memory {} KiB", id >> 24, id >> 16, id >> 8, id, bytes, resident / 1024);
+	}
+
+	/**
+	 * Report the memory usage of the load.
+	 * @param bytes The number of (decompressed) bytes of the savegame.
+	 */
+	void Report(size_t bytes) const
+	{
+		if (_debug_sl_level < 1) return;
+		ProcessMemoryUsage end = GetProcessMemoryUsage();
+		Debug(sl, 1, "Loaded {} bytes; resident memory {} KiB -> {} KiB, peak during load {} KiB (process peak {} KiB)",
+				bytes, this->start.resident / 1024, end.resident / 1024, std::max(this->peak_resident, end.resident) / 1024, end.peak_resident / 1024);
+		if (this->largest_chunk != 0) {
+			Debug(sl, 1, "Largest growth by chunk {:c}{:c}{:c}{:c}: {} KiB", this->largest_chunk >> 24, this->largest_chunk >> 16, this->largest_chunk >> 8, this->largest_chunk, this->largest_chunk_growth / 1024);
+		}
+	}
+};
+
 /** The saveload struct, containing reader-writer functions, buffer, version, etc. */
 struct SaveLoadParams {
 	SaveLoadAction action;               ///< are we doing a save or a load atm.
@@ -196,11 +249,16 @@ struct SaveLoadParams {
 
 	std::unique_ptr<ReadBuffer> reader; ///< Savegame reading buffer.
 	std::shared_ptr<LoadFilter> lf; ///< Filter to read the savegame from.
+	LoadMemoryStats load_memory; ///< Memory accounting of the current load.
+
+	std::optional<SlObjectPlan> chunk_plan; ///< Plan of the table of the current chunk, compiled when its table header was saved or loaded.
+	const SaveLoadHandler *handler; ///< Handler that is saving or loading its objects, if any.
 
 	StringID error_str;                  ///< the translatable error message to show
 	std::string extra_msg;               ///< the error message
 
 	bool saveinprogress;                 ///< Whether there is currently a save in progress.
+	bool uncompressed;                   ///< Whether the savegame being saved is written without compression.
 };
 
 static SaveLoadParams _sl; ///< Parameters used for/at saveload.
@@ -1603,6 +1661,77 @@ static inline bool SlIsObjectValidInSavegame(const SaveLoad &sld)
 	return (_sl_version >= sld.version_from && _sl_version < sld.version_to);
 }
 
+/**
+ * Does the savegame size of this field not depend on the object it is part of?
+ * @param sld The field to check.
+ * @return True iff the size is the same for every object.
+ */
+static bool SlHasFixedLength(const SaveLoad &sld)
+{
+	switch (sld.cmd) {
+		case SL_VAR:
+		case SL_ARR:
+		case SL_NULL:
+			return GetVarFileType(sld.conv) != SLE_FILE_STRING;
+
+		case SL_REF:
+		case SL_SAVEBYTE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Compile the plan of a SaveLoadTable for the current savegame version and action.
+ * @param slt The SaveLoad table to compile; it must outlive the plan.
+ * @return The plan.
+ */
+static SlObjectPlan SlCompileObjectPlan(const SaveLoadTable &slt)
+{
+	SlObjectPlan plan;
+	plan.table = slt;
+	plan.version = _sl_version;
+	plan.saving = _sl.action == SLA_SAVE;
+	for (auto &sld : slt) {
+		if (!SlIsObjectValidInSavegame(sld)) continue;
+
+		plan.fields.push_back(&sld);
+		if (!SlHasFixedLength(sld)) {
+			plan.variable_length_fields.push_back(&sld);
+		} else if (plan.saving) {
+			plan.fixed_length += SlCalcObjMemberLength(nullptr, sld);
+		}
+	}
+	return plan;
+}
+
+/**
+ * Find the plan of a SaveLoadTable. Only the tables of which the table header
+ * has been saved or loaded have a plan; that is the table of the current chunk
+ * and the table of the handler that is saving or loading its objects.
+ * @param slt The SaveLoad table to get the plan for.
+ * @return The plan, or \c nullptr if the table has none.
+ */
+static const SlObjectPlan *SlFindObjectPlan(const SaveLoadTable &slt)
+{
+	bool saving = _sl.action == SLA_SAVE;
+	if (_sl.handler != nullptr && _sl.handler->plan.has_value() && _sl.handler->plan->IsFor(slt, _sl_version, saving)) return &*_sl.handler->plan;
+	if (_sl.chunk_plan.has_value() && _sl.chunk_plan->IsFor(slt, _sl_version, saving)) return &*_sl.chunk_plan;
+	return nullptr;
+}
+
+/**
+ * Forget the plan of the table of the current chunk, at chunk boundaries.
+ * The plans of handlers stay with their handler, and are replaced when their table header is saved or loaded again.
+ */
+static void SlResetObjectPlans()
+{
+	_sl.chunk_plan.reset();
+	_sl.handler = nullptr;
+}
+
 /**
  * Calculate the size of the table header.
  * @param slt The SaveLoad table with objects to save/load.
@@ -1631,6 +1760,23 @@ static size_t SlCalcTableHeader(const SaveLoadTable &slt)
 	return length;
 }
 
+/**
+ * Calculate the size of an object.
+ * @param object to be measured.
+ * @param plan The compiled SaveLoad table with objects to save/load.
+ * @return size of given object.
+ */
+static size_t SlCalcObjLength(const void *object, const SlObjectPlan &plan)
+{
+	size_t length = plan.fixed_length;
+
+	/* Need to determine the length and write a length tag. */
+	for (const SaveLoad *sld : plan.variable_length_fields) {
+		length += SlCalcObjMemberLength(object, *sld);
+	}
+	return length;
+}
+
 /**
  * Calculate the size of an object.
  * @param object to be measured.
@@ -1639,9 +1785,10 @@ static size_t SlCalcTableHeader(const SaveLoadTable &slt)
  */
 size_t SlCalcObjLength(const void *object, const SaveLoadTable &slt)
 {
-	size_t length = 0;
+	const SlObjectPlan *plan = SlFindObjectPlan(slt);
+	if (plan != nullptr) return SlCalcObjLength(object, *plan);
 
-	/* Need to determine the length and write a length tag. */
+	size_t length = 0;
 	for (auto &sld : slt) {
 		length += SlCalcObjMemberLength(object, sld);
 	}
@@ -1677,7 +1824,10 @@ size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 			/* Pretend that we are saving to collect the object size. Other
 			 * means are difficult, as we don't know the length of the list we
 			 * are about to store. */
+			const SaveLoadHandler *old_handler = _sl.handler;
+			_sl.handler = sld.handler.get();
 			sld.handler->Save(const_cast<void *>(object));
+			_sl.handler = old_handler;
 			size_t length = _sl.obj_len;
 
 			_sl.obj_len = old_obj_len;
@@ -1695,10 +1845,13 @@ size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 	return 0;
 }
 
-static bool SlObjectMember(void *object, const SaveLoad &sld)
+/**
+ * Save or load a single field of an object, that is known to be valid in this savegame version.
+ * @param object The object that is being saved or loaded.
+ * @param sld The field to save or load.
+ */
+static void SlObjectValidMember(void *object, const SaveLoad &sld)
 {
-	if (!SlIsObjectValidInSavegame(sld)) return false;
-
 	VarType conv = GB(sld.conv, 0, 8);
 	switch (sld.cmd) {
 		case SL_VAR:
@@ -1757,7 +1910,11 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		}
 
 		case SL_STRUCT:
-		case SL_STRUCTLIST:
+		case SL_STRUCTLIST: {
+			/* Let SlObject find the plan of the table of the handler. */
+			const SaveLoadHandler *old_handler = _sl.handler;
+			_sl.handler = sld.handler.get();
+
 			switch (_sl.action) {
 				case SLA_SAVE: {
 					if (sld.cmd == SL_STRUCT) {
@@ -1791,11 +1948,13 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 				case SLA_NULL: break;
 				default: NOT_REACHED();
 			}
+
+			_sl.handler = old_handler;
 			break;
+		}
 
 		default: NOT_REACHED();
 	}
-	return true;
 }
 
 /**
@@ -1833,14 +1992,24 @@ size_t SlGetStructListLength(size_t limit)
  */
 void SlObject(void *object, const SaveLoadTable &slt)
 {
+	const SlObjectPlan *plan = SlFindObjectPlan(slt);
+
 	/* Automatically calculate the length? */
 	if (_sl.need_length != NL_NONE) {
-		SlSetLength(SlCalcObjLength(object, slt));
+		SlSetLength(plan != nullptr ? SlCalcObjLength(object, *plan) : SlCalcObjLength(object, slt));
 		if (_sl.need_length == NL_CALCLENGTH) return;
 	}
 
+	if (plan != nullptr) {
+		for (const SaveLoad *sld : plan->fields) {
+			SlObjectValidMember(object, *sld);
+		}
+		return;
+	}
+
+	/* Tables without a table header, e.g. the ones used for fixing pointers, have no plan. */
 	for (auto &sld : slt) {
-		SlObjectMember(object, sld);
+		if (SlIsObjectValidInSavegame(sld)) SlObjectValidMember(object, sld);
 	}
 }
 
@@ -1879,12 +2048,12 @@ class SlSkipHandler : public SaveLoadHandler {
 };
 
 /**
- * Save or Load a table header.
+ * Save or Load a table header, and compile the plans of the handlers in it.
  * @note a table-header can never contain more than 65535 fields.
  * @param slt The SaveLoad table with objects to save/load.
  * @return When loading, the ordered SaveLoad array to use; otherwise an empty list.
  */
-std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
+static std::vector<SaveLoad> SlSaveLoadTableHeader(const SaveLoadTable &slt)
 {
 	/* You can only use SlTableHeader if you are a CH_TABLE. */
 	assert(_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
@@ -1956,7 +2125,8 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 
 			for (auto &sld : saveloads) {
 				if (sld.cmd == SL_STRUCTLIST || sld.cmd == SL_STRUCT) {
-					sld.handler->load_description = SlTableHeader(sld.handler->GetDescription());
+					sld.handler->load_description = SlSaveLoadTableHeader(sld.handler->GetDescription());
+					sld.handler->plan = SlCompileObjectPlan(*sld.handler->load_description);
 				}
 			}
 
@@ -1994,7 +2164,8 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 					NeedLength old_need_length = _sl.need_length;
 					_sl.need_length = NL_NONE;
 
-					SlTableHeader(sld.handler->GetDescription());
+					SlSaveLoadTableHeader(sld.handler->GetDescription());
+					sld.handler->plan = SlCompileObjectPlan(sld.handler->GetDescription());
 
 					_sl.need_length = old_need_length;
 				}
@@ -2010,23 +2181,28 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 }
 
 /**
- * Load a table header in a savegame compatible way. If the savegame was made
- * before table headers were added, it will fall back to the
- * SaveLoadCompatTable for the order of fields while loading.
- *
- * @note You only have to call this function if the chunk existed as a
- * non-table type before converting it to a table. New chunks created as
- * table can call SlTableHeader() directly.
- *
+ * Save or Load a table header.
+ * @note a table-header can never contain more than 65535 fields.
  * @param slt The SaveLoad table with objects to save/load.
- * @param slct The SaveLoadCompat table the original order of the fields.
  * @return When loading, the ordered SaveLoad array to use; otherwise an empty list.
  */
-std::vector<SaveLoad> SlCompatTableHeader(const SaveLoadTable &slt, const SaveLoadCompatTable &slct)
+std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
+{
+	std::vector<SaveLoad> saveloads = SlSaveLoadTableHeader(slt);
+	_sl.chunk_plan = SlCompileObjectPlan(_sl.action == SLA_SAVE ? slt : SaveLoadTable(saveloads));
+	return saveloads;
+}
+
+/**
+ * Load a table header in a savegame compatible way, and compile the plans of the handlers in it.
+ * @param slt The SaveLoad table with objects to save/load.
+ * @param slct The SaveLoadCompat table the original order of the fields.
+ * @return The ordered SaveLoad array to use.
+ */
+static std::vector<SaveLoad> SlLoadCompatTableHeader(const SaveLoadTable &slt, const SaveLoadCompatTable &slct)
 {
-	assert(_sl.action == SLA_LOAD || _sl.action == SLA_LOAD_CHECK);
 	/* CH_TABLE / CH_SPARSE_TABLE always have a header. */
-	if (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
+	if (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) return SlSaveLoadTableHeader(slt);
 
 	std::vector<SaveLoad> saveloads;
 
@@ -2065,13 +2241,36 @@ std::vector<SaveLoad> SlCompatTableHeader(const SaveLoadTable &slt, const SaveLo
 	for (auto &sld : saveloads) {
 		if (!SlIsObjectValidInSavegame(sld)) continue;
 		if (sld.cmd == SL_STRUCTLIST || sld.cmd == SL_STRUCT) {
-			sld.handler->load_description = SlCompatTableHeader(sld.handler->GetDescription(), sld.handler->GetCompatDescription());
+			sld.handler->load_description = SlLoadCompatTableHeader(sld.handler->GetDescription(), sld.handler->GetCompatDescription());
+			sld.handler->plan = SlCompileObjectPlan(*sld.handler->load_description);
 		}
 	}
 
 	return saveloads;
 }
 
+/**
+ * Load a table header in a savegame compatible way. If the savegame was made
+ * before table headers were added, it will fall back to the
+ * SaveLoadCompatTable for the order of fields while loading.
+ *
+ * @note You only have to call this function if the chunk existed as a
+ * non-table type before converting it to a table. New chunks created as
+ * table can call SlTableHeader() directly.
+ *
+ * @param slt The SaveLoad table with objects to save/load.
+ * @param slct The SaveLoadCompat table the original order of the fields.
+ * @return When loading, the ordered SaveLoad array to use; otherwise an empty list.
+ */
+std::vector<SaveLoad> SlCompatTableHeader(const SaveLoadTable &slt, const SaveLoadCompatTable &slct)
+{
+	assert(_sl.action == SLA_LOAD || _sl.action == SLA_LOAD_CHECK);
+
+	std::vector<SaveLoad> saveloads = SlLoadCompatTableHeader(slt, slct);
+	_sl.chunk_plan = SlCompileObjectPlan(saveloads);
+	return saveloads;
+}
+
 /**
  * Save or Load (a list of) global variables.
  * @param slt The SaveLoad table with objects to save/load.
@@ -2137,6 +2336,8 @@ static void SlLoadChunk(const ChunkHandler &ch)
 {
 	uint8_t m = SlReadByte();
 
+	SlResetObjectPlans();
+
 	_sl.block_mode = m & CH_TYPE_MASK;
 	_sl.obj_len = 0;
 	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
@@ -2190,6 +2391,8 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 {
 	uint8_t m = SlReadByte();
 
+	SlResetObjectPlans();
+
 	_sl.block_mode = m & CH_TYPE_MASK;
 	_sl.obj_len = 0;
 	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
@@ -2244,6 +2447,8 @@ static void SlSaveChunk(const ChunkHandler &ch)
 	SlWriteUint32(ch.id);
 	Debug(sl, 2, "Saving chunk {}", ch.GetName());
 
+	SlResetObjectPlans();
+
 	_sl.block_mode = ch.type;
 	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
 
@@ -2306,7 +2511,16 @@ static void SlLoadChunks()
 
 		ch = SlFindChunkHandler(id);
 		if (ch == nullptr) SlErrorCorrupt("Unknown chunk type");
+
+		if (_debug_sl_level < 3) {
+			SlLoadChunk(*ch);
+			continue;
+		}
+
+		size_t start_pos = _sl.reader->GetSize();
+		size_t resident_before = GetProcessMemoryUsage().resident;
 		SlLoadChunk(*ch);
+		_sl.load_memory.ChunkLoaded(id, resident_before, _sl.reader->GetSize() - start_pos);
 	}
 }
 
@@ -2332,8 +2546,10 @@ static void SlFixPointers()
 
 	for (const ChunkHandler &ch : ChunkHandlers()) {
 		Debug(sl, 3, "Fixing pointers for {}", ch.GetName());
+		SlResetObjectPlans();
 		ch.FixPointers();
 	}
+	SlResetObjectPlans();
 
 	assert(_sl.action == SLA_PTRS);
 }
@@ -2905,13 +3121,19 @@ extern void ClearOldOrders();
 /**
  * Clear temporary data that is passed between various saveload phases.
  */
-static void ResetSaveloadData()
+static void ResetSaveloadCompatData()
 {
 	ClearOldOrders();
 	ResetTempEngineData();
+	ResetOldWaypoints();
+}
+
+/** Reset all data that has been set during a previous load. */
+static void ResetSaveloadData()
+{
+	ResetSaveloadCompatData();
 	ClearRailTypeLabelList();
 	ClearRoadTypeLabelList();
-	ResetOldWaypoints();
 	ResetSettings();
 }
 
@@ -2979,8 +3201,11 @@ static void SaveFileError()
  */
 static SaveOrLoadResult SaveFileToDisk(bool threaded)
 {
+	ProfileScope profile("SaveFileToDisk");
+	AllocationScope allocations(AllocationTag::SaveLoad);
+
 	try {
-		auto [fmt, compression] = GetSavegameFormat(_savegame_format);
+		auto [fmt, compression] = GetSavegameFormat(_sl.uncompressed ? "none" : _savegame_format);
 
 		/* We have written our stuff to memory, now write it to file! */
 		uint32_t hdr[2] = { fmt.tag, TO_BE32(SAVEGAME_VERSION << 16) };
@@ -3032,14 +3257,18 @@ void WaitTillSaved()
  * using the writer, either in threaded mode if possible, or single-threaded.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param uncompressed Whether to write the savegame without compression, regardless of the configured format.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded)
+static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded, bool uncompressed = false)
 {
 	assert(!_sl.saveinprogress);
 
+	ProfileScope profile("DoSave");
+	AllocationScope allocations(AllocationTag::SaveLoad);
 	_sl.dumper = std::make_unique<MemoryDumper>();
 	_sl.sf = std::move(writer);
+	_sl.uncompressed = uncompressed;
 
 	_sl_version = SAVEGAME_VERSION;
 
@@ -3064,13 +3293,14 @@ static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded
  * Save the game using a (writer) filter.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param uncompressed Whether to write the savegame without compression, regardless of the configured format.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-SaveOrLoadResult SaveWithFilter(std::shared_ptr<SaveFilter> writer, bool threaded)
+SaveOrLoadResult SaveWithFilter(std::shared_ptr<SaveFilter> writer, bool threaded, bool uncompressed)
 {
 	try {
 		_sl.action = SLA_SAVE;
-		return DoSave(std::move(writer), threaded);
+		return DoSave(std::move(writer), threaded, uncompressed);
 	} catch (...) {
 		ClearSaveLoadState();
 		return SL_ERROR;
@@ -3128,6 +3358,8 @@ static const SaveLoadFormat *DetermineSaveLoadFormat(uint32_t tag, uint32_t raw_
  */
 static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_check)
 {
+	ProfileScope profile("DoLoad");
+	AllocationScope allocations(AllocationTag::SaveLoad);
 	_sl.lf = std::move(reader);
 
 	if (load_check) {
@@ -3154,6 +3386,7 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 
 	if (!load_check) {
 		ResetSaveloadData();
+		_sl.load_memory.Start();
 
 		/* Old maps were hardcoded to 256x256 and thus did not contain
 		 * any mapsize information. Pre-initialize to 256x256 to not to
@@ -3198,6 +3431,7 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 		SlFixPointers();
 	}
 
+	size_t loaded_bytes = _sl.reader->GetSize();
 	ClearSaveLoadState();
 
 	_savegame_type = SGT_OTTD;
@@ -3210,12 +3444,15 @@ static SaveOrLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_che
 
 		/* After loading fix up savegame for any internal changes that
 		 * might have occurred since then. If it fails, load back the old game. */
-		if (!AfterLoadGame()) {
-			_gamelog.StopAction();
-			return SL_REINIT;
-		}
+		bool ok = AfterLoadGame();
+
+		/* The compatibility data of older savegames is not needed anymore; do not keep it until the next load. */
+		ResetSaveloadCompatData();
 
 		_gamelog.StopAction();
+		if (!ok) return SL_REINIT;
+
+		_sl.load_memory.Report(loaded_bytes);
 	}
 
 	return SL_OK;
@@ -3347,8 +3584,18 @@ void DoAutoOrNetsave(FiosNumberedSaveName &counter)
 		filename = counter.Filename();
 	}
 
-	Debug(sl, 2, "Autosaving to '{}'", filename);
-	if (SaveOrLoad(filename, SLO_SAVE, DFT_GAME_FILE, AUTOSAVE_DIR) != SL_OK) {
+	SaveOrLoadResult result;
+	if (_settings_client.gui.autosave_to_store) {
+		/* The store keeps its own format; strip the extension to get the name. */
+		std::string_view name = filename;
+		if (name.ends_with(".sav")) name.remove_suffix(4);
+		Debug(sl, 2, "Autosaving to '{}' in the savegame store", name);
+		result = SaveToStore(std::string{name}, true);
+	} else {
+		Debug(sl, 2, "Autosaving to '{}'", filename);
+		result = SaveOrLoad(filename, SLO_SAVE, DFT_GAME_FILE, AUTOSAVE_DIR);
+	}
+	if (result != SL_OK) {
 		ShowErrorMessage(GetEncodedString(STR_ERROR_AUTOSAVE_FAILED), {}, WL_ERROR);
 	}
 }
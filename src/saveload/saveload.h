@@ -450,7 +450,7 @@ void DoExitSave();
 
 void DoAutoOrNetsave(FiosNumberedSaveName &counter);
 
-SaveOrLoadResult SaveWithFilter(std::shared_ptr<struct SaveFilter> writer, bool threaded);
+SaveOrLoadResult SaveWithFilter(std::shared_ptr<struct SaveFilter> writer, bool threaded, bool uncompressed = false);
 SaveOrLoadResult LoadWithFilter(std::shared_ptr<struct LoadFilter> reader);
 
 typedef void AutolengthProc(int);
@@ -525,10 +525,40 @@ using SaveLoadTable = std::span<const struct SaveLoad>;
 /** A table of SaveLoadCompat entries. */
 using SaveLoadCompatTable = std::span<const struct SaveLoadCompat>;
 
+/**
+ * A SaveLoadTable compiled for the savegame version and action it is used with.
+ * Fields that are not in the savegame are stripped, and the savegame size of
+ * the fields that do not depend on the object is summed up front, so the
+ * per object work does not need to reinterpret the whole table.
+ * A plan is made when the table header of its table is saved or loaded, and
+ * stored next to that table.
+ */
+struct SlObjectPlan {
+	SaveLoadTable table; ///< The table this plan is compiled from.
+	SaveLoadVersion version = SL_MIN_VERSION; ///< Savegame version this plan is compiled for.
+	bool saving = false; ///< Whether this plan is compiled for saving.
+	std::vector<const SaveLoad *> fields; ///< Fields valid in #version, in table order.
+	std::vector<const SaveLoad *> variable_length_fields; ///< Subset of #fields whose savegame size depends on the object.
+	size_t fixed_length = 0; ///< Savegame size of all fields not in #variable_length_fields; only calculated when #saving.
+
+	/**
+	 * Test whether this plan can be used for a table.
+	 * @param slt The table.
+	 * @param version The savegame version the table is used with.
+	 * @param saving Whether the table is used for saving.
+	 * @return True iff this plan is compiled from \a slt, for this version and action.
+	 */
+	bool IsFor(const SaveLoadTable &slt, SaveLoadVersion version, bool saving) const
+	{
+		return slt.data() == this->table.data() && slt.size() == this->table.size() && version == this->version && saving == this->saving;
+	}
+};
+
 /** Handler for saving/loading an object to/from disk. */
 class SaveLoadHandler {
 public:
 	std::optional<std::vector<SaveLoad>> load_description;
+	std::optional<SlObjectPlan> plan; ///< Plan of the table of this handler, compiled when its table header was last saved or loaded.
 
 	virtual ~SaveLoadHandler() = default;
 
@@ -0,0 +1,229 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file scope_profiler.cpp Hierarchical profiling of nested scopes, exportable as Chrome trace. */
+
+#include "stdafx.h"
+#include "scope_profiler.h"
+#include "core/format.hpp"
+#include "fileio_func.h"
+
+#include <chrono>
+#include <mutex>
+#include "3rdparty/nlohmann/json.hpp"
+
+#include "safeguards.h"
+
+/* static */ std::atomic<bool> ScopeProfiler::running = false;
+
+namespace {
+	/** Ring buffer with the events of a single thread. */
+	struct ThreadEvents {
+		std::mutex lock; ///< Lock for #events and #count; only contended while reading the events.
+		std::vector<ProfileEvent> events; ///< Ring buffer of events.
+		uint64_t count = 0; ///< Number of events ever recorded; the newest event is at (count - 1) % EVENTS_PER_THREAD.
+		std::string name; ///< Name of the thread.
+		uint16_t number = 0; ///< Number of the thread in the trace.
+		uint16_t depth = 0; ///< Current nesting depth.
+		bool in_use = false; ///< Whether a thread is using this buffer.
+	};
+
+	std::mutex _threads_lock; ///< Lock for #_threads.
+	std::vector<std::unique_ptr<ThreadEvents>> _threads; ///< Event buffers of all threads; buffers of stopped threads get reused.
+	std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now(); ///< Reference for all timestamps.
+
+	/** Claim of a #ThreadEvents buffer by the current thread, released when the thread stops. */
+	struct ThreadEventsClaim {
+		ThreadEvents *events = nullptr; ///< The claimed buffer.
+		std::string name; ///< Name to give to the buffer once claimed.
+
+		~ThreadEventsClaim()
+		{
+			if (this->events == nullptr) return;
+			std::lock_guard<std::mutex> lock(_threads_lock);
+			this->events->in_use = false;
+		}
+
+		/**
+		 * Get the event buffer of this thread, claiming one when needed.
+		 * @return The buffer.
+		 */
+		ThreadEvents &Get()
+		{
+			if (this->events != nullptr) return *this->events;
+
+			std::lock_guard<std::mutex> lock(_threads_lock);
+			auto it = std::ranges::find(_threads, false, [](const auto &t) { return t->in_use; });
+			if (it == std::end(_threads)) {
+				auto &t = _threads.emplace_back(std::make_unique<ThreadEvents>());
+				t->number = static_cast<uint16_t>(_threads.size());
+				t->events.resize(ScopeProfiler::EVENTS_PER_THREAD);
+				it = std::prev(std::end(_threads));
+			}
+			this->events = it->get();
+			this->events->in_use = true;
+			this->events->depth = 0;
+			this->events->name = this->name.empty() ? fmt::format("thread {}", this->events->number) : this->name;
+			return *this->events;
+		}
+	};
+
+	thread_local ThreadEventsClaim _thread_events; ///< Event buffer of the current thread.
+}
+
+/**
+ * Start measuring scopes.
+ */
+/* static */ void ScopeProfiler::Start()
+{
+	ScopeProfiler::running.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * Stop measuring scopes. The events that were already collected are kept.
+ */
+/* static */ void ScopeProfiler::Stop()
+{
+	ScopeProfiler::running.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * Forget all collected events.
+ */
+/* static */ void ScopeProfiler::Clear()
+{
+	std::lock_guard<std::mutex> lock(_threads_lock);
+	for (auto &t : _threads) {
+		std::lock_guard<std::mutex> events_lock(t->lock);
+		t->count = 0;
+	}
+}
+
+/**
+ * Get the current time of the profiler clock.
+ * @return Nanoseconds since the start of the game; never 0.
+ */
+/* static */ uint64_t ScopeProfiler::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count() + 1;
+}
+
+/**
+ * Set the name of the current thread, as shown in the trace.
+ * @param name The name of the thread.
+ */
+/* static */ void ScopeProfiler::SetThreadName(std::string_view name)
+{
+	_thread_events.name = name;
+	if (_thread_events.events != nullptr) {
+		std::lock_guard<std::mutex> lock(_threads_lock);
+		_thread_events.events->name = name;
+	}
+}
+
+/**
+ * Record the start of a scope on the current thread.
+ */
+/* static */ void ScopeProfiler::Enter()
+{
+	_thread_events.Get().depth++;
+}
+
+/**
+ * Record the end of a scope on the current thread.
+ * @param name Name of the scope.
+ * @param object Index of the object the scope was about.
+ * @param start Start of the scope.
+ */
+/* static */ void ScopeProfiler::Leave(std::string_view name, uint32_t object, uint64_t start)
+{
+	uint64_t end = ScopeProfiler::Now();
+	ThreadEvents &t = _thread_events.Get();
+	if (t.depth > 0) t.depth--;
+
+	std::lock_guard<std::mutex> lock(t.lock);
+	t.events[t.count % EVENTS_PER_THREAD] = {name, start, end - start, object, t.depth, t.number};
+	t.count++;
+}
+
+/**
+ * Get the collected events of all threads.
+ * @param since Only return events that ended at or after this time of #Now.
+ * @return The events, per thread ordered by the time they ended.
+ */
+/* static */ std::vector<ProfileEvent> ScopeProfiler::GetEvents(uint64_t since)
+{
+	std::vector<ProfileEvent> result;
+
+	std::lock_guard<std::mutex> lock(_threads_lock);
+	for (auto &t : _threads) {
+		std::lock_guard<std::mutex> events_lock(t->lock);
+		uint64_t first = t->count > EVENTS_PER_THREAD ? t->count - EVENTS_PER_THREAD : 0;
+		for (uint64_t i = first; i < t->count; i++) {
+			const ProfileEvent &e = t->events[i % EVENTS_PER_THREAD];
+			if (e.start + e.duration >= since) result.push_back(e);
+		}
+	}
+	return result;
+}
+
+/**
+ * Arrange events into trees of nested scopes.
+ * Events whose enclosing scope is not in the list, e.g. because it was filtered out, become roots.
+ * @param events The events, as returned by #GetEvents.
+ * @return The outer scopes, per thread in the order they started.
+ */
+/* static */ std::vector<ProfileNode> ScopeProfiler::BuildTree(std::vector<ProfileEvent> events)
+{
+	/* A scope starts before the scopes within it, and has a lower depth when they start at the same time. */
+	std::ranges::sort(events, [](const ProfileEvent &a, const ProfileEvent &b) {
+		return std::tie(a.thread, a.start, a.depth) < std::tie(b.thread, b.start, b.depth);
+	});
+
+	std::vector<ProfileNode> roots;
+	std::vector<ProfileNode *> stack; ///< The scopes the next event may be nested in, innermost last.
+	for (const ProfileEvent &e : events) {
+		if (!stack.empty() && stack.back()->event.thread != e.thread) stack.clear();
+		while (!stack.empty() && (stack.back()->event.depth >= e.depth || stack.back()->event.start + stack.back()->event.duration < e.start)) stack.pop_back();
+
+		/* Only the innermost vector grows; the nodes on the stack are not in it, so the pointers stay valid. */
+		std::vector<ProfileNode> &siblings = stack.empty() ? roots : stack.back()->children;
+		stack.push_back(&siblings.emplace_back(e));
+	}
+	return roots;
+}
+
+/**
+ * Write all collected events as Chrome trace JSON, which can be opened in chrome://tracing and Perfetto.
+ * @param filename The file to write to, in the autosave directory.
+ * @return True iff the file was written.
+ */
+/* static */ bool ScopeProfiler::WriteChromeTrace(const std::string &filename)
+{
+	std::vector<ProfileEvent> events = ScopeProfiler::GetEvents();
+
+	auto f = FioFOpenFile(filename, "wt", AUTOSAVE_DIR);
+	if (!f.has_value()) return false;
+
+	fmt::print(*f, "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	{
+		std::lock_guard<std::mutex> lock(_threads_lock);
+		for (const auto &t : _threads) {
+			fmt::print(*f, "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":{}}}}},\n", t->number, nlohmann::json(t->name).dump());
+		}
+	}
+	for (const ProfileEvent &e : events) {
+		/* Timestamps are in microseconds; keep the nanoseconds as fraction. */
+		fmt::print(*f, "{{\"name\":{},\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{}.{:03},\"dur\":{}.{:03}",
+				nlohmann::json(e.name).dump(), e.thread, e.start / 1000, e.start % 1000, e.duration / 1000, e.duration % 1000);
+		if (e.object != ProfileEvent::NO_OBJECT) fmt::print(*f, ",\"args\":{{\"object\":{}}}", e.object);
+		fmt::print(*f, "}},\n");
+	}
+	/* Closing metadata event, so the list has no trailing comma. */
+	fmt::print(*f, "{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{{\"name\":\"OpenTTD\"}}}}\n]}}\n");
+	return true;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file scope_profiler.h Hierarchical profiling of nested scopes, exportable as Chrome trace.
+ *
+ * @par Adding new scopes
+ * Instantiate a #ProfileScope at the beginning of the block to be measured, with a string literal as name and
+ * optionally the index of the object that is being processed. Scopes nest, so a scope inside another
+ * scope shows up as its child in the trace viewer. When the profiler is not running, a scope costs a
+ * single relaxed atomic load.
+ *
+ * @see scope_profiler.cpp for implementation
+ */
+
+#ifndef SCOPE_PROFILER_H
+#define SCOPE_PROFILER_H
+
+#include <atomic>
+
+/** A single measured scope. */
+struct ProfileEvent {
+	static constexpr uint32_t NO_OBJECT = UINT32_MAX; ///< Object of events that are not about a specific object.
+
+	std::string_view name; ///< Name of the scope; must be a string literal.
+	uint64_t start; ///< Start of the scope, in nanoseconds since the profiler was started.
+	uint64_t duration; ///< Duration of the scope, in nanoseconds.
+	uint32_t object; ///< Index of the object the scope was about, or #NO_OBJECT.
+	uint16_t depth; ///< Nesting depth of the scope, 0 for outer scopes.
+	uint16_t thread; ///< Profiler thread number the scope ran on.
+};
+
+/** A measured scope, with the scopes that were measured within it. */
+struct ProfileNode {
+	ProfileEvent event; ///< The scope.
+	std::vector<ProfileNode> children; ///< Scopes within the scope, in the order they started.
+};
+
+/** Hierarchical profiler of #ProfileScope measurements, with a ring buffer of events per thread. */
+class ScopeProfiler {
+public:
+	static constexpr size_t EVENTS_PER_THREAD = 1 << 16; ///< Number of events kept per thread.
+
+	/**
+	 * Test whether scopes are being measured.
+	 * @return True iff the profiler is running.
+	 */
+	static inline bool IsRunning()
+	{
+		return ScopeProfiler::running.load(std::memory_order_relaxed);
+	}
+
+	static void Start();
+	static void Stop();
+	static void Clear();
+	static uint64_t Now();
+	static void SetThreadName(std::string_view name);
+	static std::vector<ProfileEvent> GetEvents(uint64_t since = 0);
+	static std::vector<ProfileNode> BuildTree(std::vector<ProfileEvent> events);
+	static bool WriteChromeTrace(const std::string &filename);
+
+private:
+	friend class ProfileScope;
+
+	static std::atomic<bool> running; ///< Whether scopes are being measured.
+
+	static void Enter();
+	static void Leave(std::string_view name, uint32_t object, uint64_t start);
+};
+
+/**
+ * RAII class for measuring a scope in the #ScopeProfiler.
+ * Construct an object at the beginning of the scope; the measurement is recorded when it goes out of scope.
+ */
+class ProfileScope {
+	std::string_view name; ///< Name of the scope.
+	uint32_t object; ///< Index of the object the scope is about.
+	uint64_t start; ///< Start of the scope, or 0 when the profiler was not running.
+public:
+	/**
+	 * Start measuring a scope.
+	 * @param name Name of the scope; must be a string literal.
+	 * @param object Index of the object the scope is about, if any.
+	 */
+	inline ProfileScope(std::string_view name, uint32_t object = ProfileEvent::NO_OBJECT) : name(name), object(object), start(0)
+	{
+		if (ScopeProfiler::IsRunning()) {
+			ScopeProfiler::Enter();
+			this->start = ScopeProfiler::Now();
+		}
+	}
+
+	inline ~ProfileScope()
+	{
+		if (this->start != 0) ScopeProfiler::Leave(this->name, this->object, this->start);
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#endif /* SCOPE_PROFILER_H */
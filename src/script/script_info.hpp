@@ -28,6 +28,7 @@ static const int MAX_GET_SETTING_OPS    = 100000;
 
 /** All static information from an Script like name, version, etc. */
 class ScriptInfo : public SimpleCountedObject {
+	friend class ScriptScanner;
 public:
 	/**
 	 * Get the Author of the script.
@@ -129,6 +130,11 @@ public:
 	 */
 	virtual bool IsDeveloperOnly() const { return false; }
 
+	/**
+	 * Create a copy of this ScriptInfo, used to cache the results of scanning.
+	 */
+	virtual std::unique_ptr<ScriptInfo> Clone() const = 0;
+
 protected:
 	class Squirrel *engine = nullptr; ///< Engine used to register for Squirrel.
 	HSQOBJECT SQ_instance{}; ///< The Squirrel instance created for this info.
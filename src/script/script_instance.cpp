@@ -836,6 +836,12 @@ size_t ScriptInstance::GetAllocatedMemory() const
 	return this->engine->GetAllocatedMemory();
 }
 
+uint64_t ScriptInstance::GetExecutedOps() const
+{
+	if (this->engine == nullptr) return 0;
+	return this->engine->GetExecutedOps();
+}
+
 void ScriptInstance::ReleaseSQObject(HSQOBJECT *obj)
 {
 	if (!this->in_shutdown) this->engine->ReleaseObject(obj);
@@ -240,6 +240,12 @@ public:
 
 	size_t GetAllocatedMemory() const;
 
+	/**
+	 * Get the number of operations the script executed in its main loop.
+	 * @return The number of operations, or 0 when the script is not running.
+	 */
+	uint64_t GetExecutedOps() const;
+
 	/**
 	 * Indicate whether this instance is currently being destroyed.
 	 */
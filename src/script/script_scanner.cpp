@@ -20,27 +20,27 @@
 #include "../network/network_content.h"
 #include "../3rdparty/md5/md5.h"
 #include "../tar_type.h"
+#include "../thread.h"
 
 #include "../safeguards.h"
 
+/* static */ thread_local ScriptScanner::ScanJob *ScriptScanner::current_scan_job = nullptr;
+
 bool ScriptScanner::AddFile(const std::string &filename, size_t, const std::string &tar_filename)
 {
-	this->main_script = filename;
-	this->tar_file = tar_filename;
+	std::string main_script = filename;
 
-	auto p = this->main_script.find_last_of(PATHSEPCHAR);
-	this->main_script.erase(p != std::string::npos ? p + 1 : 0);
-	this->main_script += "main.nut";
+	auto p = main_script.find_last_of(PATHSEPCHAR);
+	main_script.erase(p != std::string::npos ? p + 1 : 0);
+	main_script += "main.nut";
 
-	if (!FioCheckFileExists(filename, this->subdir) || !FioCheckFileExists(this->main_script, this->subdir)) return false;
+	if (!FioCheckFileExists(filename, this->subdir) || !FioCheckFileExists(main_script, this->subdir)) return false;
 
-	this->ResetEngine();
-	try {
-		this->engine->LoadScript(filename);
-	} catch (Script_FatalError &e) {
-		Debug(script, 0, "Fatal error '{}' when trying to load the script '{}'.", e.GetErrorMessage(), filename);
-		return false;
-	}
+	/* The actual loading is deferred, so it can be spread over multiple engines. */
+	ScanJob &job = this->scan_jobs.emplace_back();
+	job.filename = filename;
+	job.main_script = std::move(main_script);
+	job.tar_file = tar_filename;
 	return true;
 }
 
@@ -49,16 +49,41 @@ ScriptScanner::ScriptScanner() :
 {
 }
 
+Squirrel *ScriptScanner::GetEngine()
+{
+	return this->current_scan_job != nullptr ? this->current_scan_job->engine : this->engine;
+}
+
+std::string ScriptScanner::GetMainScript()
+{
+	return this->current_scan_job != nullptr ? this->current_scan_job->main_script : this->main_script;
+}
+
+std::string ScriptScanner::GetTarFile()
+{
+	return this->current_scan_job != nullptr ? this->current_scan_job->tar_file : this->tar_file;
+}
+
 void ScriptScanner::ResetEngine()
 {
-	this->engine->Reset();
-	this->engine->SetGlobalPointer(this);
-	this->RegisterAPI(*this->engine);
+	this->ResetEngine(*this->engine);
+}
+
+/**
+ * Reset the given engine and register the API of this scanner on it.
+ * @param engine The engine to reset.
+ */
+void ScriptScanner::ResetEngine(Squirrel &engine)
+{
+	engine.Reset();
+	engine.SetGlobalPointer(this);
+	this->RegisterAPI(engine);
 }
 
 void ScriptScanner::Initialize(std::string_view name)
 {
-	this->engine = new Squirrel(name);
+	this->engine_name = name;
+	this->engine = new Squirrel(this->engine_name);
 
 	this->RescanDir();
 
@@ -79,6 +104,7 @@ void ScriptScanner::RescanDir()
 
 	/* Scan for scripts */
 	this->Scan(this->GetFileName(), this->GetDirectory());
+	this->ProcessScanJobs();
 }
 
 void ScriptScanner::Reset()
@@ -89,9 +115,134 @@ void ScriptScanner::Reset()
 
 	this->info_list.clear();
 	this->info_single_list.clear();
+	this->scan_jobs.clear();
+}
+
+/**
+ * Hash the contents of a scanned file.
+ * @param filename The file to hash.
+ * @param dir The directory the file is in.
+ * @param[out] hash The resulting hash.
+ * @return True iff the file could be read.
+ */
+static bool HashScriptFile(const std::string &filename, Subdirectory dir, MD5Hash &hash)
+{
+	size_t size;
+	auto f = FioFOpenFile(filename, "rb", dir, &size);
+	if (!f.has_value()) return false;
+
+	Md5 checksum;
+	uint8_t buffer[1024];
+	size_t len;
+	while (size != 0 && (len = fread(buffer, 1, std::min(size, sizeof(buffer)), *f)) != 0) {
+		size -= len;
+		checksum.Append(buffer, len);
+	}
+	checksum.Finish(hash);
+	return true;
+}
+
+/**
+ * Process a single scanned file, either by reusing the scripts from the scan cache,
+ * or by running it in the given engine.
+ * This may be called from a scan worker; the scan cache is only read here.
+ * @param job The file to process.
+ * @param engine The engine to run the file in when it is not cached.
+ */
+void ScriptScanner::ProcessScanJob(ScanJob &job, Squirrel &engine)
+{
+	if (HashScriptFile(job.filename, this->subdir, job.hash)) {
+		auto it = this->scan_cache.find(job.filename);
+		if (it != this->scan_cache.end() && it->second.hash == job.hash) {
+			for (const auto &info : it->second.infos) job.found.emplace_back(info->Clone());
+			return;
+		}
+	}
+
+	this->ResetEngine(engine);
+	job.engine = &engine;
+	this->current_scan_job = &job;
+	try {
+		engine.LoadScript(job.filename);
+	} catch (Script_FatalError &e) {
+		Debug(script, 0, "Fatal error '{}' when trying to load the script '{}'.", e.GetErrorMessage(), job.filename);
+	}
+	this->current_scan_job = nullptr;
+	job.engine = nullptr;
+
+	/* The engine is reused for the next file, so do not let the scripts refer to it. */
+	for (auto &info : job.found) info->engine = nullptr;
+}
+
+/**
+ * Process all files found by the file scanner. Each file is run in its own
+ * clean engine, so files are spread over several threads when there are many
+ * of them. Files that did not change since the previous scan are not run
+ * again; the scripts they registered are copied from the scan cache instead.
+ * The results are registered in the order the files were found, so the
+ * outcome does not depend on the number of threads.
+ */
+void ScriptScanner::ProcessScanJobs()
+{
+	std::atomic<size_t> next_job = 0;
+	auto worker = [this, &next_job](Squirrel &engine) {
+		for (size_t i = next_job++; i < this->scan_jobs.size(); i = next_job++) {
+			this->ProcessScanJob(this->scan_jobs[i], engine);
+		}
+	};
+
+	/* There is hardly any gain in starting threads for a handful of files. */
+	static const size_t JOBS_PER_THREAD = 4;
+	size_t num_threads = std::min<size_t>(std::thread::hardware_concurrency(), this->scan_jobs.size() / JOBS_PER_THREAD);
+
+	std::vector<std::unique_ptr<Squirrel>> engines;
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < num_threads; i++) {
+		Squirrel *engine = engines.emplace_back(std::make_unique<Squirrel>(this->engine_name)).get();
+		if (!StartNewThread(&threads.emplace_back(), "ottd:scriptscan", [&worker, engine]() { worker(*engine); })) threads.pop_back();
+	}
+	/* The main thread helps out with its own engine. */
+	worker(*this->engine);
+	for (auto &thread : threads) thread.join();
+	engines.clear();
+
+	size_t cached = 0;
+	std::map<std::string, ScanCacheItem> scan_cache;
+	for (ScanJob &job : this->scan_jobs) {
+		auto it = this->scan_cache.find(job.filename);
+		if (it != this->scan_cache.end() && it->second.hash == job.hash) {
+			cached++;
+			scan_cache[job.filename] = std::move(it->second);
+		} else if (job.hash != MD5Hash{}) {
+			ScanCacheItem &item = scan_cache[job.filename];
+			item.hash = job.hash;
+			for (const auto &info : job.found) item.infos.emplace_back(info->Clone());
+		}
+
+		for (auto &info : job.found) this->RegisterScriptInternal(info.release());
+	}
+	Debug(script, 4, "Scanned {} {} files with {} threads, {} from cache", this->scan_jobs.size(), this->GetScannerName(), threads.size() + 1, cached);
+
+	this->scan_cache = std::move(scan_cache);
+	this->scan_jobs.clear();
 }
 
 void ScriptScanner::RegisterScript(ScriptInfo *info)
+{
+	/* While scanning, collect the scripts so they can be registered in a deterministic order. */
+	if (this->current_scan_job != nullptr) {
+		this->current_scan_job->found.emplace_back(info);
+		return;
+	}
+
+	this->RegisterScriptInternal(info);
+}
+
+/**
+ * Actually register a ScriptInfo to the scanner's lists.
+ * @param info The script to register; ownership is transferred to the scanner.
+ */
+void ScriptScanner::RegisterScriptInternal(ScriptInfo *info)
 {
 	std::string script_original_name = this->GetScriptName(*info);
 	std::string script_name = fmt::format("{}.{}", script_original_name, info->GetVersion());
@@ -12,6 +12,7 @@
 
 #include "../fileio_func.h"
 #include "../string_func.h"
+#include "../3rdparty/md5/md5.h"
 
 typedef std::map<std::string, class ScriptInfo *, CaseInsensitiveComparator> ScriptInfoList; ///< Type for the list of scripts.
 
@@ -24,19 +25,21 @@ public:
 	virtual void Initialize() = 0;
 
 	/**
-	 * Get the engine of the main squirrel handler (it indexes all available scripts).
+	 * Get the engine of the squirrel handler that is currently scanning.
+	 * During a (parallel) rescan this is the engine of the calling worker, otherwise
+	 * the engine of the main squirrel handler (it indexes all available scripts).
 	 */
-	class Squirrel *GetEngine() { return this->engine; }
+	class Squirrel *GetEngine();
 
 	/**
 	 * Get the current main script the ScanDir is currently tracking.
 	 */
-	std::string GetMainScript() { return this->main_script; }
+	std::string GetMainScript();
 
 	/**
 	 * Get the current tar file the ScanDir is currently tracking.
 	 */
-	std::string GetTarFile() { return this->tar_file; }
+	std::string GetTarFile();
 
 	/**
 	 * Get the list of all registered scripts.
@@ -84,13 +87,33 @@ public:
 	void RescanDir();
 
 protected:
+	/** An info.nut/library.nut that has been found by the file scanner, and is waiting to be processed. */
+	struct ScanJob {
+		std::string filename;    ///< The info.nut/library.nut that is scanned.
+		std::string main_script; ///< The full path of the script.
+		std::string tar_file;    ///< If, which tar file the script was in.
+		MD5Hash hash;            ///< Hash of the contents of the scanned file.
+		class Squirrel *engine = nullptr; ///< The engine processing this job.
+		std::vector<std::unique_ptr<class ScriptInfo>> found; ///< The scripts registered by this file.
+	};
+
+	/** Scripts registered by a scanned file, for a given content hash of that file. */
+	struct ScanCacheItem {
+		MD5Hash hash; ///< Hash of the contents of the scanned file.
+		std::vector<std::unique_ptr<class ScriptInfo>> infos; ///< Copies of the scripts the file registered.
+	};
+
 	class Squirrel *engine;  ///< The engine we're scanning with.
+	std::string engine_name; ///< Name of the engine, used for the engines of the scan workers.
 	std::string main_script; ///< The full path of the script.
 	std::string tar_file;    ///< If, which tar file the script was in.
 
 	ScriptInfoList info_list;        ///< The list of all script.
 	ScriptInfoList info_single_list; ///< The list of all unique script. The best script (highest version) is shown.
 
+	std::vector<ScanJob> scan_jobs; ///< Files found during the current scan, in order of discovery.
+	std::map<std::string, ScanCacheItem> scan_cache; ///< Results of earlier scans, indexed by filename.
+
 	/**
 	 * Initialize the scanner.
 	 * @param name The name of the scanner ("AIScanner", "GSScanner", ..).
@@ -131,6 +154,14 @@ protected:
 	 * Reset the engine to ensure a clean environment for further steps.
 	 */
 	void ResetEngine();
+
+private:
+	static thread_local ScanJob *current_scan_job; ///< The scan job the current thread is processing, if any.
+
+	void ResetEngine(class Squirrel &engine);
+	void ProcessScanJob(ScanJob &job, class Squirrel &engine);
+	void ProcessScanJobs();
+	void RegisterScriptInternal(class ScriptInfo *info);
 };
 
 #endif /* SCRIPT_SCANNER_HPP */
@@ -14,6 +14,7 @@
 #include "news_func.h"
 #include "company_func.h"
 #include "depot_base.h"
+#include "depot_kdtree.h"
 #include "station_base.h"
 #include "newgrf_engine.h"
 #include "pathfinder/yapf/yapf.h"
@@ -33,6 +34,7 @@
 #include "tunnelbridge_map.h"
 #include "zoom_func.h"
 #include "framerate_type.h"
+#include "scope_profiler.h"
 #include "industry.h"
 #include "industry_map.h"
 #include "ship_cmd.h"
@@ -184,21 +186,12 @@ static const Depot *FindClosestShipDepot(const Vehicle *v, uint max_distance)
 	}
 
 	/* Step 2: Find the closest depot within the reachable Water Region Patches. */
-	const Depot *best_depot = nullptr;
-	uint best_dist_sq = std::numeric_limits<uint>::max();
-	for (const Depot *depot : Depot::Iterate()) {
-		const TileIndex tile = depot->xy;
-		if (IsShipDepotTile(tile) && IsTileOwner(tile, v->owner)) {
-			const uint dist_sq = DistanceSquare(tile, v->tile);
-			if (dist_sq < best_dist_sq && dist_sq <= max_distance * max_distance &&
-					visited_patch_hashes.count(CalculateWaterRegionPatchHash(GetWaterRegionPatchInfo(tile))) > 0) {
-				best_dist_sq = dist_sq;
-				best_depot = depot;
-			}
-		}
-	}
+	std::optional<DepotID> best_depot = GetShipDepotKdtree(v->owner).FindNearestIf(TileX(v->tile), TileY(v->tile),
+			static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(max_distance) * max_distance, std::numeric_limits<int>::max())),
+			[](DepotID depot) { return visited_patch_hashes.count(CalculateWaterRegionPatchHash(GetWaterRegionPatchInfo(Depot::Get(depot)->xy))) > 0; },
+			[](int dx, int dy) { return dx * dx + dy * dy; });
 
-	return best_depot;
+	return best_depot.has_value() ? Depot::Get(*best_depot) : nullptr;
 }
 
 static void CheckIfShipNeedsService(Vehicle *v)
@@ -862,6 +855,7 @@ static void ShipController(Ship *v)
 bool Ship::Tick()
 {
 	PerformanceAccumulator framerate(PFE_GL_SHIPS);
+	ProfileScope profile("Ship", this->index.base());
 
 	if (!this->vehstatus.Test(VehState::Stopped)) this->running_ticks++;
 
@@ -17,6 +17,7 @@
 #include "blitter/factory.hpp"
 #include "core/math_func.hpp"
 #include "video/video_driver.hpp"
+#include "allocation_tracker.h"
 #include "spritecache.h"
 #include "spritecache_internal.h"
 
@@ -759,10 +760,28 @@ static void DeleteEntriesFromSpriteCache(size_t to_remove)
 			candidates.size(), candidate_bytes, initial_in_use, _spritecache_bytes_used, to_remove);
 }
 
-void IncreaseSpriteLRU()
+/**
+ * Get the size the sprite cache is kept under.
+ * @return Size in bytes.
+ */
+size_t GetSpriteCacheLimit()
 {
 	int bpp = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
-	uint target_size = (bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
+	return static_cast<size_t>(bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
+}
+
+/**
+ * Get the number of bytes used by the sprites in the sprite cache.
+ * @return Size in bytes.
+ */
+size_t GetSpriteCacheUsage()
+{
+	return _spritecache_bytes_used;
+}
+
+void IncreaseSpriteLRU()
+{
+	size_t target_size = GetSpriteCacheLimit();
 	if (_spritecache_bytes_used > target_size) {
 		DeleteEntriesFromSpriteCache(_spritecache_bytes_used - target_size + 512 * 1024);
 	}
@@ -874,6 +893,7 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator,
 
 		/* Load the sprite, if it is not loaded, yet */
 		if (sc->ptr == nullptr) {
+			AllocationScope allocations(AllocationTag::SpriteCache);
 			UniquePtrSpriteAllocator cache_allocator;
 			if (sc->type == SpriteType::Recolour) {
 				ReadRecolourSprite(*sc->file, sc->file_pos, sc->length, cache_allocator);
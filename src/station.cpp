@@ -46,6 +46,44 @@ void RebuildStationKdtree()
 		stids.push_back(st->index);
 	}
 	_station_kdtree.Build(stids.begin(), stids.end());
+
+	InvalidateHangarKdtrees();
+}
+
+static TypedIndexContainer<std::array<AirportKdtree, MAX_COMPANIES>, CompanyID> _hangar_kdtrees; ///< Airports with a hangar per company.
+static bool _hangar_kdtrees_valid = false; ///< Whether _hangar_kdtrees reflects the current airports.
+
+/**
+ * Mark the trees of airports with hangars as outdated, e.g. because an airport was
+ * built or removed or a station changed owner. They are rebuilt when needed.
+ */
+void InvalidateHangarKdtrees()
+{
+	_hangar_kdtrees_valid = false;
+}
+
+/**
+ * Get the tree of the airports with a hangar of a company.
+ * @param owner Company to get the airports for.
+ * @return Tree of the airports, positioned by their airport tile.
+ */
+const AirportKdtree &GetHangarKdtree(Owner owner)
+{
+	assert(owner < MAX_COMPANIES);
+
+	if (!_hangar_kdtrees_valid) {
+		TypedIndexContainer<std::array<std::vector<StationID>, MAX_COMPANIES>, CompanyID> hangars;
+		for (const Station *st : Station::Iterate()) {
+			if (st->owner >= MAX_COMPANIES || !st->facilities.Test(StationFacility::Airport) || !st->airport.HasHangar()) continue;
+			hangars[st->owner].push_back(st->index);
+		}
+		for (CompanyID c = CompanyID::Begin(); c < MAX_COMPANIES; ++c) {
+			_hangar_kdtrees[c].Build(hangars[c].begin(), hangars[c].end());
+		}
+		_hangar_kdtrees_valid = true;
+	}
+
+	return _hangar_kdtrees[owner];
 }
 
 
@@ -159,6 +197,7 @@ Station::~Station()
 	CargoPacket::InvalidateAllFrom(this->index);
 
 	_station_kdtree.Remove(this->index);
+	if (this->airport.tile != INVALID_TILE) InvalidateHangarKdtrees();
 	if (this->sign.kdtree_valid) _viewport_sign_kdtree.Remove(ViewportSignKdtreeItem::MakeStation(this->index));
 }
 
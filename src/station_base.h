@@ -32,7 +32,12 @@ static const uint8_t MAX_STATION_RATING = 255;
  */
 class FlowStat {
 public:
-	typedef std::map<uint32_t, StationID> SharesMap;
+	/**
+	 * Shares as pairs of cumulative flow and station, sorted by the
+	 * cumulative flow. A flat array keeps the lookups for routing cargo
+	 * within a single cache line for the usual handful of next hops.
+	 */
+	typedef std::vector<std::pair<uint32_t, StationID>> SharesMap;
 
 	static const SharesMap empty_sharesmap;
 
@@ -52,7 +57,7 @@ public:
 	inline FlowStat(StationID st, uint flow, bool restricted = false)
 	{
 		assert(flow > 0);
-		this->shares[flow] = st;
+		this->shares.emplace_back(flow, st);
 		this->unrestricted = restricted ? 0 : flow;
 	}
 
@@ -67,7 +72,7 @@ public:
 	inline void AppendShare(StationID st, uint flow, bool restricted = false)
 	{
 		assert(flow > 0);
-		this->shares[(--this->shares.end())->first + flow] = st;
+		this->shares.emplace_back(this->shares.back().first + flow, st);
 		if (!restricted) this->unrestricted += flow;
 	}
 
@@ -108,7 +113,7 @@ public:
 	/**
 	 * Get a station a package can be routed to. This done by drawing a
 	 * random number between 0 and sum_shares and then looking that up in
-	 * the map with lower_bound. So each share gets selected with a
+	 * the shares with upper_bound. So each share gets selected with a
 	 * probability dependent on its flow. Do include restricted flows here.
 	 * @param is_restricted Output if a restricted flow was chosen.
 	 * @return A station ID from the shares map.
@@ -116,15 +121,15 @@ public:
 	inline StationID GetViaWithRestricted(bool &is_restricted) const
 	{
 		assert(!this->shares.empty());
-		uint rand = RandomRange((--this->shares.end())->first);
+		uint rand = RandomRange(this->shares.back().first);
 		is_restricted = rand >= this->unrestricted;
-		return this->shares.upper_bound(rand)->second;
+		return this->UpperBound(rand)->second;
 	}
 
 	/**
 	 * Get a station a package can be routed to. This done by drawing a
 	 * random number between 0 and sum_shares and then looking that up in
-	 * the map with lower_bound. So each share gets selected with a
+	 * the shares with upper_bound. So each share gets selected with a
 	 * probability dependent on its flow. Don't include restricted flows.
 	 * @return A station ID from the shares map.
 	 */
@@ -132,7 +137,7 @@ public:
 	{
 		assert(!this->shares.empty());
 		return this->unrestricted > 0 ?
-				this->shares.upper_bound(RandomRange(this->unrestricted))->second :
+				this->UpperBound(RandomRange(this->unrestricted))->second :
 				StationID::Invalid();
 	}
 
@@ -141,6 +146,27 @@ public:
 	void Invalidate();
 
 private:
+	/**
+	 * Find the first share with a cumulative flow greater than the given
+	 * value. The search halves the range without branching on the
+	 * comparison, so it doesn't suffer from mispredictions on the random
+	 * values used for routing.
+	 * @param value Value to look up.
+	 * @return Iterator to the first share above value, or end() if there is none.
+	 */
+	inline SharesMap::const_iterator UpperBound(uint32_t value) const
+	{
+		if (this->shares.empty()) return this->shares.end();
+		SharesMap::const_iterator first = this->shares.begin();
+		size_t len = this->shares.size();
+		while (len > 1) {
+			size_t half = len / 2;
+			first += (first[half - 1].first <= value) ? half : 0;
+			len -= half;
+		}
+		return first + (first->first <= value ? 1 : 0);
+	}
+
 	SharesMap shares{}; ///< Shares of flow to be sent via specified station (or consumed locally).
 	uint unrestricted = 0; ///< Limit for unrestricted shares.
 };
@@ -613,6 +639,7 @@ public:
 };
 
 void RebuildStationKdtree();
+void InvalidateHangarKdtrees();
 
 /**
  * Call a function on all stations that have any part of the requested area within their catchment.
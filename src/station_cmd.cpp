@@ -2603,6 +2603,7 @@ CommandCost CmdBuildAirport(DoCommandFlags flags, TileIndex tile, uint8_t airpor
 		st->airport.layout = layout;
 		st->airport.blocks = {};
 		st->airport.rotation = rotation;
+		InvalidateHangarKdtrees();
 
 		st->rect.BeforeAddRect(tile, w, h, StationRect::ADD_TRY);
 
@@ -2702,6 +2703,7 @@ static CommandCost RemoveAirport(TileIndex tile, DoCommandFlags flags)
 
 		st->airport.Clear();
 		st->facilities.Reset(StationFacility::Airport);
+		InvalidateHangarKdtrees();
 		SetWindowClassesDirty(WC_VEHICLE_ORDERS);
 
 		InvalidateWindowData(WC_STATION_VIEW, st->index, -1);
@@ -4805,7 +4807,7 @@ StationID FlowStat::GetVia(StationID excluded, StationID excluded2) const
 {
 	if (this->unrestricted == 0) return StationID::Invalid();
 	assert(!this->shares.empty());
-	SharesMap::const_iterator it = this->shares.upper_bound(RandomRange(this->unrestricted));
+	SharesMap::const_iterator it = this->UpperBound(RandomRange(this->unrestricted));
 	assert(it != this->shares.end() && it->first <= this->unrestricted);
 	if (it->second != excluded && it->second != excluded2) return it->second;
 
@@ -4818,8 +4820,8 @@ StationID FlowStat::GetVia(StationID excluded, StationID excluded2) const
 	if (interval >= this->unrestricted) return StationID::Invalid(); // Only one station in the map.
 	uint new_max = this->unrestricted - interval;
 	uint rand = RandomRange(new_max);
-	SharesMap::const_iterator it2 = (rand < begin) ? this->shares.upper_bound(rand) :
-			this->shares.upper_bound(rand + interval);
+	SharesMap::const_iterator it2 = (rand < begin) ? this->UpperBound(rand) :
+			this->UpperBound(rand + interval);
 	assert(it2 != this->shares.end() && it2->first <= this->unrestricted);
 	if (it2->second != excluded && it2->second != excluded2) return it2->second;
 
@@ -4837,13 +4839,13 @@ StationID FlowStat::GetVia(StationID excluded, StationID excluded2) const
 		std::swap(interval, interval2);
 	}
 	rand = RandomRange(new_max);
-	SharesMap::const_iterator it3 = this->shares.upper_bound(this->unrestricted);
+	SharesMap::const_iterator it3 = this->UpperBound(this->unrestricted);
 	if (rand < begin) {
-		it3 = this->shares.upper_bound(rand);
+		it3 = this->UpperBound(rand);
 	} else if (rand < begin2 - interval) {
-		it3 = this->shares.upper_bound(rand + interval);
+		it3 = this->UpperBound(rand + interval);
 	} else {
-		it3 = this->shares.upper_bound(rand + interval + interval2);
+		it3 = this->UpperBound(rand + interval + interval2);
 	}
 	assert(it3 != this->shares.end() && it3->first <= this->unrestricted);
 	return it3->second;
@@ -4858,13 +4860,14 @@ void FlowStat::Invalidate()
 {
 	assert(!this->shares.empty());
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size() + 1);
 	uint i = 0;
 	for (const auto &it : this->shares) {
-		new_shares[++i] = it.second;
+		new_shares.emplace_back(++i, it.second);
 		if (it.first == this->unrestricted) this->unrestricted = i;
 	}
 	this->shares.swap(new_shares);
-	assert(!this->shares.empty() && this->unrestricted <= (--this->shares.end())->first);
+	assert(!this->shares.empty() && this->unrestricted <= this->shares.back().first);
 }
 
 /**
@@ -4883,6 +4886,7 @@ void FlowStat::ChangeShare(StationID st, int flow)
 	uint added_shares = 0;
 	uint last_share = 0;
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size() + 1);
 	for (const auto &it : this->shares) {
 		if (it.second == st) {
 			if (flow < 0) {
@@ -4904,11 +4908,11 @@ void FlowStat::ChangeShare(StationID st, int flow)
 			 * removed. */
 			flow = 0;
 		}
-		new_shares[it.first + added_shares - removed_shares] = it.second;
+		new_shares.emplace_back(it.first + added_shares - removed_shares, it.second);
 		last_share = it.first;
 	}
 	if (flow > 0) {
-		new_shares[last_share + (uint)flow] = st;
+		new_shares.emplace_back(last_share + (uint)flow, st);
 		if (this->unrestricted < last_share) {
 			this->ReleaseShare(st);
 		} else {
@@ -4929,6 +4933,7 @@ void FlowStat::RestrictShare(StationID st)
 	uint flow = 0;
 	uint last_share = 0;
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size() + 1);
 	for (auto &it : this->shares) {
 		if (flow == 0) {
 			if (it.first > this->unrestricted) return; // Not present or already restricted.
@@ -4936,15 +4941,16 @@ void FlowStat::RestrictShare(StationID st)
 				flow = it.first - last_share;
 				this->unrestricted -= flow;
 			} else {
-				new_shares[it.first] = it.second;
+				new_shares.emplace_back(it.first, it.second);
 			}
 		} else {
-			new_shares[it.first - flow] = it.second;
+			new_shares.emplace_back(it.first - flow, it.second);
 		}
 		last_share = it.first;
 	}
 	if (flow == 0) return;
-	new_shares[last_share + flow] = st;
+	/* The other shares moved down by flow, so the moved share ends at the old total again. */
+	new_shares.emplace_back(last_share, st);
 	this->shares.swap(new_shares);
 	assert(!this->shares.empty());
 }
@@ -4960,7 +4966,7 @@ void FlowStat::ReleaseShare(StationID st)
 	uint flow = 0;
 	uint next_share = 0;
 	bool found = false;
-	for (SharesMap::reverse_iterator it(this->shares.rbegin()); it != this->shares.rend(); ++it) {
+	for (SharesMap::const_reverse_iterator it(this->shares.rbegin()); it != this->shares.rend(); ++it) {
 		if (it->first < this->unrestricted) return; // Note: not <= as the share may hit the limit.
 		if (found) {
 			flow = next_share - it->first;
@@ -4974,10 +4980,11 @@ void FlowStat::ReleaseShare(StationID st)
 	}
 	if (flow == 0) return;
 	SharesMap new_shares;
-	new_shares[flow] = st;
-	for (SharesMap::iterator it(this->shares.begin()); it != this->shares.end(); ++it) {
+	new_shares.reserve(this->shares.size() + 1);
+	new_shares.emplace_back(flow, st);
+	for (SharesMap::const_iterator it(this->shares.begin()); it != this->shares.end(); ++it) {
 		if (it->second != st) {
-			new_shares[flow + it->first] = it->second;
+			new_shares.emplace_back(flow + it->first, it->second);
 		} else {
 			flow = 0;
 		}
@@ -4995,10 +5002,11 @@ void FlowStat::ScaleToMonthly(uint runtime)
 {
 	assert(runtime > 0);
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size() + 1);
 	uint share = 0;
 	for (auto i : this->shares) {
 		share = std::max(share + 1, i.first * 30 / runtime);
-		new_shares[share] = i.second;
+		new_shares.emplace_back(share, i.second);
 		if (this->unrestricted == i.first) this->unrestricted = share;
 	}
 	this->shares.swap(new_shares);
@@ -25,6 +25,16 @@ struct Kdtree_StationXYFunc {
 using StationKdtree = Kdtree<StationID, Kdtree_StationXYFunc, uint16_t, int>;
 extern StationKdtree _station_kdtree;
 
+struct Kdtree_AirportXYFunc {
+	inline uint16_t operator()(StationID stid, int dim)
+	{
+		return (dim == 0) ? TileX(Station::Get(stid)->airport.tile) : TileY(Station::Get(stid)->airport.tile);
+	}
+};
+
+using AirportKdtree = Kdtree<StationID, Kdtree_AirportXYFunc, uint16_t, int>;
+const AirportKdtree &GetHangarKdtree(Owner owner);
+
 /**
  * Call a function on all stations whose sign is within a radius of a center tile.
  * @param center  Central tile to search around.
@@ -269,24 +269,31 @@ struct LanguagePack : public LanguagePackHeader {
 	char data[]; // list of strings
 };
 
-struct LanguagePackDeleter {
-	void operator()(LanguagePack *langpack)
-	{
-		/* LanguagePack is in fact reinterpreted char[], we need to reinterpret it back to free it properly. */
-		delete[] reinterpret_cast<char *>(langpack);
-	}
-};
-
 struct LoadedLanguagePack {
-	std::unique_ptr<LanguagePack, LanguagePackDeleter> langpack;
+	std::unique_ptr<MappedFile> file; ///< The (mapped) language file.
+	const LanguagePack *langpack = nullptr; ///< The language pack within the file.
 
-	std::vector<std::string_view> strings;
+	std::vector<uint32_t> offsets; ///< Offset of each string (its length prefix) from the start of the file.
 
 	std::array<uint, TEXT_TAB_END> langtab_num;   ///< Offset into langpack offs
 	std::array<uint, TEXT_TAB_END> langtab_start; ///< Offset into langpack offs
 
 	std::string list_separator; ///< Current list separator string.
 	std::string ellipsis; ///< Current ellipsis string.
+
+	/**
+	 * Get a string of the language pack. The string is only decoded
+	 * from the file when it is requested; it is validated during loading.
+	 * @param index Index of the string in the language pack.
+	 * @return The string.
+	 */
+	std::string_view GetString(size_t index) const
+	{
+		const char *s = this->file->GetData().data() + this->offsets[index];
+		size_t len = static_cast<uint8_t>(*s++);
+		if (len >= 0xC0) len = ((len & 0x3F) << 8) + static_cast<uint8_t>(*s++);
+		return {s, len};
+	}
 };
 
 static LoadedLanguagePack _langpack;
@@ -320,7 +327,7 @@ std::string_view GetStringPtr(StringID string)
 		case TEXT_TAB_NEWGRF_START: return GetGRFStringPtr(GetStringIndex(string));
 		default: {
 			const size_t offset = _langpack.langtab_start[GetStringTab(string)] + GetStringIndex(string).base();
-			if (offset < _langpack.strings.size()) return _langpack.strings[offset];
+			if (offset < _langpack.offsets.size()) return _langpack.GetString(offset);
 			return "(undefined string)";
 		}
 	}
@@ -2020,16 +2027,18 @@ bool LanguagePackHeader::IsReasonablyFinished() const
  */
 bool ReadLanguagePack(const LanguageMetadata *lang)
 {
-	/* Current language pack */
-	size_t total_len = 0;
-	std::unique_ptr<LanguagePack, LanguagePackDeleter> lang_pack(reinterpret_cast<LanguagePack *>(ReadFileToMem(FS2OTTD(lang->file.native()), total_len, 1U << 20).release()));
-	if (!lang_pack) return false;
+	/* Current language pack. The file is mapped, so only the strings that are used need to be loaded. */
+	std::unique_ptr<MappedFile> file = MappedFile::Open(FS2OTTD(lang->file.native()), 1U << 20);
+	if (file == nullptr) return false;
 
-	/* End of read data (+ terminating zero added in ReadFileToMem()) */
-	const char *end = (char *)lang_pack.get() + total_len + 1;
+	std::span<const char> contents = file->GetData();
+	const LanguagePack *lang_pack = reinterpret_cast<const LanguagePack *>(contents.data());
 
-	/* We need at least one byte of lang_pack->data */
-	if (end <= lang_pack->data || !lang_pack->IsValid()) {
+	/* End of read data */
+	const char *end = contents.data() + contents.size();
+
+	/* We need at least the complete header */
+	if (contents.size() < sizeof(LanguagePackHeader) || !lang_pack->IsValid()) {
 		return false;
 	}
 
@@ -2046,25 +2055,28 @@ bool ReadLanguagePack(const LanguageMetadata *lang)
 	}
 
 	/* Allocate offsets */
-	std::vector<std::string_view> strings;
+	std::vector<uint32_t> offsets;
+	offsets.reserve(count);
 
 	/* Fill offsets */
-	char *s = lang_pack->data;
+	const char *s = lang_pack->data;
 	for (uint i = 0; i < count; i++) {
-		size_t len = static_cast<uint8_t>(*s++);
-		if (s + len >= end) return false;
+		offsets.push_back(static_cast<uint32_t>(s - contents.data()));
 
+		if (s >= end) return false;
+		size_t len = static_cast<uint8_t>(*s++);
 		if (len >= 0xC0) {
+			if (s >= end) return false;
 			len = ((len & 0x3F) << 8) + static_cast<uint8_t>(*s++);
-			if (s + len >= end) return false;
 		}
-		strings.emplace_back(s, len);
+		if (static_cast<size_t>(end - s) < len) return false;
 		s += len;
 	}
-	assert(strings.size() == count);
+	assert(offsets.size() == count);
 
-	_langpack.langpack = std::move(lang_pack);
-	_langpack.strings = std::move(strings);
+	_langpack.file = std::move(file);
+	_langpack.langpack = lang_pack;
+	_langpack.offsets = std::move(offsets);
 	_langpack.langtab_num = tab_num;
 	_langpack.langtab_start = tab_start;
 
@@ -2318,7 +2330,7 @@ class LanguagePackGlyphSearcher : public MissingGlyphSearcher {
 	{
 		if (this->i >= TEXT_TAB_END) return std::nullopt;
 
-		std::string_view ret = _langpack.strings[_langpack.langtab_start[this->i] + this->j];
+		std::string_view ret = _langpack.GetString(_langpack.langtab_start[this->i] + this->j);
 
 		this->j++;
 		while (this->i < TEXT_TAB_END && this->j >= _langpack.langtab_num[this->i]) {
@@ -0,0 +1,123 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file flowstat.cpp Test functionality of the cargodist flow statistics. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../station_base.h"
+#include "../core/random_func.hpp"
+
+#include "../safeguards.h"
+
+/**
+ * Get the shares of a flow stat as (share, station) pairs instead of cumulative values.
+ * @param fs Flow stat to get the shares for.
+ * @return Individual shares in order.
+ */
+static std::vector<std::pair<uint, StationID>> GetIndividualShares(const FlowStat &fs)
+{
+	std::vector<std::pair<uint, StationID>> result;
+	uint32_t prev = 0;
+	for (const auto &it : *fs.GetShares()) {
+		result.emplace_back(it.first - prev, it.second);
+		prev = it.first;
+	}
+	return result;
+}
+
+TEST_CASE("FlowStat - shares")
+{
+	FlowStat fs(StationID{1}, 10);
+	fs.AppendShare(StationID{2}, 20);
+	fs.AppendShare(StationID{3}, 5, true);
+
+	CHECK(fs.GetShare(StationID{1}) == 10);
+	CHECK(fs.GetShare(StationID{2}) == 20);
+	CHECK(fs.GetShare(StationID{3}) == 5);
+	CHECK(fs.GetShare(StationID{4}) == 0);
+	CHECK(fs.GetUnrestricted() == 30);
+
+	fs.ChangeShare(StationID{1}, 5);
+	fs.ChangeShare(StationID{2}, -15);
+	fs.ChangeShare(StationID{4}, 7);
+	CHECK(GetIndividualShares(fs) == std::vector<std::pair<uint, StationID>>{{15, StationID{1}}, {5, StationID{2}}, {5, StationID{3}}, {7, StationID{4}}});
+
+	fs.ChangeShare(StationID{2}, INT_MIN);
+	CHECK(fs.GetShare(StationID{2}) == 0);
+	CHECK(fs.GetShares()->size() == 3);
+
+	fs.RestrictShare(StationID{1});
+	CHECK(GetIndividualShares(fs).back() == std::pair<uint, StationID>{15, StationID{1}});
+	CHECK(fs.GetUnrestricted() == 0);
+
+	fs.ReleaseShare(StationID{1});
+	CHECK(GetIndividualShares(fs).front() == std::pair<uint, StationID>{15, StationID{1}});
+	CHECK(fs.GetUnrestricted() == 15);
+
+	fs.Invalidate();
+	CHECK(GetIndividualShares(fs) == std::vector<std::pair<uint, StationID>>{{1, StationID{1}}, {1, StationID{3}}, {1, StationID{4}}});
+	CHECK(fs.GetUnrestricted() == 1);
+}
+
+TEST_CASE("FlowStat - routing")
+{
+	_random.SetSeed(0x1234);
+
+	FlowStat fs(StationID{1}, 1);
+	for (uint i = 2; i <= 16; ++i) fs.AppendShare(StationID(i), i);
+	uint total = fs.GetShares()->back().first;
+
+	std::array<uint, 17> hits{};
+	const uint rounds = 100000;
+	for (uint i = 0; i < rounds; ++i) {
+		StationID via = fs.GetVia();
+		REQUIRE(via.base() >= 1);
+		REQUIRE(via.base() <= 16);
+		hits[via.base()]++;
+	}
+
+	/* Every next hop must be chosen roughly according to its share. */
+	for (uint i = 1; i <= 16; ++i) {
+		double expected = static_cast<double>(rounds) * i / total;
+		CHECK(std::abs(hits[i] - expected) < expected * 0.25 + 20);
+	}
+
+	/* Excluded stations are never chosen. */
+	for (uint i = 0; i < 1000; ++i) {
+		StationID via = fs.GetVia(StationID{16}, StationID{1});
+		CHECK(via != StationID{16});
+		CHECK(via != StationID{1});
+	}
+
+	FlowStat single(StationID{5}, 10);
+	CHECK(single.GetVia(StationID{5}) == StationID::Invalid());
+}
+
+TEST_CASE("FlowStat - routing benchmark", "[.][bench]")
+{
+	_random.SetSeed(0x1234);
+
+	std::vector<FlowStat> flows;
+	for (uint n = 1; n <= 32; ++n) {
+		FlowStat &fs = flows.emplace_back(StationID{0}, 1 + n);
+		for (uint i = 1; i < n; ++i) fs.AppendShare(StationID(i), 1 + (i * 7919) % 97);
+	}
+
+	const uint rounds = 10000000;
+	uint checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (uint i = 0; i < rounds; ++i) {
+		checksum += flows[i % flows.size()].GetVia().base();
+	}
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+	WARN(fmt::format("{} lookups in {} us ({:.1f} ns/lookup), checksum {}", rounds, duration.count(), duration.count() * 1000.0 / rounds, checksum));
+	CHECK(checksum > 0);
+}
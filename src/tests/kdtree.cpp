@@ -0,0 +1,77 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file kdtree.cpp Test functionality from core/kdtree. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/kdtree.hpp"
+
+#include "../safeguards.h"
+
+/** Points the test trees index into. */
+static std::vector<std::pair<uint16_t, uint16_t>> _test_points;
+
+struct Kdtree_TestXYFunc {
+	inline uint16_t operator()(uint32_t index, int dim)
+	{
+		return (dim == 0) ? _test_points[index].first : _test_points[index].second;
+	}
+};
+
+using TestKdtree = Kdtree<uint32_t, Kdtree_TestXYFunc, uint16_t, int>;
+
+TEST_CASE("Kdtree - FindNearestIf")
+{
+	/* A grid with some duplicated positions, so ties have to be broken by index. */
+	_test_points.clear();
+	for (uint16_t y = 0; y < 40; y += 3) {
+		for (uint16_t x = 0; x < 40; x += 2) {
+			_test_points.emplace_back(x, y);
+			if ((x + y) % 7 == 0) _test_points.emplace_back(x, y);
+		}
+	}
+	std::vector<uint32_t> indices(_test_points.size());
+	std::iota(indices.begin(), indices.end(), 0);
+
+	/* Building reorders the elements, so keep the original order for the brute force search. */
+	std::vector<uint32_t> elements = indices;
+	TestKdtree tree;
+	tree.Build(elements.begin(), elements.end());
+
+	auto square = [](int dx, int dy) { return dx * dx + dy * dy; };
+	auto filter = [](uint32_t index) { return index % 5 != 0; };
+
+	for (uint16_t y = 0; y < 45; y += 1) {
+		for (uint16_t x = 0; x < 45; x += 1) {
+			for (int limit : {std::numeric_limits<int>::max(), 9, 0}) {
+				/* Brute force: first index with the smallest distance within the limit. */
+				std::optional<uint32_t> expected;
+				int best = 0;
+				for (uint32_t index : indices) {
+					if (!filter(index)) continue;
+					int dx = _test_points[index].first - x;
+					int dy = _test_points[index].second - y;
+					int dist = square(std::abs(dx), std::abs(dy));
+					if (dist > limit) continue;
+					if (!expected.has_value() || dist < best) {
+						expected = index;
+						best = dist;
+					}
+				}
+
+				INFO("x " << x << " y " << y << " limit " << limit);
+				CHECK(tree.FindNearestIf(x, y, limit, filter, square).value_or(UINT32_MAX) == expected.value_or(UINT32_MAX));
+			}
+		}
+	}
+
+	TestKdtree empty;
+	CHECK_FALSE(empty.FindNearestIf(0, 0, std::numeric_limits<int>::max(), filter, square).has_value());
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file linkgraph_demands.cpp Test the demand calculation of cargodist. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/random_func.hpp"
+#include "../map_func.h"
+#include "../settings_type.h"
+#include "../linkgraph/linkgraphjob.h"
+#include "../linkgraph/demands.h"
+
+#include "../safeguards.h"
+
+/**
+ * Calculate the demands on a link graph with nodes at random places on the map,
+ * some of which supply or accept nothing.
+ * @param size Number of nodes.
+ * @param type Distribution type.
+ * @param distance Effect of the distance on the demands.
+ * @return Hash of the demand and unsatisfied demand between every pair of nodes.
+ */
+static uint64_t HashLinkGraphDemands(uint size, DistributionType type, uint8_t distance)
+{
+	Map::Allocate(256, 256);
+	_settings_game.linkgraph.distribution_default = type;
+	_settings_game.linkgraph.accuracy = 16;
+	_settings_game.linkgraph.demand_size = 100;
+	_settings_game.linkgraph.demand_distance = distance;
+
+	Randomizer random;
+	random.SetSeed(0x44454D44);
+
+	REQUIRE(LinkGraph::CanAllocateItem());
+	LinkGraph *lg = new LinkGraph(CargoType{0});
+	lg->Init(size);
+	for (NodeID i = 0; i < size; i++) {
+		LinkGraph::BaseNode &node = (*lg)[i];
+		node.xy = TileXY(random.Next(Map::SizeX()), random.Next(Map::SizeY()));
+		node.supply = random.Next(4) == 0 ? 0 : 1 + random.Next(500);
+		node.demand = random.Next(4) == 0 ? 0 : 1;
+	}
+
+	REQUIRE(LinkGraphJob::CanAllocateItem());
+	LinkGraphJob *job = new LinkGraphJob(*lg);
+	job->Init();
+	DemandCalculator demands(*job);
+
+	/* FNV-1a */
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	auto add = [&hash](uint value) {
+		for (uint i = 0; i < 4; i++) {
+			hash ^= GB(value, i * 8, 8);
+			hash *= 0x100000001B3ULL;
+		}
+	};
+	for (NodeID from = 0; from < size; from++) {
+		for (NodeID to = 0; to < size; to++) {
+			add((*job)[from].DemandTo(to));
+			add((*job)[from].UnsatisfiedDemandTo(to));
+		}
+	}
+
+	delete job;
+	delete lg;
+	return hash;
+}
+
+TEST_CASE("LinkGraph - demands are the same as calculated serially")
+{
+	/* Hashes of the demands as calculated before the divisors were precalculated by multiple threads.
+	 * The largest graph has more pairs of nodes than the table of divisors used to be limited to. */
+	static const struct {
+		uint size;
+		DistributionType type;
+		uint8_t distance;
+		uint64_t hash;
+	} cases[] = {
+		{   40, DT_SYMMETRIC,    0, 0xB3C408EA1EB8A4E5ULL },
+		{   40, DT_SYMMETRIC,  100, 0x205EEDAAFBF694E5ULL },
+		{   40, DT_ASYMMETRIC, 255, 0xFA15F3E17AE36325ULL },
+		{  400, DT_SYMMETRIC,   50, 0x053CD0B2C63E46A5ULL },
+		{  400, DT_SYMMETRIC,  255, 0x7194BC9EDA20C929ULL },
+		{  400, DT_ASYMMETRIC, 100, 0xFDEDA57B5EA9D5D5ULL },
+		{ 3000, DT_SYMMETRIC, 100, 0x8F02E25C6D0335C5ULL },
+	};
+
+	for (const auto &c : cases) {
+		INFO("size " << c.size << ", type " << static_cast<int>(c.type) << ", distance " << static_cast<int>(c.distance));
+		CHECK(HashLinkGraphDemands(c.size, c.type, c.distance) == c.hash);
+	}
+}
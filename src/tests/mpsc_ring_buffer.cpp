@@ -0,0 +1,76 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file mpsc_ring_buffer.cpp Test functionality from core/mpsc_ring_buffer. */
+
+#include "../stdafx.h"
+
+#include <thread>
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../core/format.hpp"
+#include "../core/mpsc_ring_buffer.hpp"
+
+#include "../safeguards.h"
+
+TEST_CASE("MPSCRingBuffer - order and capacity")
+{
+	MPSCRingBuffer<std::string, 4> queue;
+
+	CHECK_FALSE(queue.TryPop().has_value());
+
+	/* Fill it completely, more than once, to wrap around. */
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 4; i++) CHECK(queue.TryPush(fmt::format("{}-{}", round, i)));
+
+		std::string rejected = "full";
+		CHECK_FALSE(queue.TryPush(std::move(rejected)));
+		CHECK(rejected == "full");
+
+		for (int i = 0; i < 4; i++) CHECK(queue.TryPop() == fmt::format("{}-{}", round, i));
+		CHECK_FALSE(queue.TryPop().has_value());
+	}
+}
+
+TEST_CASE("MPSCRingBuffer - many producers")
+{
+	static constexpr int PRODUCERS = 4;
+	static constexpr int ITEMS = 10000;
+
+	MPSCRingBuffer<int, 64> queue;
+	std::vector<std::thread> producers;
+	for (int p = 0; p < PRODUCERS; p++) {
+		producers.emplace_back([&queue, p]() {
+			for (int i = 0; i < ITEMS; i++) {
+				while (!queue.TryPush(p * ITEMS + i)) std::this_thread::yield();
+			}
+		});
+	}
+
+	/* Every item must arrive exactly once, and the items of one producer in the order they were pushed. */
+	std::array<int, PRODUCERS> next{};
+	int received = 0;
+	bool in_order = true;
+	while (received < PRODUCERS * ITEMS) {
+		std::optional<int> item = queue.TryPop();
+		if (!item.has_value()) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		int p = *item / ITEMS;
+		if (*item % ITEMS != next[p]) in_order = false;
+		next[p]++;
+		received++;
+	}
+
+	for (std::thread &producer : producers) producer.join();
+
+	CHECK(in_order);
+	CHECK_FALSE(queue.TryPop().has_value());
+}
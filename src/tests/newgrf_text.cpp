@@ -0,0 +1,71 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file newgrf_text.cpp Test functionality of the NewGRF texts. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../newgrf.h"
+#include "../newgrf_config.h"
+#include "../newgrf_text.h"
+#include "../strings_func.h"
+#include "../newgrf/newgrf_bytereader.h"
+#include "../newgrf/newgrf_internal.h"
+
+#include "table/strings.h"
+
+#include "../safeguards.h"
+
+static const uint32_t TEST_GRFID = 0x12345678; ///< GRFID of the NewGRF the texts belong to.
+static const uint8_t TEST_LANG_ENGLISH = 0x01; ///< NewGRF language ID of English.
+static const uint8_t TEST_LANG_GERMAN = 0x02; ///< NewGRF language ID of German.
+
+TEST_CASE("NewGRF texts - translated on activation")
+{
+	SetCurrentGrfLangID(TEST_LANG_GERMAN);
+	StringID id = AddGRFString(TEST_GRFID, GRFStringID{0xD000}, TEST_LANG_ENGLISH, true, true, "Station", STR_UNDEFINED);
+	AddGRFString(TEST_GRFID, GRFStringID{0xD000}, TEST_LANG_GERMAN, true, true, "Bahnhof", STR_UNDEFINED);
+	TranslatePendingGRFTexts(TEST_GRFID);
+
+	CHECK(GetGRFStringPtr(GetStringIndex(id)) == "Bahnhof");
+
+	/* Texts of other languages are translated once the language is changed. */
+	SetCurrentGrfLangID(TEST_LANG_ENGLISH);
+	CHECK(GetGRFStringPtr(GetStringIndex(id)) == "Station");
+
+	CleanUpStrings();
+}
+
+TEST_CASE("NewGRF texts - action 13 translates an activated NewGRF")
+{
+	SetCurrentGrfLangID(TEST_LANG_GERMAN);
+	StringID id = AddGRFString(TEST_GRFID, GRFStringID{0xD000}, TEST_LANG_ENGLISH, true, true, "Station", STR_UNDEFINED);
+	TranslatePendingGRFTexts(TEST_GRFID);
+	CHECK(GetGRFStringPtr(GetStringIndex(id)) == "Station");
+
+	/* Another NewGRF translates the string of the activated NewGRF. */
+	GRFConfig *config = _grfconfig.emplace_back(std::make_unique<GRFConfig>()).get();
+	config->ident.grfid = TEST_GRFID;
+	config->status = GCS_ACTIVATED;
+	GRFFile translator;
+	translator.grf_version = 8;
+	_cur_gps.grffile = &translator;
+
+	/* <13> <grfid> <language> <num-ent> <offset> <text...> */
+	const uint8_t action[] = { 0x78, 0x56, 0x34, 0x12, TEST_LANG_GERMAN, 0x01, 0x00, 0xD0, 'B', 'a', 'h', 'n', 'h', 'o', 'f', 0x00 };
+	ByteReader buf(action, std::size(action));
+	GrfActionHandler<0x13>::Activation(buf);
+
+	CHECK(GetGRFStringPtr(GetStringIndex(id)) == "Bahnhof");
+
+	_cur_gps.grffile = nullptr;
+	_grfconfig.clear();
+	CleanUpStrings();
+	SetCurrentGrfLangID(TEST_LANG_ENGLISH);
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file savegame_store.cpp Test functionality of the deduplicating savegame store. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../saveload/savegame_store.h"
+#include "../core/random_func.hpp"
+
+#include "../safeguards.h"
+
+/**
+ * Create data that looks a bit like a savegame: random, with long runs of the same byte.
+ * @param size Number of bytes.
+ * @param seed Seed of the random data.
+ * @return The data.
+ */
+static std::vector<uint8_t> CreateTestData(size_t size, uint32_t seed)
+{
+	Randomizer random;
+	random.SetSeed(seed);
+
+	std::vector<uint8_t> data;
+	data.reserve(size);
+	while (data.size() < size) {
+		uint8_t value = random.Next(256);
+		size_t run = random.Next(4) == 0 ? random.Next(256) : 1;
+		data.insert(data.end(), std::min(run, size - data.size()), value);
+	}
+	return data;
+}
+
+/**
+ * Cut data into blocks, writing it in pieces of a given size.
+ * @param data The data.
+ * @param piece Number of bytes to write at once.
+ * @return The blocks, in order.
+ */
+static std::vector<std::vector<uint8_t>> CutBlocks(std::span<const uint8_t> data, size_t piece)
+{
+	std::vector<std::vector<uint8_t>> blocks;
+	SavegameStoreChunker chunker([&blocks](std::span<const uint8_t> block) { blocks.emplace_back(block.begin(), block.end()); });
+	while (!data.empty()) {
+		size_t size = std::min(piece, data.size());
+		chunker.Write(data.first(size));
+		data = data.subspan(size);
+	}
+	chunker.Finish();
+	return blocks;
+}
+
+TEST_CASE("SavegameStoreChunker - block boundaries")
+{
+	std::vector<uint8_t> data = CreateTestData(1024 * 1024, 1);
+	auto blocks = CutBlocks(data, data.size());
+
+	CHECK(blocks.size() > 1);
+	for (size_t i = 0; i < blocks.size(); i++) {
+		CHECK(blocks[i].size() <= SavegameStoreChunker::MAX_BLOCK_SIZE);
+		/* Only the last block may be shorter than the minimum. */
+		if (i + 1 < blocks.size()) CHECK(blocks[i].size() >= SavegameStoreChunker::MIN_BLOCK_SIZE);
+	}
+
+	/* The boundaries depend on the data only, not on how it is written. */
+	CHECK(CutBlocks(data, 1) == blocks);
+	CHECK(CutBlocks(data, 4099) == blocks);
+
+	/* Data without any boundary is cut at the maximum size. */
+	std::vector<uint8_t> zeros(SavegameStoreChunker::MAX_BLOCK_SIZE * 2 + 10);
+	auto zero_blocks = CutBlocks(zeros, zeros.size());
+	REQUIRE(zero_blocks.size() == 3);
+	CHECK(zero_blocks[0].size() == SavegameStoreChunker::MAX_BLOCK_SIZE);
+	CHECK(zero_blocks[1].size() == SavegameStoreChunker::MAX_BLOCK_SIZE);
+	CHECK(zero_blocks[2].size() == 10);
+
+	CHECK(CutBlocks({}, 1).empty());
+}
+
+TEST_CASE("SavegameStoreChunker - deduplication")
+{
+	std::vector<uint8_t> data = CreateTestData(1024 * 1024, 2);
+	auto blocks = CutBlocks(data, data.size());
+	std::set<std::vector<uint8_t>> known(blocks.begin(), blocks.end());
+
+	/* Insert some bytes in the middle; only the blocks around the insertion may change. */
+	std::vector<uint8_t> changed = data;
+	changed.insert(changed.begin() + changed.size() / 2, 100, 0x42);
+	auto changed_blocks = CutBlocks(changed, changed.size());
+
+	size_t new_blocks = std::ranges::count_if(changed_blocks, [&known](const auto &block) { return !known.contains(block); });
+	CHECK(new_blocks >= 1);
+	CHECK(new_blocks <= 2);
+}
+
+TEST_CASE("SavegameStoreChunker - round trip")
+{
+	std::vector<uint8_t> data = CreateTestData(512 * 1024, 3);
+	/* Include a block that does not compress. */
+	Randomizer random;
+	random.SetSeed(4);
+	for (size_t i = 0; i < SavegameStoreChunker::MAX_BLOCK_SIZE; i++) data.push_back(random.Next(256));
+
+	std::vector<uint8_t> restored;
+	std::vector<uint8_t> buffer;
+	std::vector<uint8_t> raw;
+	for (const auto &block : CutBlocks(data, 1000)) {
+		StoreBlockEncoding encoding;
+		std::span<const uint8_t> stored = EncodeStoreBlock(block, buffer, encoding);
+		if (encoding == SBE_RAW) CHECK(stored.size() == block.size());
+
+		REQUIRE(DecodeStoreBlock(encoding, stored, block.size(), raw));
+		CHECK(raw == block);
+		restored.insert(restored.end(), raw.begin(), raw.end());
+
+		/* A block of the wrong size is rejected. */
+		CHECK_FALSE(DecodeStoreBlock(encoding, stored, block.size() + 1, raw));
+	}
+	CHECK(restored == data);
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file scope_profiler.cpp Test functionality of the hierarchical scope profiler. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../scope_profiler.h"
+
+#include "../safeguards.h"
+
+TEST_CASE("ScopeProfiler - nested scopes")
+{
+	ScopeProfiler::Clear();
+
+	{
+		ProfileScope ignored("ignored");
+	}
+	CHECK(ScopeProfiler::GetEvents().empty());
+
+	ScopeProfiler::Start();
+	{
+		ProfileScope outer("outer");
+		{
+			ProfileScope inner("inner", 42);
+		}
+	}
+	ScopeProfiler::Stop();
+
+	std::vector<ProfileEvent> events = ScopeProfiler::GetEvents();
+	REQUIRE(events.size() == 2);
+
+	/* Events are ordered by the time they ended, so the inner scope comes first. */
+	CHECK(events[0].name == "inner");
+	CHECK(events[0].object == 42);
+	CHECK(events[0].depth == 1);
+	CHECK(events[1].name == "outer");
+	CHECK(events[1].object == ProfileEvent::NO_OBJECT);
+	CHECK(events[1].depth == 0);
+	CHECK(events[0].thread == events[1].thread);
+
+	CHECK(events[1].start <= events[0].start);
+	CHECK(events[0].start + events[0].duration <= events[1].start + events[1].duration);
+
+	CHECK(ScopeProfiler::GetEvents(events[1].start + events[1].duration + 1).empty());
+
+	ScopeProfiler::Clear();
+	CHECK(ScopeProfiler::GetEvents().empty());
+}
+
+TEST_CASE("ScopeProfiler - ring buffer")
+{
+	ScopeProfiler::Clear();
+
+	ScopeProfiler::Start();
+	for (size_t i = 0; i < ScopeProfiler::EVENTS_PER_THREAD + 10; i++) {
+		ProfileScope scope("scope", static_cast<uint32_t>(i));
+	}
+	ScopeProfiler::Stop();
+
+	std::vector<ProfileEvent> events = ScopeProfiler::GetEvents();
+	REQUIRE(events.size() == ScopeProfiler::EVENTS_PER_THREAD);
+	CHECK(events.front().object == 10);
+	CHECK(events.back().object == ScopeProfiler::EVENTS_PER_THREAD + 9);
+
+	ScopeProfiler::Clear();
+}
+
+TEST_CASE("ScopeProfiler - tree")
+{
+	std::vector<ProfileEvent> events = {
+		{"inner", 20, 10, ProfileEvent::NO_OBJECT, 1, 1},
+		{"second", 35, 5, ProfileEvent::NO_OBJECT, 1, 1},
+		{"outer", 10, 40, ProfileEvent::NO_OBJECT, 0, 1},
+		{"orphan", 60, 5, ProfileEvent::NO_OBJECT, 2, 1},
+		{"other thread", 15, 5, ProfileEvent::NO_OBJECT, 0, 2},
+	};
+
+	std::vector<ProfileNode> roots = ScopeProfiler::BuildTree(events);
+	REQUIRE(roots.size() == 3);
+
+	CHECK(roots[0].event.name == "outer");
+	REQUIRE(roots[0].children.size() == 2);
+	CHECK(roots[0].children[0].event.name == "inner");
+	CHECK(roots[0].children[0].children.empty());
+	CHECK(roots[0].children[1].event.name == "second");
+
+	/* The scope around this one is not in the list. */
+	CHECK(roots[1].event.name == "orphan");
+	CHECK(roots[1].children.empty());
+
+	CHECK(roots[2].event.name == "other thread");
+	CHECK(roots[2].children.empty());
+}
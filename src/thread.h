@@ -12,6 +12,7 @@
 
 #include "debug.h"
 #include "crashlog.h"
+#include "scope_profiler.h"
 #include "error_func.h"
 #include <system_error>
 #include <thread>
@@ -60,6 +61,7 @@ inline bool StartNewThread(std::thread *thr, std::string_view name, TFn&& _Fx, T
 
 				SetCurrentThreadName(name);
 				CrashLog::InitThread();
+				ScopeProfiler::SetThreadName(name);
 				try {
 					/* Call user function with the given arguments. */
 					F(A...);
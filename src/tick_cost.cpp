@@ -0,0 +1,174 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file tick_cost.cpp Sampled attribution of the game loop time to companies, vehicles and groups. */
+
+#include "stdafx.h"
+#include "tick_cost.h"
+#include "vehicle_base.h"
+#include "timer/timer_game_tick.h"
+
+#include <chrono>
+
+#include "safeguards.h"
+
+/* static */ bool TickCostAccounting::sampling = false;
+
+namespace {
+	/** Time spent on a vehicle during the current period. */
+	struct VehicleCost {
+		Owner owner = INVALID_OWNER; ///< Owner of the vehicle.
+		uint64_t ns = 0; ///< Nanoseconds spent on the vehicle.
+	};
+
+	TickCostReport _report; ///< Report of the last complete period.
+	std::array<TickCosts, MAX_COMPANIES + 1> _current_costs{}; ///< Costs per company of the current period.
+	std::vector<VehicleCost> _current_vehicle_costs; ///< Costs per vehicle index of the current period.
+	uint _current_sampled_ticks = 0; ///< Number of measured ticks in the current period.
+	uint64_t _throttle_budget = 0; ///< Script time per tick above which AIs are throttled, or 0 when not throttling.
+	std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now(); ///< Reference for #TickCostAccounting::Now.
+}
+
+/**
+ * Get the index in the costs per company for an owner.
+ * @param owner The owner.
+ * @return Index of the company, or #TickCostReport::OTHER for non-company owners.
+ */
+static size_t GetTickCostIndex(Owner owner)
+{
+	return owner.base() < MAX_COMPANIES ? owner.base() : TickCostReport::OTHER;
+}
+
+/**
+ * Keep only the most expensive entries of a list, most expensive first.
+ * @param list The list to trim.
+ */
+template <typename T>
+static void KeepMostExpensive(std::vector<T> &list)
+{
+	size_t count = std::min(list.size(), TickCostReport::TOP_COUNT);
+	std::partial_sort(std::begin(list), std::begin(list) + count, std::end(list), [](const T &a, const T &b) { return a.ns > b.ns; });
+	list.resize(count);
+}
+
+/** Turn the measurements of the current period into the report, and start a new period. */
+static void FinishTickCostPeriod()
+{
+	_report.sampled_ticks = _current_sampled_ticks;
+	_report.companies = _current_costs;
+	_report.top_vehicles.clear();
+	_report.top_groups.clear();
+
+	std::map<std::pair<Owner, GroupID>, uint64_t> group_costs;
+	for (size_t index = 0; index < _current_vehicle_costs.size(); index++) {
+		const VehicleCost &cost = _current_vehicle_costs[index];
+		if (cost.ns == 0) continue;
+
+		_report.top_vehicles.emplace_back(static_cast<VehicleID>(index), cost.owner, cost.ns);
+
+		/* The vehicle may have been sold and its index reused; then its cost is not known to any group. */
+		const Vehicle *v = Vehicle::GetIfValid(index);
+		if (v != nullptr && v->owner == cost.owner && v->IsPrimaryVehicle()) group_costs[{v->owner, v->group_id}] += cost.ns;
+	}
+	KeepMostExpensive(_report.top_vehicles);
+
+	for (const auto &[key, ns] : group_costs) _report.top_groups.emplace_back(key.second, key.first, ns);
+	KeepMostExpensive(_report.top_groups);
+
+	_current_costs = {};
+	_current_vehicle_costs.clear();
+	_current_sampled_ticks = 0;
+}
+
+/**
+ * Start accounting a new game tick; decides whether the tick is measured.
+ */
+/* static */ void TickCostAccounting::OnTick()
+{
+	if (TimerGameTick::counter % PERIOD == 0) FinishTickCostPeriod();
+
+	TickCostAccounting::sampling = TimerGameTick::counter % SAMPLE_INTERVAL == 0;
+	if (TickCostAccounting::sampling) _current_sampled_ticks++;
+}
+
+/**
+ * Attribute time to a company.
+ * @param owner Company the work was done for.
+ * @param type Type of work.
+ * @param ns Nanoseconds spent.
+ */
+/* static */ void TickCostAccounting::Add(Owner owner, TickCostType type, uint64_t ns)
+{
+	_current_costs[GetTickCostIndex(owner)].ns[to_underlying(type)] += ns;
+}
+
+/**
+ * Attribute the time of a vehicle tick to the vehicle and its company.
+ * @param id The (front) vehicle.
+ * @param owner Owner of the vehicle.
+ * @param type Type of the vehicle; must be a company vehicle type.
+ * @param ns Nanoseconds spent.
+ */
+/* static */ void TickCostAccounting::AddVehicle(VehicleID id, Owner owner, VehicleType type, uint64_t ns)
+{
+	assert(type < VEH_COMPANY_END);
+	TickCostAccounting::Add(owner, static_cast<TickCostType>(to_underlying(TickCostType::Trains) + type), ns);
+
+	if (id.base() >= _current_vehicle_costs.size()) _current_vehicle_costs.resize(id.base() + 1);
+	VehicleCost &cost = _current_vehicle_costs[id.base()];
+	cost.owner = owner;
+	cost.ns += ns;
+}
+
+/**
+ * Get the costs of the last complete period.
+ * @return The report.
+ */
+/* static */ const TickCostReport &TickCostAccounting::GetReport()
+{
+	return _report;
+}
+
+/**
+ * Get the current time of the tick cost clock.
+ * @return Nanoseconds since the start of the game; never 0.
+ */
+/* static */ uint64_t TickCostAccounting::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count() + 1;
+}
+
+/**
+ * Set the script time per tick above which AIs are throttled.
+ * @param ns Nanoseconds per tick, or 0 to not throttle.
+ */
+/* static */ void TickCostAccounting::SetThrottleBudget(uint64_t ns)
+{
+	_throttle_budget = ns;
+}
+
+/**
+ * Get the script time per tick above which AIs are throttled.
+ * @return Nanoseconds per tick, or 0 when not throttling.
+ */
+/* static */ uint64_t TickCostAccounting::GetThrottleBudget()
+{
+	return _throttle_budget;
+}
+
+/**
+ * Test whether the AI of a company should skip this tick, because its script used more than the throttle budget in the last period.
+ * Throttled AIs run every other tick. AIs only run on the server, so this does not influence the game state of clients.
+ * @param company The company of the AI.
+ * @return True iff the AI should not run this tick.
+ */
+/* static */ bool TickCostAccounting::ShouldThrottleScript(CompanyID company)
+{
+	if (_throttle_budget == 0) return false;
+	if (_report.GetAverage(GetTickCostIndex(company), TickCostType::Script) <= _throttle_budget) return false;
+	return TimerGameTick::counter % 2 != 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file tick_cost.h Sampled attribution of the game loop time to companies, vehicles and groups.
+ *
+ * One in #TickCostAccounting::SAMPLE_INTERVAL game ticks is measured. The measurements of a
+ * period of #TickCostAccounting::PERIOD ticks are combined into a #TickCostReport, which is what
+ * the tick cost window and console command show. The measurements never influence the game
+ * state; only the optional throttling of AIs acts on them, and AIs only run on the server.
+ *
+ * @see tick_cost.cpp for implementation
+ */
+
+#ifndef TICK_COST_H
+#define TICK_COST_H
+
+#include "company_type.h"
+#include "group_type.h"
+#include "vehicle_type.h"
+
+/** Kinds of work the game loop time is attributed to. */
+enum class TickCostType : uint8_t {
+	Trains, ///< Train ticks, including their pathfinding.
+	RoadVehicles, ///< Road vehicle ticks, including their pathfinding.
+	Ships, ///< Ship ticks, including their pathfinding.
+	Aircraft, ///< Aircraft ticks.
+	Loading, ///< Loading and unloading at stations.
+	Pathfinder, ///< Pathfinder calls; also part of the vehicle ticks.
+	Script, ///< AI scripts.
+	End, ///< End marker.
+};
+
+/** Time spent on behalf of a single company. */
+struct TickCosts {
+	std::array<uint64_t, to_underlying(TickCostType::End)> ns{}; ///< Nanoseconds per type of work.
+
+	/**
+	 * Get the total time, counting the pathfinder only once.
+	 * @return Total nanoseconds.
+	 */
+	inline uint64_t GetTotal() const
+	{
+		uint64_t total = 0;
+		for (uint64_t ns : this->ns) total += ns;
+		return total - this->ns[to_underlying(TickCostType::Pathfinder)];
+	}
+};
+
+/** Time spent on a single vehicle. */
+struct TickCostVehicle {
+	VehicleID id; ///< The (front) vehicle.
+	Owner owner; ///< Owner of the vehicle.
+	uint64_t ns; ///< Nanoseconds spent on the vehicle.
+};
+
+/** Time spent on the vehicles of a single group. */
+struct TickCostGroup {
+	GroupID id; ///< The group, or #DEFAULT_GROUP for ungrouped vehicles.
+	Owner owner; ///< Owner of the group.
+	uint64_t ns; ///< Nanoseconds spent on the vehicles of the group.
+};
+
+/** Tick costs over the last complete period. */
+struct TickCostReport {
+	static constexpr size_t OTHER = MAX_COMPANIES; ///< Index in #companies for work not done on behalf of a company.
+	static constexpr size_t TOP_COUNT = 10; ///< Number of entries in #top_vehicles and #top_groups.
+
+	uint sampled_ticks = 0; ///< Number of ticks that were measured.
+	std::array<TickCosts, MAX_COMPANIES + 1> companies{}; ///< Costs per company, and for other work at #OTHER.
+	std::vector<TickCostVehicle> top_vehicles; ///< Most expensive vehicles, most expensive first.
+	std::vector<TickCostGroup> top_groups; ///< Most expensive groups, most expensive first.
+
+	/**
+	 * Get the average cost per tick of a company.
+	 * @param index Index in #companies.
+	 * @param type Type of work.
+	 * @return Average nanoseconds per tick.
+	 */
+	inline uint64_t GetAverage(size_t index, TickCostType type) const
+	{
+		return this->sampled_ticks == 0 ? 0 : this->companies[index].ns[to_underlying(type)] / this->sampled_ticks;
+	}
+};
+
+/** Sampled accounting of the game loop time per company. */
+class TickCostAccounting {
+public:
+	static constexpr uint SAMPLE_INTERVAL = 8; ///< Measure one in this many ticks.
+	static constexpr uint PERIOD = 256; ///< Number of ticks in a reporting period.
+
+	/**
+	 * Test whether the current tick is measured.
+	 * @return True iff costs are recorded this tick.
+	 */
+	static inline bool IsSampling() { return TickCostAccounting::sampling; }
+
+	static void OnTick();
+	static void Add(Owner owner, TickCostType type, uint64_t ns);
+	static void AddVehicle(VehicleID id, Owner owner, VehicleType type, uint64_t ns);
+	static const TickCostReport &GetReport();
+	static uint64_t Now();
+
+	static void SetThrottleBudget(uint64_t ns);
+	static uint64_t GetThrottleBudget();
+	static bool ShouldThrottleScript(CompanyID company);
+
+private:
+	static bool sampling; ///< Whether the current tick is measured.
+};
+
+/**
+ * RAII class for attributing the time of a scope to a company.
+ * Only measures during sampled ticks.
+ */
+class TickCostMeasurer {
+	Owner owner; ///< Company to attribute the time to.
+	TickCostType type; ///< Type of work.
+	uint64_t start; ///< Start of the scope, or 0 when not sampling.
+public:
+	/**
+	 * Start measuring a scope.
+	 * @param owner Company the work is done for.
+	 * @param type Type of work.
+	 */
+	inline TickCostMeasurer(Owner owner, TickCostType type) : owner(owner), type(type), start(TickCostAccounting::IsSampling() ? TickCostAccounting::Now() : 0) {}
+
+	inline ~TickCostMeasurer()
+	{
+		if (this->start != 0) TickCostAccounting::Add(this->owner, this->type, TickCostAccounting::Now() - this->start);
+	}
+
+	TickCostMeasurer(const TickCostMeasurer &) = delete;
+	TickCostMeasurer &operator=(const TickCostMeasurer &) = delete;
+};
+
+void ShowTickCostWindow();
+
+#endif /* TICK_COST_H */
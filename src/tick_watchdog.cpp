@@ -0,0 +1,311 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file tick_watchdog.cpp Watchdog that captures the details of game ticks that take longer than a budget. */
+
+#include "stdafx.h"
+#include "tick_watchdog.h"
+#include "command_func.h"
+#include "company_base.h"
+#include "debug.h"
+#include "fileio_func.h"
+#include "map_func.h"
+#include "scope_profiler.h"
+#include "thread.h"
+#include "ai/ai_instance.hpp"
+#include "game/game.hpp"
+#include "game/game_instance.hpp"
+#include "linkgraph/linkgraphjob.h"
+#include "pathfinder/yapf/yapf_stats.h"
+#include "timer/timer_game_economy.h"
+#include "timer/timer_game_tick.h"
+
+#include <chrono>
+#include "3rdparty/nlohmann/json.hpp"
+
+#include "safeguards.h"
+
+/* static */ uint64_t TickWatchdog::budget = 0;
+
+namespace {
+	/** A command executed since the previous tick. */
+	struct TickCommand {
+		Commands cmd; ///< The command.
+		CompanyID company; ///< Company that executed the command.
+		TileIndex tile; ///< Tile the command was executed on.
+	};
+
+	uint64_t _tick_start = 0; ///< Start of the current tick, in #ScopeProfiler::Now.
+	std::array<YapfStats, VEH_COMPANY_END> _tick_start_yapf_stats{}; ///< Pathfinder statistics at the start of the current tick.
+	std::array<uint64_t, MAX_COMPANIES + 1> _tick_start_script_ops{}; ///< Operations executed by the AIs, and the game script at #MAX_COMPANIES, at the start of the current tick.
+	std::vector<TickCommand> _tick_commands; ///< Commands executed since the previous tick.
+	size_t _tick_commands_omitted = 0; ///< Number of commands since the previous tick that did not fit in #_tick_commands.
+
+	TickWatchdogStats _stats; ///< Counters of the watchdog.
+	uint64_t _suppressed_since_capture = 0; ///< Number of slow ticks that were not captured since the last capture.
+	std::chrono::seconds _min_interval{60}; ///< Minimum real time between two captures.
+	std::optional<std::chrono::steady_clock::time_point> _last_capture_time; ///< Real time of the last capture, if any.
+	bool _started_profiler = false; ///< Whether the watchdog started the #ScopeProfiler.
+}
+
+/**
+ * Get the number of operations executed by all scripts.
+ * @return Operations per AI company, and of the game script at #MAX_COMPANIES.
+ */
+static std::array<uint64_t, MAX_COMPANIES + 1> GetScriptOps()
+{
+	std::array<uint64_t, MAX_COMPANIES + 1> ops{};
+	for (const Company *c : Company::Iterate()) {
+		if (c->ai_instance != nullptr) ops[c->index.base()] = c->ai_instance->GetExecutedOps();
+	}
+	if (Game::GetInstance() != nullptr) ops[MAX_COMPANIES] = Game::GetInstance()->GetExecutedOps();
+	return ops;
+}
+
+/**
+ * Convert a tree of scopes to JSON.
+ * @param node The scope.
+ * @return The JSON of the scope and its children.
+ */
+static nlohmann::json ProfileNodeToJson(const ProfileNode &node)
+{
+	nlohmann::json json;
+	json["name"] = node.event.name;
+	if (node.event.object != ProfileEvent::NO_OBJECT) json["object"] = node.event.object;
+	json["thread"] = node.event.thread;
+	json["start_us"] = node.event.start < _tick_start ? 0 : (node.event.start - _tick_start) / 1000;
+	json["duration_us"] = node.event.duration / 1000;
+	if (!node.children.empty()) {
+		json["children"] = nlohmann::json::array();
+		for (const ProfileNode &child : node.children) json["children"].push_back(ProfileNodeToJson(child));
+	}
+	return json;
+}
+
+/**
+ * Collect everything that is known about the tick that just ended.
+ * @param duration Duration of the tick, in nanoseconds.
+ * @return The capture.
+ */
+static nlohmann::json CaptureTick(uint64_t duration)
+{
+	nlohmann::json capture;
+	TimerGameEconomy::YearMonthDay ymd = TimerGameEconomy::ConvertDateToYMD(TimerGameEconomy::date);
+	capture["tick"] = TimerGameTick::counter;
+	capture["date"] = fmt::format("{:04d}-{:02d}-{:02d}", ymd.year, ymd.month + 1, ymd.day);
+	capture["date_fract"] = TimerGameEconomy::date_fract;
+	capture["duration_us"] = duration / 1000;
+	capture["budget_us"] = TickWatchdog::GetBudget() / 1000;
+	capture["suppressed_since_last_capture"] = _suppressed_since_capture;
+
+	/* Leave out the scopes that are too short to matter; their parents still account for their time. */
+	uint64_t min_duration = TickWatchdog::GetBudget() / 1000;
+	std::vector<ProfileEvent> events = ScopeProfiler::GetEvents(_tick_start);
+	size_t total_events = events.size();
+	std::erase_if(events, [min_duration](const ProfileEvent &e) { return e.start < _tick_start || e.duration < min_duration; });
+	capture["scopes_omitted"] = total_events - events.size();
+	capture["scopes"] = nlohmann::json::array();
+	for (const ProfileNode &node : ScopeProfiler::BuildTree(std::move(events))) capture["scopes"].push_back(ProfileNodeToJson(node));
+
+	capture["link_graph_jobs"] = nlohmann::json::array();
+	for (const LinkGraphJob *job : LinkGraphJob::Iterate()) {
+		capture["link_graph_jobs"].push_back({
+			{"job", job->index.base()},
+			{"link_graph", job->LinkGraphIndex().base()},
+			{"cargo", job->Cargo()},
+			{"nodes", job->Size()},
+			{"join_date", job->JoinDate().base()},
+			{"completed", job->IsJobCompleted()},
+			{"bytes", job->GetMemoryUsage()},
+		});
+	}
+
+	std::array<uint64_t, MAX_COMPANIES + 1> script_ops = GetScriptOps();
+	capture["scripts"] = nlohmann::json::array();
+	for (size_t i = 0; i < script_ops.size(); i++) {
+		/* The counter restarts when a script is restarted. */
+		uint64_t ops = script_ops[i] - std::min(script_ops[i], _tick_start_script_ops[i]);
+		if (ops == 0) continue;
+		capture["scripts"].push_back({{"company", i == MAX_COMPANIES ? nlohmann::json("game script") : nlohmann::json(i)}, {"ops", ops}});
+	}
+
+	static const std::array<std::string_view, VEH_COMPANY_END> type_names = {"trains", "road vehicles", "ships", "aircraft"};
+	capture["pathfinder"] = nlohmann::json::array();
+	for (VehicleType type : {VEH_TRAIN, VEH_ROAD, VEH_SHIP}) {
+		const YapfStats &now = GetYapfStats(type);
+		const YapfStats &start = _tick_start_yapf_stats[type];
+		/* The statistics may have been reset during the tick. */
+		if (now.searches <= start.searches) continue;
+		capture["pathfinder"].push_back({
+			{"type", type_names[type]},
+			{"searches", now.searches - start.searches},
+			{"nodes", now.nodes - start.nodes},
+			{"max_nodes_hit", now.max_nodes_hit - start.max_nodes_hit},
+			{"duration_us", (now.ns - start.ns) / 1000},
+		});
+	}
+	capture["slow_searches"] = nlohmann::json::array();
+	for (const YapfSlowSearch &s : GetYapfSlowSearches()) {
+		if (s.tick != TimerGameTick::counter) continue;
+		capture["slow_searches"].push_back({
+			{"vehicle", s.vehicle.base()},
+			{"type", type_names[s.type]},
+			{"origin", {TileX(s.origin), TileY(s.origin)}},
+			{"destination", {TileX(s.destination), TileY(s.destination)}},
+			{"nodes", s.nodes},
+			{"max_nodes_hit", s.max_nodes_hit},
+			{"duration_us", s.ns / 1000},
+		});
+	}
+
+	capture["commands"] = nlohmann::json::array();
+	for (const TickCommand &c : _tick_commands) {
+		capture["commands"].push_back({
+			{"command", GetCommandName(c.cmd)},
+			{"company", c.company.base()},
+			{"tile", {TileX(c.tile), TileY(c.tile)}},
+		});
+	}
+	capture["commands_omitted"] = _tick_commands_omitted;
+
+	return capture;
+}
+
+/**
+ * Write a capture to a file in the autosave directory.
+ * @param capture The capture.
+ * @param filename Name of the file.
+ * @param tick The tick that was captured.
+ * @param duration Duration of the tick, in nanoseconds.
+ */
+static void WriteCapture(const nlohmann::json &capture, const std::string &filename, uint64_t tick, uint64_t duration)
+{
+	std::optional<FileHandle> f = FioFOpenFile(filename, "wt", AUTOSAVE_DIR);
+	if (!f.has_value()) {
+		Debug(misc, 0, "Tick {} took {} us; failed to write '{}'", tick, duration / 1000, filename);
+		return;
+	}
+
+	fmt::print(*f, "{}\n", capture.dump(1, '\t'));
+	Debug(misc, 1, "Tick {} took {} us; wrote '{}'", tick, duration / 1000, filename);
+}
+
+/**
+ * Start watching a game tick.
+ */
+/* static */ void TickWatchdog::BeginTick()
+{
+	_tick_start = ScopeProfiler::Now();
+	for (VehicleType type : {VEH_TRAIN, VEH_ROAD, VEH_SHIP}) _tick_start_yapf_stats[type] = GetYapfStats(type);
+	_tick_start_script_ops = GetScriptOps();
+}
+
+/**
+ * Finish watching a game tick; writes a capture when it took longer than the budget.
+ */
+/* static */ void TickWatchdog::EndTick()
+{
+	uint64_t duration = ScopeProfiler::Now() - _tick_start;
+	if (duration > TickWatchdog::budget) {
+		_stats.slow_ticks++;
+
+		auto now = std::chrono::steady_clock::now();
+		if (_last_capture_time.has_value() && now - *_last_capture_time < _min_interval) {
+			_stats.suppressed++;
+			_suppressed_since_capture++;
+		} else {
+			std::string filename = fmt::format("slowtick_{}.json", _stats.captures % MAX_CAPTURE_FILES);
+			_stats.captures++;
+			_stats.last_capture = filename;
+
+			/* Only collecting the capture needs the game; writing it would make the next tick late, so leave that to another thread. */
+			auto capture = std::make_shared<nlohmann::json>(CaptureTick(duration));
+			uint64_t tick = TimerGameTick::counter;
+			if (!StartNewThread(nullptr, "ottd:watchdog", [capture, filename, tick, duration]() { WriteCapture(*capture, filename, tick, duration); })) {
+				WriteCapture(*capture, filename, tick, duration);
+			}
+
+			_last_capture_time = now;
+			_suppressed_since_capture = 0;
+		}
+	}
+
+	_tick_commands.clear();
+	_tick_commands_omitted = 0;
+}
+
+/**
+ * Remember a command that was executed, for the capture of the next tick.
+ * @param cmd The command.
+ * @param company Company that executed the command.
+ * @param tile Tile the command was executed on.
+ */
+/* static */ void TickWatchdog::RecordCommand(Commands cmd, CompanyID company, TileIndex tile)
+{
+	if (_tick_commands.size() < MAX_COMMANDS) {
+		_tick_commands.emplace_back(cmd, company, tile);
+	} else {
+		_tick_commands_omitted++;
+	}
+}
+
+/**
+ * Set the duration of a tick above which it is captured.
+ * Enabling the watchdog starts the scope profiler; disabling it stops the profiler again, unless it was already running.
+ * @param ns Nanoseconds, or 0 to disable the watchdog.
+ */
+/* static */ void TickWatchdog::SetBudget(uint64_t ns)
+{
+	if (ns != 0 && !ScopeProfiler::IsRunning()) {
+		ScopeProfiler::Start();
+		_started_profiler = true;
+	}
+	if (ns == 0 && _started_profiler) {
+		ScopeProfiler::Stop();
+		_started_profiler = false;
+	}
+
+	TickWatchdog::budget = ns;
+	_tick_commands.clear();
+	_tick_commands_omitted = 0;
+}
+
+/**
+ * Get the duration of a tick above which it is captured.
+ * @return Nanoseconds, or 0 when the watchdog is disabled.
+ */
+/* static */ uint64_t TickWatchdog::GetBudget()
+{
+	return TickWatchdog::budget;
+}
+
+/**
+ * Set the minimum real time between two captures.
+ * @param interval The interval.
+ */
+/* static */ void TickWatchdog::SetMinInterval(std::chrono::seconds interval)
+{
+	_min_interval = interval;
+}
+
+/**
+ * Get the minimum real time between two captures.
+ * @return The interval.
+ */
+/* static */ std::chrono::seconds TickWatchdog::GetMinInterval()
+{
+	return _min_interval;
+}
+
+/**
+ * Get the counters of the watchdog.
+ * @return The counters since the game started.
+ */
+/* static */ TickWatchdogStats TickWatchdog::GetStats()
+{
+	return _stats;
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file tick_watchdog.h Watchdog that captures the details of game ticks that take longer than a budget.
+ *
+ * While the watchdog is enabled, the #ScopeProfiler runs, so its ring buffers hold the timings of the
+ * last ticks. When a tick takes longer than the budget, the scopes of that tick are written to a JSON
+ * file in the autosave directory, together with the running link graph jobs, the operations executed
+ * by the scripts, the pathfinder searches and the commands executed since the previous tick. The file
+ * is written on a thread of its own, so the next tick is not delayed by it. At most
+ * one capture is written per #TickWatchdog::GetMinInterval, and the files are reused after
+ * #TickWatchdog::MAX_CAPTURE_FILES captures.
+ *
+ * @see tick_watchdog.cpp for implementation
+ */
+
+#ifndef TICK_WATCHDOG_H
+#define TICK_WATCHDOG_H
+
+#include "command_type.h"
+#include "company_type.h"
+#include "tile_type.h"
+
+#include <chrono>
+
+/** Counters of the tick watchdog. */
+struct TickWatchdogStats {
+	uint64_t slow_ticks = 0; ///< Number of ticks that took longer than the budget.
+	uint64_t captures = 0; ///< Number of captures that were taken.
+	uint64_t suppressed = 0; ///< Number of slow ticks that were not captured because of the rate limit.
+	std::string last_capture; ///< Name of the last written capture file, if any.
+};
+
+/** Watchdog for game ticks that take longer than a budget. */
+class TickWatchdog {
+public:
+	static constexpr size_t MAX_COMMANDS = 256; ///< Number of commands per tick that are kept for a capture.
+	static constexpr uint MAX_CAPTURE_FILES = 16; ///< Number of capture files before the oldest is overwritten.
+
+	/**
+	 * Test whether the watchdog is enabled.
+	 * @return True iff ticks are checked against the budget.
+	 */
+	static inline bool IsEnabled() { return TickWatchdog::budget != 0; }
+
+	static void BeginTick();
+	static void EndTick();
+	static void RecordCommand(Commands cmd, CompanyID company, TileIndex tile);
+
+	static void SetBudget(uint64_t ns);
+	static uint64_t GetBudget();
+	static void SetMinInterval(std::chrono::seconds interval);
+	static std::chrono::seconds GetMinInterval();
+	static TickWatchdogStats GetStats();
+
+private:
+	static uint64_t budget; ///< Duration of a tick above which it is captured, in nanoseconds, or 0 when disabled.
+};
+
+/**
+ * RAII class for checking the duration of a game tick against the budget of the #TickWatchdog.
+ * Construct it before anything else that is measured in the tick, so the capture includes all of it,
+ * and taking the capture is not measured as part of the tick.
+ */
+class TickWatchdogScope {
+	bool active; ///< Whether the watchdog was enabled when the tick started.
+public:
+	inline TickWatchdogScope() : active(TickWatchdog::IsEnabled())
+	{
+		if (this->active) TickWatchdog::BeginTick();
+	}
+
+	inline ~TickWatchdogScope()
+	{
+		if (this->active) TickWatchdog::EndTick();
+	}
+
+	TickWatchdogScope(const TickWatchdogScope &) = delete;
+	TickWatchdogScope &operator=(const TickWatchdogScope &) = delete;
+};
+
+#endif /* TICK_WATCHDOG_H */
@@ -57,6 +57,8 @@
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_economy.h"
 #include "timer/timer_game_tick.h"
+#include "allocation_tracker.h"
+#include "scope_profiler.h"
 
 #include "table/strings.h"
 #include "table/town_land.h"
@@ -935,6 +937,8 @@ void OnTick_Town()
 	if (_game_mode == GM_EDITOR) return;
 
 	for (Town *t : Town::Iterate()) {
+		ProfileScope profile("Town", t->index.base());
+		AllocationScope allocations(AllocationTag::Towns);
 		TownTickHandler(t);
 	}
 }
@@ -34,6 +34,7 @@
 #include "zoom_func.h"
 #include "newgrf_debug.h"
 #include "framerate_type.h"
+#include "scope_profiler.h"
 #include "train_cmd.h"
 #include "misc_cmd.h"
 #include "timer/timer_game_calendar.h"
@@ -3269,13 +3270,13 @@ static bool CheckTrainCollision(Train *v)
 }
 
 /**
- * Move a vehicle chain one movement stop forwards.
+ * Move a vehicle chain one movement stop forwards, handling everything that can happen on the way.
  * @param v First vehicle to move.
  * @param nomove Stop moving this and all following vehicles.
  * @param reverse Set to false to not execute the vehicle reversing. This does not change any other logic.
  * @return True if the vehicle could be moved forward, false otherwise.
  */
-bool TrainController(Train *v, Vehicle *nomove, bool reverse)
+static bool TrainControllerFull(Train *v, Vehicle *nomove, bool reverse)
 {
 	Train *first = v->First();
 	Train *prev;
@@ -3600,6 +3601,189 @@ reverse_train_direction:
 	return false;
 }
 
+/**
+ * Check whether all parts of a train are on the open line, i.e. on plain rail and not
+ * entering another tile with their next movement step. Such a step can't run into
+ * signals, stations, depots, tunnels, bridges or level crossings.
+ * @param v The front engine of the train.
+ * @param[out] positions The positions of the parts after the step, in order, when the train is on the open line.
+ * @return True iff the train is on the open line.
+ */
+static bool IsTrainOnOpenLine(const Train *v, std::vector<GetNewVehiclePosResult> &positions)
+{
+	positions.clear();
+	for (const Train *u = v; u != nullptr; u = u->Next()) {
+		if (!IsPlainRailTile(u->tile)) return false;
+
+		const GetNewVehiclePosResult &gp = positions.emplace_back(GetNewVehiclePos(u));
+		if (gp.new_tile != gp.old_tile) return false;
+	}
+	return true;
+}
+
+/**
+ * Move the parts of a train on the open line to their positions after one movement step.
+ * @param v The front engine of the train.
+ * @param positions The positions of the parts after the step, see #IsTrainOnOpenLine.
+ * @param check_next_tile Whether to extend the path reservation every now and then, like #TrainControllerFull does.
+ */
+static void MoveTrainOnOpenLine(Train *v, std::span<const GetNewVehiclePosResult> positions, bool check_next_tile)
+{
+	auto gp = positions.begin();
+	for (Train *u = v; u != nullptr; u = u->Next(), ++gp) {
+		assert(u->track & TRACK_BIT_MASK);
+		assert(gp != positions.end());
+
+		u->UpdateDeltaXY();
+		u->x_pos = gp->x;
+		u->y_pos = gp->y;
+		u->UpdatePosition();
+
+		int old_z = u->UpdateInclination(false, false);
+		if (u == v) AffectSpeedByZChange(u, old_z);
+
+		/* Do not check on every tick to save some computing time. */
+		if (check_next_tile && u->IsFrontEngine() && u->tick_counter % _settings_game.pf.path_backoff_interval == 0) CheckNextTrainTile(u);
+	}
+}
+
+/**
+ * Move a train on the open line one movement step forwards.
+ * This only has to update the positions of its parts, see #IsTrainOnOpenLine.
+ * @param v The front engine of the train.
+ * @param positions The positions of the parts after the step, see #IsTrainOnOpenLine.
+ * @param reverse Set to false to not execute the vehicle reversing.
+ * @return True if the vehicle could be moved forward, false otherwise.
+ */
+static bool TrainControllerOpenLine(Train *v, std::span<const GetNewVehiclePosResult> positions, bool reverse)
+{
+	/* Reverse when we are at the end of the track already, do not move to the new position */
+	if (!TrainCheckIfLineEnds(v, reverse)) return false;
+
+	MoveTrainOnOpenLine(v, positions, true);
+	return true;
+}
+
+/** The state of a part of a train that a movement step on the open line can change. */
+struct OpenLineState {
+	int32_t x_pos; ///< x coordinate.
+	int32_t y_pos; ///< y coordinate.
+	int32_t z_pos; ///< z coordinate.
+	TileIndex tile; ///< The tile the part is on.
+	TrackBits track; ///< The track the part is on.
+	Direction direction; ///< The direction the part faces.
+	uint16_t gv_flags; ///< Whether the part goes up or down a slope.
+	uint16_t cur_speed; ///< Current speed.
+	uint8_t subspeed; ///< Fractional speed.
+	uint8_t progress; ///< Progress within the tile unit.
+	VehStates vehstatus; ///< Status, e.g. slowing down because of a breakdown.
+	uint8_t x_extent; ///< x-extent of the bounding box.
+	uint8_t y_extent; ///< y-extent of the bounding box.
+	uint8_t z_extent; ///< z-extent of the bounding box.
+	int8_t x_bb_offs; ///< x offset of the bounding box.
+	int8_t y_bb_offs; ///< y offset of the bounding box.
+	int8_t x_offs; ///< x offset of the sprite.
+	int8_t y_offs; ///< y offset of the sprite.
+
+	/**
+	 * Take the state of a part of a train.
+	 * @param u The part.
+	 */
+	OpenLineState(const Train *u) :
+		x_pos(u->x_pos), y_pos(u->y_pos), z_pos(u->z_pos), tile(u->tile), track(u->track), direction(u->direction),
+		gv_flags(u->gv_flags), cur_speed(u->cur_speed), subspeed(u->subspeed), progress(u->progress), vehstatus(u->vehstatus),
+		x_extent(u->x_extent), y_extent(u->y_extent), z_extent(u->z_extent), x_bb_offs(u->x_bb_offs), y_bb_offs(u->y_bb_offs),
+		x_offs(u->x_offs), y_offs(u->y_offs) {}
+
+	/**
+	 * Put a part of a train back into this state.
+	 * @param u The part.
+	 */
+	void Restore(Train *u) const
+	{
+		u->x_pos = this->x_pos;
+		u->y_pos = this->y_pos;
+		u->z_pos = this->z_pos;
+		u->tile = this->tile;
+		u->track = this->track;
+		u->direction = this->direction;
+		u->gv_flags = this->gv_flags;
+		u->cur_speed = this->cur_speed;
+		u->subspeed = this->subspeed;
+		u->progress = this->progress;
+		u->vehstatus = this->vehstatus;
+		u->x_extent = this->x_extent;
+		u->y_extent = this->y_extent;
+		u->z_extent = this->z_extent;
+		u->x_bb_offs = this->x_bb_offs;
+		u->y_bb_offs = this->y_bb_offs;
+		u->x_offs = this->x_offs;
+		u->y_offs = this->y_offs;
+		u->UpdatePositionAndViewport();
+	}
+
+	bool operator==(const OpenLineState &other) const = default;
+};
+
+/**
+ * Move a train on the open line one movement step forwards with the full controller, and check that
+ * the shortcut of #TrainControllerOpenLine gets the train into the same state.
+ * The shortcut is done first; then the train is put back and the full controller does the step for real.
+ * The shortcut leaves out the path reservation, as that is the same call in both controllers.
+ * @param v The front engine of the train.
+ * @param positions The positions of the parts after the step, see #IsTrainOnOpenLine.
+ * @param reverse Set to false to not execute the vehicle reversing.
+ * @return True if the vehicle could be moved forward, false otherwise.
+ */
+static bool TrainControllerOpenLineChecked(Train *v, std::span<const GetNewVehiclePosResult> positions, bool reverse)
+{
+	std::vector<OpenLineState> before;
+	for (const Train *u = v; u != nullptr; u = u->Next()) before.emplace_back(u);
+
+	/* Both controllers check the end of the line alike before moving anything, so when it ends neither moves.
+	 * Otherwise the changes of the check are undone below, and the full controller does them again. */
+	if (!TrainCheckIfLineEnds(v, reverse)) return false;
+	MoveTrainOnOpenLine(v, positions, false);
+
+	std::vector<OpenLineState> shortcut;
+	for (const Train *u = v; u != nullptr; u = u->Next()) shortcut.emplace_back(u);
+
+	size_t i = 0;
+	for (Train *u = v; u != nullptr; u = u->Next(), i++) before[i].Restore(u);
+
+	if (!TrainControllerFull(v, nullptr, reverse)) {
+		Debug(desync, 2, "warning: train open line mismatch: vehicle {}, company {}, unit number {}, full controller did not move", v->index, v->owner, v->unitnumber);
+		return false;
+	}
+
+	i = 0;
+	for (const Train *u = v; u != nullptr; u = u->Next(), i++) {
+		if (OpenLineState(u) != shortcut[i]) {
+			Debug(desync, 2, "warning: train open line mismatch: vehicle {}, company {}, unit number {}, wagon {}", v->index, v->owner, v->unitnumber, i);
+		}
+	}
+	return true;
+}
+
+/**
+ * Move a vehicle chain one movement stop forwards.
+ * Trains on the open line take a shortcut, unless desync debugging is enabled;
+ * then the shortcut is checked against the full controller instead.
+ * @param v First vehicle to move.
+ * @param nomove Stop moving this and all following vehicles.
+ * @param reverse Set to false to not execute the vehicle reversing. This does not change any other logic.
+ * @return True if the vehicle could be moved forward, false otherwise.
+ */
+bool TrainController(Train *v, Vehicle *nomove, bool reverse)
+{
+	/* Reused for every train; when reversing at the end of the line moves the train again, this is not used anymore. */
+	static std::vector<GetNewVehiclePosResult> positions;
+	if (nomove != nullptr || !v->IsFrontEngine() || !IsTrainOnOpenLine(v, positions)) return TrainControllerFull(v, nomove, reverse);
+
+	if (_debug_desync_level <= 1) return TrainControllerOpenLine(v, positions, reverse);
+	return TrainControllerOpenLineChecked(v, positions, reverse);
+}
+
 static bool IsRailStationPlatformOccupied(TileIndex tile)
 {
 	TileIndexDiff delta = TileOffsByAxis(GetRailStationAxis(tile));
@@ -4107,6 +4291,7 @@ bool Train::Tick()
 
 	if (this->IsFrontEngine()) {
 		PerformanceAccumulator framerate(PFE_GL_TRAINS);
+		ProfileScope profile("Train", this->index.base());
 
 		if (!this->vehstatus.Test(VehState::Stopped) || this->cur_speed > 0) this->running_ticks++;
 
@@ -51,6 +51,9 @@
 #include "linkgraph/linkgraph.h"
 #include "linkgraph/refresh.h"
 #include "framerate_type.h"
+#include "allocation_tracker.h"
+#include "scope_profiler.h"
+#include "tick_cost.h"
 #include "autoreplace_cmd.h"
 #include "misc_cmd.h"
 #include "train_cmd.h"
@@ -822,8 +825,8 @@ void Vehicle::PreDestructor()
 		Aircraft *a = Aircraft::From(this);
 		Station *st = GetTargetAirportIfValid(a);
 		if (st != nullptr) {
-			const auto &layout = st->airport.GetFTA()->layout;
-			st->airport.blocks.Reset(layout[a->previous_pos].blocks | layout[a->pos].blocks);
+			const AirportFTAClass *apc = st->airport.GetFTA();
+			st->airport.blocks.Reset(apc->Position(a->previous_pos).blocks | apc->Position(a->pos).blocks);
 		}
 	}
 
@@ -953,13 +956,21 @@ static void RunEconomyVehicleDayProc()
 
 void CallVehicleTicks()
 {
+	ProfileScope profile("CallVehicleTicks");
+	AllocationScope allocations(AllocationTag::Vehicles);
+
 	_vehicles_to_autoreplace.clear();
 
 	RunEconomyVehicleDayProc();
 
 	{
 		PerformanceMeasurer framerate(PFE_GL_ECONOMY);
-		for (Station *st : Station::Iterate()) LoadUnloadStation(st);
+		ProfileScope profile_economy("LoadUnloadStation");
+		AllocationScope allocations_cargo(AllocationTag::Cargo);
+		for (Station *st : Station::Iterate()) {
+			TickCostMeasurer tick_cost(st->owner, TickCostType::Loading);
+			LoadUnloadStation(st);
+		}
 	}
 	PerformanceAccumulator::Reset(PFE_GL_TRAINS);
 	PerformanceAccumulator::Reset(PFE_GL_ROADVEHS);
@@ -969,8 +980,15 @@ void CallVehicleTicks()
 	for (Vehicle *v : Vehicle::Iterate()) {
 		[[maybe_unused]] VehicleID vehicle_index = v->index;
 
+		/* Attribute the time of primary vehicles to their company, when this tick is sampled. */
+		uint64_t tick_cost_start = (TickCostAccounting::IsSampling() && v->IsPrimaryVehicle()) ? TickCostAccounting::Now() : 0;
+		Owner owner = v->owner;
+		VehicleType type = v->type;
+
 		/* Vehicle could be deleted in this tick */
-		if (!v->Tick()) {
+		bool alive = v->Tick();
+		if (tick_cost_start != 0) TickCostAccounting::AddVehicle(vehicle_index, owner, type, TickCostAccounting::Now() - tick_cost_start);
+		if (!alive) {
 			assert(Vehicle::Get(vehicle_index) == nullptr);
 			continue;
 		}
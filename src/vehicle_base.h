@@ -181,6 +181,19 @@ struct MutableSpriteCache {
 	VehicleSpriteSeq sprite_seq{}; ///< Vehicle appearance.
 };
 
+/**
+ * Cache for the next stopping station of a vehicle.
+ * The next stop only depends on the orders and on the position of the vehicle within them,
+ * so the cached value is valid as long as those are unchanged. Only single stations are
+ * cached, so vehicles don't keep hold of items of the shared #StationIDStack pool.
+ */
+struct NextStopCache {
+	uint64_t orders_version = 0; ///< Version of the order list the next stop was determined for, 0 if nothing is cached.
+	VehicleOrderID cur_implicit_order_index = INVALID_VEH_ORDER_ID; ///< Implicit order index the next stop was determined for.
+	StationID last_station_visited = StationID::Invalid(); ///< Last visited station the next stop was determined for.
+	StationID next_station = StationID::Invalid(); ///< The cached next stopping station.
+};
+
 /** A vehicle pool for a little over 1 million vehicles. */
 typedef Pool<Vehicle, VehicleID, 512> VehiclePool;
 extern VehiclePool _vehicle_pool;
@@ -346,6 +359,7 @@ public:
 	GroupID group_id = GroupID::Invalid(); ///< Index of group Pool array
 
 	mutable MutableSpriteCache sprite_cache{}; ///< Cache of sprites and values related to recalculating them, see #MutableSpriteCache
+	mutable NextStopCache next_stop_cache{}; ///< NOSAVE: Cache of the next stopping station, see #NextStopCache
 
 	/**
 	 * Calculates the weight value that this vehicle will have when fully loaded with its current cargo.
@@ -741,7 +755,22 @@ public:
 	 */
 	inline StationIDStack GetNextStoppingStation() const
 	{
-		return (this->orders == nullptr) ? StationID::Invalid().base() : this->orders->GetNextStoppingStation(this);
+		if (this->orders == nullptr) return StationID::Invalid().base();
+
+		NextStopCache &cache = this->next_stop_cache;
+		if (cache.orders_version == this->orders->GetVersion() && cache.cur_implicit_order_index == this->cur_implicit_order_index &&
+				cache.last_station_visited == this->last_station_visited) {
+			return cache.next_station.base();
+		}
+
+		StationIDStack next = this->orders->GetNextStoppingStation(this);
+		if (next.IsSingle()) {
+			cache.orders_version = this->orders->GetVersion();
+			cache.cur_implicit_order_index = this->cur_implicit_order_index;
+			cache.last_station_visited = this->last_station_visited;
+			cache.next_station = StationID(StationIDStack(next).Pop());
+		}
+		return next;
 	}
 
 	void ResetRefitCaps();
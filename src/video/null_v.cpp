@@ -12,10 +12,15 @@
 #include "../blitter/factory.hpp"
 #include "../saveload/saveload.h"
 #include "../window_func.h"
+#include "../fileio_func.h"
 #include "null_v.h"
 
+#include "../3rdparty/nlohmann/json.hpp"
+
 #include "../safeguards.h"
 
+extern void SurveyFramerate(nlohmann::json &json); // framerate_gui.cpp
+
 /** Factory for the null video driver. */
 static FVideoDriver_Null iFVideoDriver_Null;
 
@@ -31,6 +36,7 @@ std::optional<std::string_view> VideoDriver_Null::Start(const StringList &parm)
 	this->UpdateAutoResolution();
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
+	this->report = GetDriverParam(parm, "report").value_or("");
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -46,16 +52,49 @@ void VideoDriver_Null::Stop() { }
 
 void VideoDriver_Null::MakeDirty(int, int, int, int) {}
 
+/**
+ * Write a JSON report of the performance of running the game, for automated benchmarks.
+ * @param filename The file to write to.
+ * @param ticks Number of ticks that were run.
+ * @param elapsed Time it took to run the ticks.
+ */
+static void WriteNullDriverReport(const std::string &filename, uint ticks, std::chrono::steady_clock::duration elapsed)
+{
+	double seconds = std::chrono::duration<double>(elapsed).count();
+
+	nlohmann::json json;
+	json["ticks"] = ticks;
+	json["seconds"] = seconds;
+	json["ticks_per_second"] = seconds > 0 ? ticks / seconds : 0.0;
+	SurveyFramerate(json["framerate"]);
+
+	ProcessMemoryUsage memory = GetProcessMemoryUsage();
+	json["memory"] = {
+		{"resident", memory.resident},
+		{"peak_resident", memory.peak_resident},
+	};
+
+	auto f = FioFOpenFile(filename, "wt", Subdirectory::NO_DIRECTORY);
+	if (!f.has_value()) {
+		Debug(driver, 0, "Failed to open '{}' for writing the performance report", filename);
+		return;
+	}
+	fmt::print(*f, "{}\n", json.dump(4));
+}
+
 void VideoDriver_Null::MainLoop()
 {
 	uint i;
 
+	auto start = std::chrono::steady_clock::now();
 	for (i = 0; i < this->ticks; i++) {
 		::GameLoop();
 		::InputLoop();
 		::UpdateWindows();
 	}
 
+	if (!this->report.empty()) WriteNullDriverReport(this->report, this->ticks, std::chrono::steady_clock::now() - start);
+
 	/* If requested, make a save just before exit. The normal exit-flow is
 	 * not triggered from this driver, so we have to do this manually. */
 	if (_settings_client.gui.autosave_on_exit) {
@@ -16,6 +16,7 @@
 class VideoDriver_Null : public VideoDriver {
 private:
 	uint ticks = 0; ///< Amount of ticks to run.
+	std::string report; ///< File to write a JSON performance report to after running, if any.
 
 public:
 	std::optional<std::string_view> Start(const StringList &param) override;
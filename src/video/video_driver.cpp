@@ -12,6 +12,7 @@
 #include "../network/network.h"
 #include "../blitter/factory.hpp"
 #include "../debug.h"
+#include "../debug_log.h"
 #include "../driver.h"
 #include "../fontcache.h"
 #include "../gfx_func.h"
@@ -44,6 +45,8 @@ void VideoDriver::GameLoop()
 
 void VideoDriver::GameThread()
 {
+	SetDebugGameThread();
+
 	while (!_exit_game) {
 		this->GameLoop();
 
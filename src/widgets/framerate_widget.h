@@ -22,6 +22,8 @@ enum FramerateWindowWidgets : WidgetID {
 	WID_FRW_TIMES_AVERAGE,
 	WID_FRW_ALLOCSIZE,
 	WID_FRW_SCROLLBAR,
+	WID_FRW_TICK_COSTS,
+	WID_FRW_MEMORY,
 };
 
 /** Widgets of the #FrametimeGraphWindow class. */
@@ -30,4 +32,19 @@ enum FrametimeGraphWindowWidgets : WidgetID {
 	WID_FGW_GRAPH,
 };
 
+/** Widgets of the #TickCostWindow class. */
+enum TickCostWindowWidgets : WidgetID {
+	WID_TCW_COMPANIES, ///< Table of the costs per company.
+	WID_TCW_VEHICLES, ///< List of the most expensive vehicles.
+	WID_TCW_GROUPS, ///< List of the most expensive groups.
+	WID_TCW_INFO, ///< Explanation of the measurements.
+};
+
+/** Widgets of the #MemoryWindow class. */
+enum MemoryWindowWidgets : WidgetID {
+	WID_MW_POOLS, ///< Table of the pools.
+	WID_MW_SCROLLBAR, ///< Scrollbar of the pools.
+	WID_MW_SUMMARY, ///< Memory use outside the pools.
+};
+
 #endif /* WIDGETS_FRAMERATE_WIDGET_H */
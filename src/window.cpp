@@ -34,6 +34,8 @@
 #include "game/game.hpp"
 #include "video/video_driver.hpp"
 #include "framerate_type.h"
+#include "allocation_tracker.h"
+#include "scope_profiler.h"
 #include "network/network_func.h"
 #include "news_func.h"
 #include "timer/timer.h"
@@ -3104,6 +3106,8 @@ void UpdateWindows()
 
 	PerformanceMeasurer framerate(PFE_DRAWING);
 	PerformanceAccumulator::Reset(PFE_DRAWWORLD);
+	ProfileScope profile("UpdateWindows");
+	AllocationScope allocations(AllocationTag::Windows);
 
 	ProcessPendingPerformanceMeasurements();
 
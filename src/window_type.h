@@ -711,6 +711,18 @@ enum WindowClass : uint16_t {
 	 */
 	WC_FRAMETIME_GRAPH,
 
+	/**
+	 * Game loop costs per company; %Window numbers:
+	 *   - 0 = #TickCostWindowWidgets
+	 */
+	WC_TICK_COSTS,
+
+	/**
+	 * Memory use window; %Window numbers:
+	 *   - 0 = #MemoryWindowWidgets
+	 */
+	WC_MEMORY,
+
 	/**
 	 * Screenshot window; %Window numbers:
 	 *   - 0 = #ScreenshotWidgets